@@ -10,7 +10,11 @@
 #ifndef BIT7ZLIBRARY_HPP
 #define BIT7ZLIBRARY_HPP
 
+#include <cstddef>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "bitformat.hpp"
 #include "bittypes.hpp"
@@ -82,16 +86,47 @@ class Bit7zLibrary final {
          */
         void setLargePageMode();
 
+        /**
+         * @return the maximum number of idle archive handler objects kept by the library for each format.
+         */
+        BIT7Z_NODISCARD auto handlerPoolSize() const noexcept -> std::size_t;
+
+        /**
+         * @brief Sets the maximum number of idle archive handler objects kept by the library for each format.
+         *
+         * Archive handlers of archives that were closed are kept for reuse, instead of being destroyed,
+         * so that opening or creating many (small) archives of the same format doesn't need to create a new
+         * handler object every time.
+         *
+         * Handlers on which a format property was used, or that were used for updating an archive, are not reused.
+         *
+         * @note By default, the pool is disabled (i.e., its size is 0).
+         *
+         * @param poolSize  the maximum number of idle handlers kept for each format (0 to disable the pool).
+         */
+        void setHandlerPoolSize( std::size_t poolSize );
+
     private:
         HMODULE mLibrary;
         FARPROC mCreateObjectFunc;
 
+        mutable std::mutex mHandlerPoolMutex;
+        std::size_t mHandlerPoolSize;
+        mutable std::map< unsigned char, std::vector< IInArchive* > > mInArchivePool;
+        mutable std::map< unsigned char, std::vector< IOutArchive* > > mOutArchivePool;
+
         BIT7Z_NODISCARD
         auto initInArchive( const BitInFormat& format ) const -> CMyComPtr< IInArchive >;
 
         BIT7Z_NODISCARD
         auto initOutArchive( const BitInOutFormat& format ) const -> CMyComPtr< IOutArchive >;
 
+        void recycleInArchive( const BitInFormat& format, IInArchive* inArchive ) const noexcept;
+
+        void recycleOutArchive( const BitInOutFormat& format, IOutArchive* outArchive ) const noexcept;
+
+        void clearHandlerPool() noexcept;
+
         friend class BitInputArchive;
         friend class BitOutputArchive;
 };
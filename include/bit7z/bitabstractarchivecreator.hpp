@@ -35,9 +35,16 @@ enum struct UpdateMode {
     None, ///< The creator will throw an exception (unless the OverwriteMode is not None).
     Append, ///< The creator will append the new items to the existing archive.
     Update, ///< New items whose path already exists in the archive will overwrite the old ones, other will be appended.
+    Freshen, ///< Same as Update, but old items that are unchanged (same size and last write time) are kept as they are.
     BIT7Z_DEPRECATED_ENUMERATOR( Overwrite, Update, "Since v4.0; please use the UpdateMode::Update enumerator." ) ///< @deprecated since v4.0; please use the UpdateMode::Update enumerator.
 };
 
+/**
+ * @brief A std::function whose argument is the path of a volume of the multi-volume archive being created,
+ * called as soon as the volume is complete, i.e., when its file has been closed and will not be modified anymore.
+ */
+using VolumeCallback = std::function< void( tstring ) >;
+
 /**
  * @brief Abstract class representing a generic archive creator.
  */
@@ -98,12 +105,23 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD auto updateMode() const noexcept -> UpdateMode;
 
+        /**
+         * @return whether, when using UpdateMode::Freshen, the creator also compares the CRC of the new items with
+         *         the one of the old items before considering them unchanged.
+         */
+        BIT7Z_NODISCARD auto freshenChecksCrc() const noexcept -> bool;
+
         /**
          * @return the volume size (in bytes) used when creating multi-volume archives
          *         (a 0 value means that all files are going in a single archive).
          */
         BIT7Z_NODISCARD auto volumeSize() const noexcept -> uint64_t;
 
+        /**
+         * @return the function called when a volume of the multi-volume archive being created is complete.
+         */
+        BIT7Z_NODISCARD auto volumeCallback() const -> VolumeCallback;
+
         /**
          * @return the number of threads used when creating/updating an archive
          *         (a 0 value means that it will use the 7-zip default value).
@@ -220,6 +238,17 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
         BIT7Z_DEPRECATED_MSG( "Since v4.0; please use the overloaded function that takes an UpdateMode enumerator." )
         void setUpdateMode( bool canUpdate );
 
+        /**
+         * @brief Sets whether, when using UpdateMode::Freshen, the creator also compares the CRC of the new items
+         * with the one of the old items before considering them unchanged.
+         *
+         * @note Checking the CRC requires reading the new items that have the same size and last write time
+         *       as the old ones.
+         *
+         * @param checkCrc if true, the CRC of the items will be checked.
+         */
+        void setFreshenChecksCrc( bool checkCrc ) noexcept;
+
         /**
          * @brief Sets the volumeSize (in bytes) of the output archive volumes.
          *
@@ -229,6 +258,20 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
          */
         void setVolumeSize( uint64_t volumeSize ) noexcept;
 
+        /**
+         * @brief Sets the function to be called when a volume of the multi-volume archive being created is complete
+         * (e.g., to start uploading the volume while the remaining ones are still being created).
+         *
+         * @note A volume is complete when the archive format will not modify its content anymore;
+         *       hence, volumes may be completed out of order (e.g., the first volume of a 7z archive is usually
+         *       completed last, since its start header is written at the end of the compression).
+         *       With 7-zip versions that do not tell which parts of the archive might still be modified,
+         *       all the volumes are completed at the end of the compression.
+         *
+         * @param callback  the volume callback to be used.
+         */
+        void setVolumeCallback( const VolumeCallback& callback );
+
         /**
          * @brief Sets the number of threads to be used when creating/updating an archive.
          *
@@ -288,6 +331,7 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
         const BitInOutFormat& mFormat;
 
         UpdateMode mUpdateMode;
+        bool mFreshenChecksCrc;
         BitCompressionLevel mCompressionLevel;
         BitCompressionMethod mCompressionMethod;
         uint32_t mDictionarySize;
@@ -295,6 +339,7 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
         bool mCryptHeaders;
         bool mSolidMode;
         uint64_t mVolumeSize;
+        VolumeCallback mVolumeCallback;
         uint32_t mThreadsCount;
         bool mStoreSymbolicLinks;
         std::map< std::wstring, BitPropVariant > mExtraProperties;
@@ -10,6 +10,7 @@
 #ifndef BITABSTRACTARCHIVEHANDLER_HPP
 #define BITABSTRACTARCHIVEHANDLER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 
@@ -68,11 +69,26 @@ enum struct FilterPolicy {
     Exclude  ///< Do not extract/compress the items that match the pattern.
 };
 
+/**
+ * @brief Enumeration representing how the archive handler should read archive files from the filesystem.
+ *
+ * @note Files that cannot be mapped in the address space of the process (e.g., files bigger than 4 GiB
+ *       on 32-bit targets) are always read through file streams.
+ */
+enum struct FileAccessMode {
+    Stream,      ///< Read the archive files through file streams.
+    MemoryMapped ///< Read the archive files through read-only memory mappings of their content.
+};
+
 /**
  * @brief Abstract class representing a generic archive handler.
  */
 class BitAbstractArchiveHandler {
     public:
+        static constexpr auto kDefaultReadAheadBlocks = static_cast< std::size_t >( 2 );
+
+        static constexpr auto kDefaultMaxOpenVolumes = static_cast< std::size_t >( 64 );
+
         BitAbstractArchiveHandler( const BitAbstractArchiveHandler& ) = delete;
 
         BitAbstractArchiveHandler( BitAbstractArchiveHandler&& ) = delete;
@@ -139,6 +155,49 @@ class BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD auto overwriteMode() const -> OverwriteMode;
 
+        /**
+         * @return the current FileAccessMode.
+         */
+        BIT7Z_NODISCARD auto fileAccessMode() const noexcept -> FileAccessMode;
+
+        /**
+         * @return a boolean value indicating whether the extracted files are preallocated to their size
+         * before writing their content.
+         */
+        BIT7Z_NODISCARD auto preallocateFiles() const noexcept -> bool;
+
+        /**
+         * @return a boolean value indicating whether the runs of zero bytes in the extracted files
+         * are turned into holes (i.e., whether the extracted files are sparse).
+         */
+        BIT7Z_NODISCARD auto sparseFiles() const noexcept -> bool;
+
+        /**
+         * @return a boolean value indicating whether the extracted files are written to the disk
+         * by a separate I/O thread, while the archive is being decoded.
+         */
+        BIT7Z_NODISCARD auto writeBehind() const noexcept -> bool;
+
+        /**
+         * @return the size (in bytes) of the blocks read ahead from the archive files (0 if read-ahead is disabled).
+         */
+        BIT7Z_NODISCARD auto readAheadBlockSize() const noexcept -> std::size_t;
+
+        /**
+         * @return the maximum number of blocks read ahead from the archive files at the same time.
+         */
+        BIT7Z_NODISCARD auto readAheadBlocks() const noexcept -> std::size_t;
+
+        /**
+         * @return the maximum number of volume files kept open at the same time when reading multi-volume archives.
+         */
+        BIT7Z_NODISCARD auto maxOpenVolumes() const noexcept -> std::size_t;
+
+        /**
+         * @return the number of threads used by the handler for extracting archives.
+         */
+        BIT7Z_NODISCARD virtual auto extractionThreads() const noexcept -> uint32_t;
+
         /**
          * @brief Sets up a password to be used by the archive handler.
          *
@@ -225,6 +284,73 @@ class BitAbstractArchiveHandler {
          */
         void setOverwriteMode( OverwriteMode mode );
 
+        /**
+         * @brief Sets how the handler should read archive files from the filesystem.
+         *
+         * @note Memory-mapped archive files must not be truncated by other processes while being read.
+         *
+         * @param mode  the FileAccessMode to be used by the handler.
+         */
+        void setFileAccessMode( FileAccessMode mode ) noexcept;
+
+        /**
+         * @brief Sets whether the extracted files must be preallocated to their size before writing their content
+         * (reducing the fragmentation of large files).
+         *
+         * @note Currently, the preallocation of files is supported only on Linux.
+         *
+         * @param preallocate   the setting for preallocating or not the extracted files.
+         */
+        void setPreallocateFiles( bool preallocate ) noexcept;
+
+        /**
+         * @brief Sets whether the runs of zero bytes in the content of the extracted files must be turned
+         * into holes instead of being written to the disk (e.g., when extracting disk images).
+         *
+         * @note Currently, sparse files are supported only on Unix systems, and only when extracting to the filesystem.
+         *
+         * @param sparse    the setting for writing or not sparse files.
+         */
+        void setSparseFiles( bool sparse ) noexcept;
+
+        /**
+         * @brief Sets whether the content of the extracted files must be written to the disk by a separate I/O thread
+         * (write-behind), so that the decoding of the archive does not stall on slow storage (e.g., network shares).
+         *
+         * The decoded data is queued in a bounded pool of buffers, and the writes of each file are completed
+         * before the file is finished (e.g., before its metadata is set).
+         *
+         * @note The write-behind is used only when extracting to the filesystem.
+         *
+         * @param writeBehind   the setting for writing or not the extracted files asynchronously.
+         */
+        void setWriteBehind( bool writeBehind ) noexcept;
+
+        /**
+         * @brief Sets whether the archive files must be read ahead by a background thread
+         * while they are being read sequentially, so that the decoding of the archive does not wait for the disk.
+         *
+         * The read-ahead starts only after a few consecutive sequential reads, and it is suspended
+         * whenever the archive is read at a different position (e.g., when seeking to its headers).
+         *
+         * @note The read-ahead is used for archive files (including multi-volume ones) read through file streams,
+         *       i.e., not when using FileAccessMode::MemoryMapped.
+         *
+         * @param blockSize     the size (in bytes) of the blocks read ahead (0 disables the read-ahead).
+         * @param blocksCount   the maximum number of blocks read ahead at the same time (at least 1).
+         */
+        void setReadAhead( std::size_t blockSize, std::size_t blocksCount = kDefaultReadAheadBlocks ) noexcept;
+
+        /**
+         * @brief Sets the maximum number of volume files kept open at the same time when reading
+         * multi-volume archives (e.g., "archive.7z.001", "archive.7z.002", ...).
+         *
+         * When the limit is reached, the least recently used volume is closed before opening another one.
+         *
+         * @param maxOpenVolumes    the maximum number of open volume files (at least 1).
+         */
+        void setMaxOpenVolumes( std::size_t maxOpenVolumes ) noexcept;
+
     protected:
         explicit BitAbstractArchiveHandler( const Bit7zLibrary& lib,
                                             tstring password = {},
@@ -235,6 +361,13 @@ class BitAbstractArchiveHandler {
         tstring mPassword;
         bool mRetainDirectories;
         OverwriteMode mOverwriteMode;
+        FileAccessMode mFileAccessMode;
+        bool mPreallocateFiles;
+        bool mSparseFiles;
+        bool mWriteBehind;
+        std::size_t mReadAheadBlockSize;
+        std::size_t mReadAheadBlocks;
+        std::size_t mMaxOpenVolumes;
 
         //CALLBACKS
         TotalCallback mTotalCallback;
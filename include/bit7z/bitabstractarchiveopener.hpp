@@ -45,6 +45,27 @@ class BitAbstractArchiveOpener : public BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD auto extractionFormat() const noexcept -> const BitInFormat&;
 
+        /**
+         * @return the number of threads used for extracting archives to the filesystem.
+         */
+        BIT7Z_NODISCARD auto extractionThreads() const noexcept -> uint32_t override;
+
+        /**
+         * @brief Sets the number of threads to be used when extracting archive files to the filesystem.
+         *
+         * When more than one thread is requested, the items of non-solid archive files are split
+         * (by their packed size) among several independent instances of the archive handler,
+         * each extracting its own share of the items concurrently.
+         * Solid archives, and archives read from buffers or streams, are always extracted by a single thread.
+         *
+         * @note During a parallel extraction, the callbacks of the opener are called by all the extraction threads,
+         * so they must be thread-safe; moreover, the total and progress callbacks will report
+         * the values of each thread's share of the items.
+         *
+         * @param threadsCount the number of threads desired (values lower than 2 disable the parallel extraction).
+         */
+        void setExtractionThreads( uint32_t threadsCount ) noexcept;
+
     protected:
         BitAbstractArchiveOpener( const Bit7zLibrary& lib,
                                   const BitInFormat& format,
@@ -52,6 +73,7 @@ class BitAbstractArchiveOpener : public BitAbstractArchiveHandler {
 
     private:
         const BitInFormat& mFormat;
+        uint32_t mExtractionThreads;
 };
 
 }  // namespace bit7z
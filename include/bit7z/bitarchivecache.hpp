@@ -0,0 +1,218 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITARCHIVECACHE_HPP
+#define BITARCHIVECACHE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "bitarchivereader.hpp"
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief The BitArchiveCache class keeps archives open for reuse, so that reading the same archive many times
+ * doesn't need to open it (i.e., parse, and possibly decrypt, its headers) every time.
+ *
+ * Archives are identified by their path, size, and last modification time: if an archive file changes,
+ * it is opened again. When the cache is full, the least recently used archives are closed.
+ *
+ * Since an opened archive cannot be used by more than one operation at a time, each archive is checked out
+ * exclusively by a Handle object, and it is returned to the cache when the handle is destroyed.
+ * If the same archive is checked out again while in use, another instance of it is opened.
+ *
+ * Usage example:
+ * @code{.cpp}
+ * BitArchiveCache cache{ lib, BitFormat::SevenZip };
+ * {
+ *     auto archive = cache.checkout( "path/to/archive.7z" );
+ *     archive->extractTo( outBuffer, 0 );
+ * } // The archive is returned to the cache here.
+ * @endcode
+ *
+ * @note All the methods of the cache can be safely called from multiple threads.
+ */
+class BitArchiveCache final {
+    public:
+        class Handle;
+
+        /**
+         * @brief The usage statistics of a cache.
+         */
+        struct Statistics {
+            std::uint64_t hits;                 ///< The number of checkouts of an already opened archive.
+            std::uint64_t misses;               ///< The number of checkouts that needed to open the archive.
+            std::uint64_t evictions;            ///< The number of opened archives closed to free the cache.
+            std::chrono::nanoseconds openTime;  ///< The total time spent opening archives (i.e., on misses).
+        };
+
+        static constexpr auto kDefaultMaxArchives = static_cast< std::size_t >( 64 );
+
+        /**
+         * @brief Constructs an empty BitArchiveCache object.
+         *
+         * @param lib       the 7z library used.
+         * @param format    the format of the archives to be read.
+         * @param password  (optional) the password needed for opening the archives.
+         */
+        explicit BitArchiveCache( const Bit7zLibrary& lib,
+                                  const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
+                                  const tstring& password = {} );
+
+        BitArchiveCache( const BitArchiveCache& ) = delete;
+
+        BitArchiveCache( BitArchiveCache&& ) = delete;
+
+        auto operator=( const BitArchiveCache& ) -> BitArchiveCache& = delete;
+
+        auto operator=( BitArchiveCache&& ) -> BitArchiveCache& = delete;
+
+        /**
+         * @brief Closes all the archives in the cache.
+         *
+         * @note All the handles must be destroyed before the cache.
+         */
+        ~BitArchiveCache() = default;
+
+        /**
+         * @brief Checks out the archive at the given path, opening it if there's no unused opened instance of it.
+         *
+         * @param inArchive the path to the archive to be read.
+         *
+         * @return the handle giving exclusive access to the opened archive.
+         */
+        BIT7Z_NODISCARD auto checkout( const tstring& inArchive ) -> Handle;
+
+        /**
+         * @return the maximum number of opened archives kept by the cache.
+         */
+        BIT7Z_NODISCARD auto maxArchives() const -> std::size_t;
+
+        /**
+         * @brief Sets the maximum number of opened archives kept by the cache.
+         *
+         * @note Checked out archives are never closed, so the cache might temporarily exceed the limit.
+         *
+         * @param maxArchives   the maximum number of opened archives.
+         */
+        void setMaxArchives( std::size_t maxArchives );
+
+        /**
+         * @return the maximum total number of items of the opened archives kept by the cache (0 if unlimited).
+         */
+        BIT7Z_NODISCARD auto maxItems() const -> std::size_t;
+
+        /**
+         * @brief Sets the maximum total number of items of the opened archives kept by the cache.
+         *
+         * The memory used by an opened archive is mostly proportional to the number of its items,
+         * so this limit allows bounding the memory used by the cache.
+         *
+         * @note Checked out archives are never closed, so the cache might temporarily exceed the limit.
+         *
+         * @param maxItems  the maximum total number of items (0 for no limit).
+         */
+        void setMaxItems( std::size_t maxItems );
+
+        /**
+         * @return the number of opened archives in the cache (including the checked out ones).
+         */
+        BIT7Z_NODISCARD auto size() const -> std::size_t;
+
+        /**
+         * @return the usage statistics of the cache.
+         */
+        BIT7Z_NODISCARD auto statistics() const -> Statistics;
+
+        /**
+         * @brief Closes all the archives in the cache that are not checked out.
+         */
+        void clear();
+
+    private:
+        struct Entry {
+            tstring path;
+            std::uint64_t size;
+            std::int64_t writeTime;
+            std::uint32_t itemsCount;
+            bool inUse;
+            std::unique_ptr< BitArchiveReader > reader;
+        };
+
+        using EntryIterator = std::list< Entry >::iterator;
+
+        const Bit7zLibrary& mLibrary;
+        const BitInFormat& mFormat;
+        tstring mPassword;
+
+        mutable std::mutex mMutex;
+        std::list< Entry > mEntries; // Sorted from the most recently used to the least recently used.
+        std::unordered_multimap< tstring, EntryIterator > mEntriesIndex;
+        std::size_t mMaxArchives;
+        std::size_t mMaxItems;
+        std::size_t mCachedItems;
+        Statistics mStatistics;
+
+        void release( EntryIterator entry ) noexcept;
+
+        /* The erased entries are moved to the given list, so that their archives are closed
+         * by the caller after releasing the lock, without blocking the other threads. */
+        void erase( EntryIterator entry, std::list< Entry >& erased );
+
+        void evict( std::list< Entry >& evicted );
+};
+
+/**
+ * @brief The Handle class gives exclusive access to an archive checked out from a BitArchiveCache.
+ */
+class BitArchiveCache::Handle final {
+    public:
+        Handle( const Handle& ) = delete;
+
+        Handle( Handle&& other ) noexcept;
+
+        auto operator=( const Handle& ) -> Handle& = delete;
+
+        auto operator=( Handle&& other ) noexcept -> Handle&;
+
+        /**
+         * @brief Returns the archive to the cache.
+         */
+        ~Handle();
+
+        /**
+         * @return the checked out archive.
+         */
+        BIT7Z_NODISCARD auto operator*() const noexcept -> const BitArchiveReader&;
+
+        /**
+         * @return a pointer to the checked out archive.
+         */
+        BIT7Z_NODISCARD auto operator->() const noexcept -> const BitArchiveReader*;
+
+    private:
+        BitArchiveCache* mCache;
+        EntryIterator mEntry;
+
+        Handle( BitArchiveCache& cache, EntryIterator entry ) noexcept;
+
+        friend class BitArchiveCache;
+};
+
+}  // namespace bit7z
+
+#endif // BITARCHIVECACHE_HPP
@@ -11,11 +11,14 @@
 #define BITARCHIVEITEMINFO_HPP
 
 #include <map>
+#include <memory>
 
 #include "bitarchiveitem.hpp"
 
 namespace bit7z {
 
+class BitItemTable;
+
 using std::wstring;
 using std::map;
 
@@ -40,13 +43,19 @@ class BitArchiveItemInfo final : public BitArchiveItem {
 
     private:
         map< BitProperty, BitPropVariant > mItemProperties;
+        std::shared_ptr< const BitItemTable > mItemTable;
 
-        /* BitArchiveItem objects can be created and updated only by BitArchiveReader */
+        /* BitArchiveItem objects can be created and updated only by BitArchiveReader and BitItemReader */
         explicit BitArchiveItemInfo( uint32_t itemIndex );
 
+        /* Item whose properties are read from a snapshot shared with the other items of the archive. */
+        BitArchiveItemInfo( uint32_t itemIndex, std::shared_ptr< const BitItemTable > itemTable );
+
         void setProperty( BitProperty property, const BitPropVariant& value );
 
         friend class BitArchiveReader;
+
+        friend class BitItemReader;
 };
 
 }  // namespace bit7z
@@ -0,0 +1,225 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITCONCURRENTARCHIVEREADER_HPP
+#define BITCONCURRENTARCHIVEREADER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "bitarchivereader.hpp"
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief The BitConcurrentArchiveReader class allows reading the items of an archive from multiple threads at once.
+ *
+ * An opened archive can serve only one operation at a time, so the reader opens the same archive
+ * multiple times (shards), and dispatches each operation to an idle shard.
+ * New shards are opened on demand, up to a maximum number: when all the shards are busy,
+ * operations wait for a shard to be released.
+ *
+ * Usage example:
+ * @code{.cpp}
+ * const BitConcurrentArchiveReader reader{ lib, "path/to/archive.7z", 8, BitFormat::SevenZip };
+ * // ...then, from any thread...
+ * std::vector< byte_t > buffer;
+ * reader.extractTo( buffer, itemIndex );
+ * @endcode
+ *
+ * @note All the methods can be safely called from multiple threads.
+ */
+class BitConcurrentArchiveReader final {
+    public:
+        /**
+         * @brief The usage statistics of a shard.
+         */
+        struct ShardStatistics {
+            std::uint64_t requests;             ///< The number of operations served by the shard.
+            std::chrono::nanoseconds busyTime;  ///< The total time spent by the shard serving operations.
+            bool busy;                          ///< Whether the shard is currently serving an operation.
+        };
+
+        /**
+         * @brief The usage statistics of a concurrent reader.
+         */
+        struct Statistics {
+            std::vector< ShardStatistics > shards;  ///< The statistics of each opened shard.
+            std::uint64_t waits;                    ///< The number of operations that had to wait for a shard.
+        };
+
+        /**
+         * @brief Constructs a BitConcurrentArchiveReader object, opening the input file archive.
+         *
+         * @param lib           the 7z library used.
+         * @param inArchive     the path to the archive to be read.
+         * @param maxShards     the maximum number of times the archive can be opened at once.
+         * @param format        the format of the input archive.
+         * @param password      (optional) the password needed for opening the input archive.
+         */
+        BitConcurrentArchiveReader( const Bit7zLibrary& lib,
+                                    const tstring& inArchive,
+                                    std::size_t maxShards,
+                                    const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
+                                    const tstring& password = {} );
+
+        /**
+         * @brief Constructs a BitConcurrentArchiveReader object, opening the archive in the input buffer.
+         *
+         * @note The buffer must not be modified or destroyed while the reader is in use.
+         *
+         * @param lib           the 7z library used.
+         * @param inArchive     the input buffer containing the archive to be read.
+         * @param maxShards     the maximum number of times the archive can be opened at once.
+         * @param format        the format of the input archive.
+         * @param password      (optional) the password needed for opening the input archive.
+         */
+        BitConcurrentArchiveReader( const Bit7zLibrary& lib,
+                                    const buffer_t& inArchive,
+                                    std::size_t maxShards,
+                                    const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
+                                    const tstring& password = {} );
+
+        BitConcurrentArchiveReader( const BitConcurrentArchiveReader& ) = delete;
+
+        BitConcurrentArchiveReader( BitConcurrentArchiveReader&& ) = delete;
+
+        auto operator=( const BitConcurrentArchiveReader& ) -> BitConcurrentArchiveReader& = delete;
+
+        auto operator=( BitConcurrentArchiveReader&& ) -> BitConcurrentArchiveReader& = delete;
+
+        ~BitConcurrentArchiveReader() = default;
+
+        /**
+         * @brief Calls the given function with an opened archive reserved for the calling thread.
+         *
+         * @param function  the function to be called; it takes the opened archive (a const BitArchiveReader&).
+         *
+         * @return the value returned by the function.
+         */
+        template< typename Function >
+        auto use( Function&& function ) const -> decltype( function( std::declval< const BitArchiveReader& >() ) ) {
+            const ShardLease lease{ *this };
+            return std::forward< Function >( function )( lease.reader() );
+        }
+
+        /**
+         * @return the number of items contained in the archive.
+         */
+        BIT7Z_NODISCARD auto itemsCount() const -> uint32_t;
+
+        /**
+         * @brief Extracts a file to the output buffer.
+         *
+         * @param outBuffer   the output buffer where the content of the archive will be put.
+         * @param index       the index of the file to be extracted.
+         */
+        void extractTo( std::vector< byte_t >& outBuffer, uint32_t index = 0 ) const;
+
+        /**
+         * @brief Extracts a file to the pre-allocated output buffer.
+         *
+         * @param buffer    the output buffer where the content of the archive will be put.
+         * @param size      the size of the output buffer.
+         * @param index     the index of the file to be extracted.
+         */
+        void extractTo( byte_t* buffer, std::size_t size, uint32_t index = 0 ) const;
+
+        /**
+         * @brief Extracts a file to the output stream.
+         *
+         * @param outStream   the (binary) stream where the content of the archive will be put.
+         * @param index       the index of the file to be extracted.
+         */
+        void extractTo( std::ostream& outStream, uint32_t index = 0 ) const;
+
+        /**
+         * @return the maximum number of times the archive can be opened at once.
+         */
+        BIT7Z_NODISCARD auto maxShards() const noexcept -> std::size_t;
+
+        /**
+         * @return the number of times the archive is currently opened.
+         */
+        BIT7Z_NODISCARD auto shardsCount() const -> std::size_t;
+
+        /**
+         * @return the usage statistics of the reader.
+         */
+        BIT7Z_NODISCARD auto statistics() const -> Statistics;
+
+    private:
+        struct Shard {
+            std::unique_ptr< BitArchiveReader > reader;
+            bool busy;
+            std::uint64_t requests;
+            std::chrono::nanoseconds busyTime;
+        };
+
+        class ShardLease final {
+            public:
+                explicit ShardLease( const BitConcurrentArchiveReader& owner );
+
+                ShardLease( const ShardLease& ) = delete;
+
+                ShardLease( ShardLease&& ) = delete;
+
+                auto operator=( const ShardLease& ) -> ShardLease& = delete;
+
+                auto operator=( ShardLease&& ) -> ShardLease& = delete;
+
+                ~ShardLease();
+
+                BIT7Z_NODISCARD auto reader() const noexcept -> const BitArchiveReader&;
+
+            private:
+                const BitConcurrentArchiveReader& mOwner;
+                Shard& mShard;
+                std::chrono::steady_clock::time_point mStart;
+        };
+
+        const Bit7zLibrary& mLibrary;
+        tstring mArchivePath;
+        const buffer_t* mArchiveBuffer;
+        const BitInFormat& mFormat;
+        tstring mPassword;
+        std::size_t mMaxShards;
+
+        mutable std::mutex mMutex;
+        mutable std::condition_variable mShardReleased;
+        mutable std::vector< std::unique_ptr< Shard > > mShards;
+        mutable std::size_t mOpeningShards;
+        mutable std::uint64_t mWaits;
+
+        BitConcurrentArchiveReader( const Bit7zLibrary& lib,
+                                    tstring inArchivePath,
+                                    const buffer_t* inArchiveBuffer,
+                                    std::size_t maxShards,
+                                    const BitInFormat& format,
+                                    const tstring& password );
+
+        BIT7Z_NODISCARD auto openShard() const -> std::unique_ptr< Shard >;
+
+        BIT7Z_NODISCARD auto acquireShard() const -> Shard&;
+
+        void releaseShard( Shard& shard, std::chrono::nanoseconds busyTime ) const noexcept;
+};
+
+}  // namespace bit7z
+
+#endif // BITCONCURRENTARCHIVEREADER_HPP
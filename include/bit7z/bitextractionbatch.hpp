@@ -0,0 +1,107 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITEXTRACTIONBATCH_HPP
+#define BITEXTRACTIONBATCH_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief The BitExtractionBatch class is a set of requests for extracting items of an archive,
+ * each one to its own destination (a buffer, an output stream, or a file).
+ *
+ * A batch is extracted by BitInputArchive::extractTo, which validates all the requests at once,
+ * and then extracts the requested items in as few passes over the archive as possible
+ * (i.e., each solid block of the archive is decoded only once).
+ */
+class BitExtractionBatch final {
+    public:
+        /**
+         * @brief The kind of destination of an extraction request.
+         */
+        enum struct Destination : std::uint8_t {
+            Buffer, ///< The item is extracted to a buffer.
+            Stream, ///< The item is extracted to an output stream.
+            File    ///< The item is extracted to a file.
+        };
+
+        /**
+         * @brief A request for extracting a single item of the archive.
+         */
+        struct Request {
+            uint32_t index;
+            Destination destination;
+            std::vector< byte_t >* buffer;
+            std::ostream* stream;
+            tstring filePath;
+        };
+
+        /**
+         * @brief Requests the extraction of the item at the given index to the given buffer.
+         *
+         * @note The previous content of the buffer is replaced by the content of the item.
+         *
+         * @param index     the index of the item to be extracted.
+         * @param outBuffer the output buffer where the content of the item will be put.
+         */
+        void add( uint32_t index, std::vector< byte_t >& outBuffer );
+
+        /**
+         * @brief Requests the extraction of the item at the given index to the given output stream.
+         *
+         * @param index     the index of the item to be extracted.
+         * @param outStream the output stream where the content of the item will be written.
+         */
+        void add( uint32_t index, std::ostream& outStream );
+
+        /**
+         * @brief Requests the extraction of the item at the given index to the given file.
+         *
+         * @note Missing parent folders of the file are created, while an existing file is handled
+         * according to the OverwriteMode of the archive handler.
+         *
+         * @param index     the index of the item to be extracted.
+         * @param outFile   the path of the output file.
+         */
+        void add( uint32_t index, const tstring& outFile );
+
+        /**
+         * @return the extraction requests in the batch, in the order they were added.
+         */
+        BIT7Z_NODISCARD auto requests() const noexcept -> const std::vector< Request >&;
+
+        /**
+         * @return the number of extraction requests in the batch.
+         */
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+        /**
+         * @return a boolean value indicating whether the batch has no extraction requests.
+         */
+        BIT7Z_NODISCARD auto empty() const noexcept -> bool;
+
+        /**
+         * @brief Removes all the extraction requests from the batch.
+         */
+        void clear() noexcept;
+
+    private:
+        std::vector< Request > mRequests;
+};
+
+}  // namespace bit7z
+
+#endif // BITEXTRACTIONBATCH_HPP
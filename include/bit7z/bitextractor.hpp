@@ -98,6 +98,18 @@ class BitExtractor final : public BitAbstractArchiveOpener {
             inputArchive.extractTo( outMap );
         }
 
+        /**
+         * @brief Extracts the content of the given archive into a memory arena, where the contents of the files
+         * are stored one after the other in a single buffer, and indexed by their paths (inside the archive).
+         *
+         * @param inArchive    the input archive to be extracted.
+         * @param outArena     the output memory arena.
+         */
+        void extract( Input inArchive, BitMemoryArena& outArena ) const {
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( outArena );
+        }
+
         /**
          * @brief Extracts the files in the archive that match the given wildcard pattern to the chosen directory.
          *
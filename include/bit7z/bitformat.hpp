@@ -11,6 +11,7 @@
 #define BITFORMAT_HPP
 
 #include <bitset>
+#include <cstddef>
 #include <type_traits>
 
 #include "bitcompressionmethod.hpp"
@@ -242,6 +243,37 @@ extern const BitInOutFormat Tar;        ///< TAR Archive Format
 extern const BitInOutFormat GZip;       ///< GZIP Archive Format
 }  // namespace BitFormat
 
+#ifdef BIT7Z_AUTO_FORMAT
+/**
+ * @brief The number of bytes at the beginning of a file that are needed to detect all the supported signatures.
+ */
+constexpr auto kFormatProbeSize = static_cast< std::size_t >( 64 * 1024 );
+
+/**
+ * @brief Detects the format of an archive from the signature contained in its first bytes,
+ * without opening the archive (available only when compiling bit7z using the `BIT7Z_AUTO_FORMAT` option).
+ *
+ * @note Some formats (e.g., ISO and UDF) have their signature far from the beginning of the file:
+ *       to detect all the supported formats, the data should contain the first kFormatProbeSize bytes of the file
+ *       (or the whole file, if it is smaller).
+ *
+ * @param data  the first bytes of the archive file.
+ * @param size  the number of bytes pointed by data.
+ *
+ * @return the detected format, or BitFormat::Auto if the data does not match any known signature.
+ */
+BIT7Z_NODISCARD auto detectFormat( const byte_t* data, std::size_t size ) noexcept -> const BitInFormat&;
+
+/**
+ * @brief Detects the format of an archive from the signature contained in its first bytes,
+ * without opening the archive (available only when compiling bit7z using the `BIT7Z_AUTO_FORMAT` option).
+ *
+ * @param buffer    the buffer containing the first bytes of the archive file.
+ *
+ * @return the detected format, or BitFormat::Auto if the buffer does not match any known signature.
+ */
+BIT7Z_NODISCARD auto detectFormat( const buffer_t& buffer ) noexcept -> const BitInFormat&;
+#endif
 
 #ifdef BIT7Z_AUTO_FORMAT
 #define BIT7Z_DEFAULT_FORMAT = BitFormat::Auto
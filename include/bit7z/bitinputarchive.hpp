@@ -10,13 +10,22 @@
 #define BITINPUTARCHIVE_HPP
 
 #include <array>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "bitabstractarchivehandler.hpp"
 #include "bitarchiveitemoffset.hpp"
+#include "bitextractionbatch.hpp"
 #include "bitformat.hpp"
 #include "bitfs.hpp"
+#include "bititemtable.hpp"
+#include "bitmemoryarena.hpp"
 
+struct ISequentialInStream;
 struct IInStream;
 struct IInArchive;
 struct IOutArchive;
@@ -25,6 +34,22 @@ namespace bit7z {
 
 using std::vector;
 
+class ItemPathIndex;
+
+/**
+ * @brief A std::function receiving the chunks of the content of an extracted item as soon as they are decoded,
+ *        and returning true or false whether the extraction must continue or not.
+ *
+ * @note The data pointer is valid only during the call.
+ */
+using ItemSink = std::function< bool( const byte_t*, std::size_t ) >;
+
+/**
+ * @brief A std::function whose argument is an item being extracted, and returning the ItemSink to which
+ *        the item's content must be written (or an empty function, if the content must be skipped).
+ */
+using ItemSinkFactory = std::function< ItemSink( const BitArchiveItem& ) >;
+
 /**
  * @brief Offset from where the archive starts within the input file.
  */
@@ -81,6 +106,16 @@ class BitInputArchive {
         /**
          * @brief Constructs a BitInputArchive object, opening the archive by reading the given input stream.
          *
+         * If the input stream is not seekable (e.g., it reads from a pipe or a socket), the archive is read
+         * sequentially, and its items are known only while they are extracted, in the archive order.
+         * In this case:
+         *  - the format of the archive must be specified explicitly, and it must support sequential reading
+         *    (e.g., Tar, GZip, BZip2, Xz, Zstd, and Cpio);
+         *  - the archive can be extracted only once, and only as a whole (i.e., to a directory, to a map of buffers,
+         *    to a memory arena, to item sinks, or through a BitItemReader); any further extraction throws
+         *    a BitException with the BitError::FormatFeatureNotSupported error code;
+         *  - the startOffset is ignored, as the archive must start at the current position of the stream.
+         *
          * @param handler     the reference to the BitAbstractArchiveHandler object containing all the settings to
          *                    be used for reading the input archive
          * @param inStream    the standard input stream of the input archive
@@ -126,6 +161,20 @@ class BitInputArchive {
          */
         BIT7Z_NODISCARD auto itemProperty( uint32_t index, BitProperty property ) const -> BitPropVariant;
 
+        /**
+         * @brief Reads the given properties of all the items in the archive in a single pass.
+         *
+         * The archive keeps a reference to the last snapshot it returned: until a format property is changed,
+         * the item properties contained in the snapshot are not queried again to the archive handler
+         * (e.g., during the extraction of the archive).
+         *
+         * @param properties the properties to be read.
+         *
+         * @return a columnar snapshot of the values of the given properties for all the items in the archive.
+         */
+        BIT7Z_NODISCARD
+        auto itemTable( const std::vector< BitProperty >& properties ) const -> std::shared_ptr< const BitItemTable >;
+
         /**
          * @return the number of items contained in the archive.
          */
@@ -288,6 +337,42 @@ class BitInputArchive {
          */
         void extractTo( std::map< tstring, std::vector< byte_t > >& outMap ) const;
 
+        /**
+         * @brief Extracts the content of the archive to a memory arena, where the contents of the files are
+         * stored one after the other in a single buffer, and indexed by their paths (inside the archive).
+         *
+         * Unlike the extraction to a map of buffers, no memory allocation is performed for each file,
+         * making this method better suited for archives containing many small files.
+         *
+         * @note The previous content of the arena is discarded.
+         *
+         * @param outArena   the output memory arena.
+         */
+        void extractTo( BitMemoryArena& outArena ) const;
+
+        /**
+         * @brief Extracts the content of the archive's files to the sinks returned by the given factory.
+         *
+         * Each chunk of decoded data is passed to the sink of the item as it is produced by the decoder,
+         * without being copied to intermediate buffers or streams.
+         * If a sink returns false, the extraction is stopped (without throwing exceptions), while the exceptions
+         * thrown by the sinks (or by the factory) stop the extraction and are propagated to the caller.
+         *
+         * @param sinkFactory   the function returning the sink of each file being extracted.
+         * @param indices       the indices of the items to be extracted (all the items, if empty).
+         */
+        void extractTo( const ItemSinkFactory& sinkFactory, const std::vector< uint32_t >& indices = {} ) const;
+
+        /**
+         * @brief Extracts the items requested by the given batch, each one to its own destination.
+         *
+         * All the requests are validated before extracting anything; then, the requested items are grouped by
+         * the solid block they belong to, so that each block is decoded only once, instead of once per item.
+         *
+         * @param batch the batch of extraction requests.
+         */
+        void extractTo( const BitExtractionBatch& batch ) const;
+
         /**
          * @brief Tests the archive without extracting its content.
          *
@@ -309,10 +394,14 @@ class BitInputArchive {
 
         BIT7Z_NODISCARD auto close() const noexcept -> HRESULT;
 
+        BIT7Z_NODISCARD auto fullItemTable() const -> std::shared_ptr< const BitItemTable >;
+
         friend class BitAbstractArchiveOpener;
 
         friend class BitAbstractArchiveCreator;
 
+        friend class BitItemReader;
+
         friend class BitOutputArchive;
 
     private:
@@ -320,10 +409,29 @@ class BitInputArchive {
         const BitInFormat* mDetectedFormat;
         const BitAbstractArchiveHandler& mArchiveHandler;
         tstring mArchivePath;
+        mutable std::shared_ptr< const BitItemTable > mItemTable;
+        mutable std::unique_ptr< ItemPathIndex > mPathIndex;
+        mutable bool mReusableHandler;
+        bool mSequentialAccess;
+        mutable bool mSequentialStreamConsumed;
+        ArchiveStartOffset mStartOffset;
+        mutable std::vector< std::pair< std::wstring, BitPropVariant > > mFormatProperties;
 
         BIT7Z_NODISCARD
         auto openArchiveStream( const fs::path& name, IInStream* inStream, ArchiveStartOffset startOffset ) -> IInArchive*;
 
+        BIT7Z_NODISCARD auto openArchiveSequentialStream( ISequentialInStream* inStream ) -> IInArchive*;
+
+        void beginExtraction() const;
+
+        BIT7Z_NODISCARD auto itemPathIndex() const -> const ItemPathIndex&;
+
+        BIT7Z_NODISCARD
+        auto extractionPartitions( const std::vector< uint32_t >& indices ) const
+            -> std::vector< std::vector< uint32_t > >;
+
+        void extractToDirectory( const tstring& outDir, const std::vector< uint32_t >& indices ) const;
+
     public:
         /**
          * @brief An iterator for the elements contained in an archive.
@@ -420,6 +528,9 @@ class BitInputArchive {
         /**
          * @brief Find an item in the archive that has the given path.
          *
+         * @note The first search builds a hash index of the paths of the archive's items, so that
+         *       subsequent searches take constant time. Trailing path separators are ignored.
+         *
          * @param path the path to be searched in the archive.
          *
          * @return an iterator to the item with the given path, or an iterator equal to the end() iterator
@@ -0,0 +1,150 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITITEMCACHE_HPP
+#define BITITEMCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+class BitInputArchive;
+
+/**
+ * @brief The BitItemCache class keeps the decoded content of the files of an archive in memory,
+ * so that reading the same files many times doesn't need to decode them every time.
+ *
+ * In solid archives, decoding a file requires decoding all the files preceding it in the same solid block:
+ * when a file is not in the cache, the files of its block decoded in the same pass are cached too,
+ * as long as they fit in the memory budget without evicting other files.
+ * When the cache is full, the least recently used files are evicted first.
+ *
+ * Usage example:
+ * @code{.cpp}
+ * BitItemCache cache{ archive, 32 * 1024 * 1024 };
+ * const auto content = cache.content( itemIndex );
+ * // ...use the content->size() bytes starting from content->data()...
+ * @endcode
+ *
+ * @note Like the archive, the cache must not be used by multiple threads at the same time.
+ */
+class BitItemCache final {
+    public:
+        /**
+         * @brief The usage statistics of a cache.
+         */
+        struct Statistics {
+            std::uint64_t hits;         ///< The number of requested files that were in the cache.
+            std::uint64_t misses;       ///< The number of requested files that had to be decoded.
+            std::uint64_t speculative;  ///< The number of files cached because decoded together with a requested one.
+            std::uint64_t evictions;    ///< The number of files removed from the cache to free memory.
+        };
+
+        static constexpr auto kDefaultMaxBytes = static_cast< std::size_t >( 64 * 1024 * 1024 );
+
+        /**
+         * @brief Constructs an empty BitItemCache object for the given archive.
+         *
+         * @param archive   the archive whose files must be cached.
+         * @param maxBytes  the maximum total size (in bytes) of the cached content.
+         */
+        explicit BitItemCache( const BitInputArchive& archive, std::size_t maxBytes = kDefaultMaxBytes );
+
+        /**
+         * @brief Returns the decoded content of the file at the given index, decoding it if it is not cached.
+         *
+         * @note The returned content is still valid after it is evicted from the cache.
+         *
+         * @param index the index of the file.
+         *
+         * @return the decoded content of the file.
+         */
+        BIT7Z_NODISCARD auto content( uint32_t index ) -> std::shared_ptr< const buffer_t >;
+
+        /**
+         * @brief Copies the decoded content of the file at the given index to the output buffer.
+         *
+         * @param outBuffer the output buffer where the content of the file will be put.
+         * @param index     the index of the file.
+         */
+        void extractTo( buffer_t& outBuffer, uint32_t index );
+
+        /**
+         * @param index the index of a file.
+         *
+         * @return a boolean value indicating whether the content of the file is cached.
+         */
+        BIT7Z_NODISCARD auto contains( uint32_t index ) const -> bool;
+
+        /**
+         * @return the maximum total size (in bytes) of the cached content.
+         */
+        BIT7Z_NODISCARD auto maxBytes() const noexcept -> std::size_t;
+
+        /**
+         * @brief Sets the maximum total size (in bytes) of the cached content, evicting files if needed.
+         *
+         * @param maxBytes  the maximum total size of the cached content.
+         */
+        void setMaxBytes( std::size_t maxBytes );
+
+        /**
+         * @return the total size (in bytes) of the cached content.
+         */
+        BIT7Z_NODISCARD auto cachedBytes() const noexcept -> std::size_t;
+
+        /**
+         * @return the number of cached files.
+         */
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+        /**
+         * @return the usage statistics of the cache.
+         */
+        BIT7Z_NODISCARD auto statistics() const noexcept -> Statistics;
+
+        /**
+         * @brief Removes all the files from the cache.
+         */
+        void clear() noexcept;
+
+    private:
+        struct Entry {
+            uint32_t index;
+            std::shared_ptr< const buffer_t > content;
+        };
+
+        using EntryIterator = std::list< Entry >::iterator;
+
+        const BitInputArchive& mArchive;
+        std::size_t mMaxBytes;
+        std::size_t mCachedBytes;
+        std::list< Entry > mEntries; // Sorted from the most recently used to the least recently used.
+        std::unordered_map< uint32_t, EntryIterator > mEntriesIndex;
+        std::vector< std::uint64_t > mItemsBlocks;
+        Statistics mStatistics;
+
+        BIT7Z_NODISCARD auto decodedTogetherWith( uint32_t index ) -> std::vector< uint32_t >;
+
+        void erase( EntryIterator entry ) noexcept;
+
+        void evict();
+};
+
+}  // namespace bit7z
+
+#endif // BITITEMCACHE_HPP
@@ -0,0 +1,136 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITITEMREADER_HPP
+#define BITITEMREADER_HPP
+
+#include <memory>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include "bitarchiveiteminfo.hpp"
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+class BitInputArchive;
+class BitItemTable;
+class ItemPipe;
+
+/**
+ * @brief The BitItemReader class allows reading the content of the files in an archive one after the other,
+ * pulling the data of each file as needed (e.g., to process large files using a constant amount of memory).
+ *
+ * The archive is extracted by a worker thread, which writes the content of the current file to a bounded buffer,
+ * and waits whenever the buffer is full, until the data is read.
+ *
+ * Usage example:
+ * @code{.cpp}
+ * BitItemReader reader{ archive };
+ * while ( reader.nextItem() ) {
+ *     std::istream input{ &reader.streamBuffer() };
+ *     // ...read the content of reader.currentItem() from input...
+ * }
+ * @endcode
+ *
+ * @note While the reader is in use, the archive must not be used for other operations.
+ */
+class BitItemReader final {
+    public:
+        static constexpr auto kDefaultBufferSize = static_cast< std::size_t >( 1024 * 1024 );
+
+        /**
+         * @brief Constructs a BitItemReader object, starting the extraction of the given archive.
+         *
+         * @param archive       the archive whose files must be read.
+         * @param bufferSize    the size (in bytes) of the buffer between the extraction and the reader.
+         */
+        explicit BitItemReader( const BitInputArchive& archive, std::size_t bufferSize = kDefaultBufferSize );
+
+        BitItemReader( const BitItemReader& ) = delete;
+
+        BitItemReader( BitItemReader&& ) = delete;
+
+        auto operator=( const BitItemReader& ) -> BitItemReader& = delete;
+
+        auto operator=( BitItemReader&& ) -> BitItemReader& = delete;
+
+        /**
+         * @brief Stops the extraction of the archive, if it is not finished yet.
+         */
+        ~BitItemReader();
+
+        /**
+         * @brief Moves the reader to the next file in the archive, skipping the unread content of the current one.
+         *
+         * @note Folders are skipped.
+         *
+         * @return true if the reader moved to the next file, false if there are no more files in the archive.
+         */
+        auto nextItem() -> bool;
+
+        /**
+         * @return the properties of the current file.
+         */
+        BIT7Z_NODISCARD auto currentItem() const -> const BitArchiveItemInfo&;
+
+        /**
+         * @brief Reads the next chunk of the content of the current file.
+         *
+         * @param buffer    the buffer where the data must be put.
+         * @param size      the size of the buffer.
+         *
+         * @return the number of bytes read (less than size only if the end of the file is reached, or if less data
+         *         is currently available), or 0 if the end of the current file was reached.
+         */
+        auto read( byte_t* buffer, std::size_t size ) -> std::size_t;
+
+        /**
+         * @brief Reads the next chunk of the content of the current file.
+         *
+         * @param buffer    the buffer where the data must be put.
+         *
+         * @return the number of bytes read, or 0 if the end of the current file was reached.
+         */
+        auto read( std::vector< byte_t >& buffer ) -> std::size_t;
+
+        /**
+         * @return a stream buffer reading the content of the current file
+         *         (e.g., to be used with a std::istream object).
+         */
+        auto streamBuffer() -> std::streambuf&;
+
+    private:
+        class ItemStreamBuffer final : public std::streambuf {
+            public:
+                explicit ItemStreamBuffer( BitItemReader& reader );
+
+                void reset();
+
+            protected:
+                auto underflow() -> int_type override;
+
+            private:
+                BitItemReader& mReader;
+                std::vector< char > mChunk;
+        };
+
+        const BitInputArchive& mArchive;
+        std::shared_ptr< const BitItemTable > mItemTable;
+        std::unique_ptr< ItemPipe > mPipe;
+        std::unique_ptr< BitArchiveItemInfo > mCurrentItem;
+        ItemStreamBuffer mStreamBuffer;
+        std::thread mWorker;
+};
+
+}  // namespace bit7z
+
+#endif // BITITEMREADER_HPP
@@ -0,0 +1,124 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITITEMTABLE_HPP
+#define BITITEMTABLE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bitpropvariant.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+class BitInputArchive;
+
+/**
+ * @brief The BitItemTable class is a read-only, columnar snapshot of a set of properties of all the items
+ * contained in an archive.
+ *
+ * The properties are read from the archive in a single pass, and stored column by column
+ * (one array per property), while all the string values (e.g., the items' paths) are stored
+ * in a single contiguous string arena.
+ */
+class BitItemTable final {
+    public:
+        /**
+         * @return the number of items in the snapshot.
+         */
+        BIT7Z_NODISCARD auto itemsCount() const noexcept -> uint32_t;
+
+        /**
+         * @return the properties contained in the snapshot.
+         */
+        BIT7Z_NODISCARD auto properties() const noexcept -> const std::vector< BitProperty >&;
+
+        /**
+         * @param property the property to be checked.
+         *
+         * @return true if and only if the snapshot contains the values of the given property.
+         */
+        BIT7Z_NODISCARD auto hasProperty( BitProperty property ) const noexcept -> bool;
+
+        /**
+         * @brief Gets the specified property of an item in the snapshot.
+         *
+         * @param index     the index (in the archive) of the item.
+         * @param property  the property to be retrieved.
+         *
+         * @return the value of the item property or an empty BitPropVariant if the item has no value for
+         *         the property.
+         */
+        BIT7Z_NODISCARD auto itemProperty( uint32_t index, BitProperty property ) const -> BitPropVariant;
+
+        /**
+         * @param index the index (in the archive) of the item.
+         *
+         * @return the path of the item (the snapshot must contain the BitProperty::Path).
+         */
+        BIT7Z_NODISCARD auto path( uint32_t index ) const -> tstring;
+
+        /**
+         * @param index the index (in the archive) of the item.
+         *
+         * @return true if and only if the item is a folder (the snapshot must contain the BitProperty::IsDir).
+         */
+        BIT7Z_NODISCARD auto isDir( uint32_t index ) const -> bool;
+
+        /**
+         * @param index the index (in the archive) of the item.
+         *
+         * @return the uncompressed size of the item (the snapshot must contain the BitProperty::Size).
+         */
+        BIT7Z_NODISCARD auto size( uint32_t index ) const -> uint64_t;
+
+        /**
+         * @param index the index (in the archive) of the item.
+         *
+         * @return the compressed size of the item (the snapshot must contain the BitProperty::PackSize).
+         */
+        BIT7Z_NODISCARD auto packSize( uint32_t index ) const -> uint64_t;
+
+        /**
+         * @param index the index (in the archive) of the item.
+         *
+         * @return the CRC value of the item (the snapshot must contain the BitProperty::CRC).
+         */
+        BIT7Z_NODISCARD auto crc( uint32_t index ) const -> uint32_t;
+
+    private:
+        struct Column {
+            BitProperty property;
+            std::vector< BitPropVariantType > types;
+
+            // Raw value of each item: booleans and integers are stored as is, FILETIMEs are packed
+            // into a single 64-bit integer, while strings are stored as offsets into the string arena.
+            std::vector< uint64_t > values;
+        };
+
+        uint32_t mItemsCount;
+        std::vector< BitProperty > mProperties;
+        std::vector< Column > mColumns;
+        std::wstring mStringArena;
+
+        BitItemTable( const BitInputArchive& inputArchive, const std::vector< BitProperty >& properties );
+
+        BIT7Z_NODISCARD auto column( BitProperty property ) const -> const Column*;
+
+        BIT7Z_NODISCARD auto stringValue( const Column& column, uint32_t index ) const noexcept -> const wchar_t*;
+
+        friend class BitInputArchive;
+};
+
+}  // namespace bit7z
+
+#endif // BITITEMTABLE_HPP
@@ -0,0 +1,115 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITMEMORYARENA_HPP
+#define BITMEMORYARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief The BitMemoryArena class stores the decompressed contents of the files in an archive,
+ * one after the other in a single contiguous buffer, together with a flat index of the files sorted by path.
+ *
+ * Compared to a map of buffers, the arena does not need any per-file memory allocation,
+ * so it is better suited for archives containing many small files.
+ *
+ * Usage example:
+ * @code{.cpp}
+ * BitMemoryArena arena;
+ * archive.extractTo( arena );
+ * const auto* entry = arena.find( "config/settings.ini" );
+ * if ( entry != nullptr ) {
+ *     // ...use the entry->size bytes starting from arena.content( *entry )...
+ * }
+ * @endcode
+ */
+class BitMemoryArena final {
+    public:
+        /**
+         * @brief A file stored in the arena.
+         */
+        struct Entry {
+            std::size_t pathOffset; ///< The offset of the file's path in the arena's paths storage.
+            std::size_t pathSize;   ///< The length of the file's path.
+            std::size_t offset;     ///< The offset of the file's content in the arena's buffer.
+            std::size_t size;       ///< The size (in bytes) of the file's content.
+        };
+
+        /**
+         * @brief Searches the file with the given path in the arena (O(log n)).
+         *
+         * @param path  the path of the file (inside the archive).
+         *
+         * @return a pointer to the entry of the file, or nullptr if the arena does not contain the file.
+         */
+        BIT7Z_NODISCARD auto find( const tstring& path ) const noexcept -> const Entry*;
+
+        /**
+         * @param path  the path of the file (inside the archive).
+         *
+         * @return a boolean value indicating whether the arena contains the file with the given path.
+         */
+        BIT7Z_NODISCARD auto contains( const tstring& path ) const noexcept -> bool;
+
+        /**
+         * @param entry the entry of a file stored in the arena.
+         *
+         * @return a pointer to the first byte of the content of the file.
+         */
+        BIT7Z_NODISCARD auto content( const Entry& entry ) const noexcept -> const byte_t*;
+
+        /**
+         * @param entry the entry of a file stored in the arena.
+         *
+         * @return the path of the file (inside the archive).
+         */
+        BIT7Z_NODISCARD auto path( const Entry& entry ) const -> tstring;
+
+        /**
+         * @return the entries of the files stored in the arena, sorted by path.
+         */
+        BIT7Z_NODISCARD auto entries() const noexcept -> const std::vector< Entry >&;
+
+        /**
+         * @return the buffer containing the contents of all the files stored in the arena.
+         */
+        BIT7Z_NODISCARD auto buffer() const noexcept -> const buffer_t&;
+
+        /**
+         * @return the number of files stored in the arena.
+         */
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+        /**
+         * @return a boolean value indicating whether the arena contains no files.
+         */
+        BIT7Z_NODISCARD auto empty() const noexcept -> bool;
+
+        /**
+         * @brief Removes all the files from the arena (the allocated memory is kept for reuse).
+         */
+        void clear() noexcept;
+
+    private:
+        buffer_t mBuffer;
+        tstring mPaths;
+        std::vector< Entry > mEntries;
+
+        friend class ArenaExtractCallback;
+};
+
+}  // namespace bit7z
+
+#endif // BITMEMORYARENA_HPP
@@ -20,6 +20,7 @@
 
 //! @cond IGNORE_BLOCK_IN_DOXYGEN
 struct ISequentialInStream;
+struct ISequentialOutStream;
 
 template< typename T >
 class CMyComPtr;
@@ -249,6 +250,10 @@ class BitOutputArchive {
         /**
          * @brief Compresses all the items added to this object to the specified buffer.
          *
+         * If the output stream is not seekable (e.g., it writes to a pipe or a socket), the archive is written
+         * forward-only: this is supported only by the formats not needing to seek back in the output archive
+         * (e.g., Tar, GZip, BZip2, and Xz).
+         *
          * @param outStream the output standard stream.
          */
         void compressTo( std::ostream& outStream );
@@ -354,9 +359,15 @@ class BitOutputArchive {
                           const fs::path& inArc,
                           ArchiveStartOffset archiveStart );
 
+        void compressToVolumes( const fs::path& outFile, UpdateCallback* updateCallback );
+
         void compressToFile( const fs::path& outFile, UpdateCallback* updateCallback );
 
-        void compressOut( IOutArchive* outArc, IOutStream* outStream, UpdateCallback* updateCallback );
+        void compressOut( IOutArchive* outArc, ISequentialOutStream* outStream, UpdateCallback* updateCallback );
+
+        BIT7Z_NODISCARD auto isItemUnchanged( uint32_t oldIndex,
+                                              const GenericInputItem& newItem,
+                                              uint64_t timePrecision ) const -> bool;
 
         void setArchiveProperties( IOutArchive* outArchive ) const;
 
@@ -17,6 +17,8 @@
 #include "internal/guids.hpp"
 #include "internal/stringutil.hpp"
 
+#include <new>
+
 #include <7zip/Archive/IArchive.h>
 
 #ifdef _WIN32
@@ -33,7 +35,8 @@
 
 using namespace bit7z;
 
-Bit7zLibrary::Bit7zLibrary( const tstring& libraryPath ) : mLibrary( Bit7zLoadLibrary( libraryPath ) ) {
+Bit7zLibrary::Bit7zLibrary( const tstring& libraryPath )
+    : mLibrary( Bit7zLoadLibrary( libraryPath ) ), mCreateObjectFunc( nullptr ), mHandlerPoolSize( 0 ) {
     if ( mLibrary == nullptr ) {
         const auto error = ERROR_CODE( std::errc::bad_file_descriptor );
         throw BitException( "Failed to load the 7-zip library", error );
@@ -49,6 +52,8 @@ Bit7zLibrary::Bit7zLibrary( const tstring& libraryPath ) : mLibrary( Bit7zLoadLi
 }
 
 Bit7zLibrary::~Bit7zLibrary() {
+    // Note: the pooled handlers must be released before unloading the library containing their code.
+    clearHandlerPool();
     FreeLibrary( mLibrary );
 }
 
@@ -67,6 +72,35 @@ void Bit7zLibrary::setLargePageMode() {
     }
 }
 
+auto Bit7zLibrary::handlerPoolSize() const noexcept -> std::size_t {
+    const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+    return mHandlerPoolSize;
+}
+
+template< typename T >
+void release_pooled_handlers( std::map< unsigned char, std::vector< T* > >& pool, std::size_t poolSize ) noexcept {
+    for ( auto& formatHandlers : pool ) {
+        auto& handlers = formatHandlers.second;
+        while ( handlers.size() > poolSize ) {
+            handlers.back()->Release();
+            handlers.pop_back();
+        }
+    }
+}
+
+void Bit7zLibrary::setHandlerPoolSize( std::size_t poolSize ) {
+    const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+    mHandlerPoolSize = poolSize;
+    release_pooled_handlers( mInArchivePool, poolSize );
+    release_pooled_handlers( mOutArchivePool, poolSize );
+}
+
+void Bit7zLibrary::clearHandlerPool() noexcept {
+    const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+    release_pooled_handlers( mInArchivePool, 0 );
+    release_pooled_handlers( mOutArchivePool, 0 );
+}
+
 using CreateObjectFunc = HRESULT ( WINAPI* )( const GUID* clsID, const GUID* interfaceID, void** out );
 
 // Making the code not build when choosing a wrong interface type (only IInArchive and IOutArchive are supported!).
@@ -94,9 +128,48 @@ auto create_archive_object( FARPROC creatorFunction, const BitInFormat& format,
     return createObject( &formatID, &interface_id< T >(), reinterpret_cast< void** >( object ) );
 }
 
+// Note: the returned handler (if any) is owned by the caller, i.e., its reference is moved out of the pool.
+template< typename T >
+auto pop_pooled_handler( std::map< unsigned char, std::vector< T* > >& pool, const BitInFormat& format ) -> T* {
+    auto formatHandlers = pool.find( format.value() );
+    if ( formatHandlers == pool.end() || formatHandlers->second.empty() ) {
+        return nullptr;
+    }
+    T* handler = formatHandlers->second.back();
+    formatHandlers->second.pop_back();
+    return handler;
+}
+
+// Note: the pool takes its own reference to the handler, so the caller must still release its reference.
+template< typename T >
+auto push_pooled_handler( std::map< unsigned char, std::vector< T* > >& pool,
+                          const BitInFormat& format,
+                          T* handler,
+                          std::size_t poolSize ) noexcept -> bool {
+    try {
+        auto& handlers = pool[ format.value() ];
+        if ( handlers.size() >= poolSize ) {
+            return false;
+        }
+        handlers.push_back( handler );
+    } catch ( const std::bad_alloc& ) {
+        return false;
+    }
+    handler->AddRef();
+    return true;
+}
+
 BIT7Z_NODISCARD
 auto Bit7zLibrary::initInArchive( const BitInFormat& format ) const -> CMyComPtr< IInArchive > {
     CMyComPtr< IInArchive > inArchive{};
+    {
+        const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+        IInArchive* pooledArchive = pop_pooled_handler( mInArchivePool, format );
+        if ( pooledArchive != nullptr ) {
+            inArchive.Attach( pooledArchive );
+            return inArchive;
+        }
+    }
     const HRESULT res = create_archive_object( mCreateObjectFunc, format, &inArchive );
     if ( res != S_OK || inArchive == nullptr ) {
         throw BitException( "Failed to initialize the input archive object", make_hresult_code( res ) );
@@ -107,9 +180,35 @@ auto Bit7zLibrary::initInArchive( const BitInFormat& format ) const -> CMyComPtr
 BIT7Z_NODISCARD
 auto Bit7zLibrary::initOutArchive( const BitInOutFormat& format ) const -> CMyComPtr< IOutArchive > {
     CMyComPtr< IOutArchive > outArchive{};
+    {
+        const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+        IOutArchive* pooledArchive = pop_pooled_handler( mOutArchivePool, format );
+        outArchive.Attach( pooledArchive );
+    }
+    if ( outArchive != nullptr ) {
+        // Resetting the properties set by the previous user of the reused archive object to the default values.
+        CMyComPtr< ISetProperties > setProperties;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const HRESULT res = outArchive->QueryInterface( bit7z::IID_ISetProperties,
+                                                        reinterpret_cast< void** >( &setProperties ) );
+        if ( res != S_OK || setProperties->SetProperties( nullptr, nullptr, 0 ) == S_OK ) {
+            return outArchive;
+        }
+        outArchive.Release();
+    }
     const HRESULT res = create_archive_object( mCreateObjectFunc, format, &outArchive );
     if ( res != S_OK || outArchive == nullptr ) {
         throw BitException( "Failed to initialize the output archive object", make_hresult_code( res ) );
     }
     return outArchive;
 }
+
+void Bit7zLibrary::recycleInArchive( const BitInFormat& format, IInArchive* inArchive ) const noexcept {
+    const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+    (void)push_pooled_handler( mInArchivePool, format, inArchive, mHandlerPoolSize );
+}
+
+void Bit7zLibrary::recycleOutArchive( const BitInOutFormat& format, IOutArchive* outArchive ) const noexcept {
+    const std::lock_guard< std::mutex > lock{ mHandlerPoolMutex };
+    (void)push_pooled_handler( mOutArchivePool, format, outArchive, mHandlerPoolSize );
+}
@@ -117,6 +117,7 @@ BitAbstractArchiveCreator::BitAbstractArchiveCreator( const Bit7zLibrary& lib,
     : BitAbstractArchiveHandler( lib, std::move( password ) ),
       mFormat( format ),
       mUpdateMode( updateMode ),
+      mFreshenChecksCrc( false ),
       mCompressionLevel( BitCompressionLevel::Normal ),
       mCompressionMethod( format.defaultMethod() ),
       mDictionarySize( 0 ),
@@ -165,10 +166,18 @@ auto BitAbstractArchiveCreator::updateMode() const noexcept -> UpdateMode {
     return mUpdateMode;
 }
 
+auto BitAbstractArchiveCreator::freshenChecksCrc() const noexcept -> bool {
+    return mFreshenChecksCrc;
+}
+
 auto BitAbstractArchiveCreator::volumeSize() const noexcept -> uint64_t {
     return mVolumeSize;
 }
 
+auto BitAbstractArchiveCreator::volumeCallback() const -> VolumeCallback {
+    return mVolumeCallback;
+}
+
 auto BitAbstractArchiveCreator::threadsCount() const noexcept -> uint32_t {
     return mThreadsCount;
 }
@@ -259,10 +268,18 @@ void BitAbstractArchiveCreator::setUpdateMode( bool canUpdate ) {
     setUpdateMode( canUpdate ? UpdateMode::Append : UpdateMode::None );
 }
 
+void BitAbstractArchiveCreator::setFreshenChecksCrc( bool checkCrc ) noexcept {
+    mFreshenChecksCrc = checkCrc;
+}
+
 void BitAbstractArchiveCreator::setVolumeSize( uint64_t volumeSize ) noexcept {
     mVolumeSize = volumeSize;
 }
 
+void BitAbstractArchiveCreator::setVolumeCallback( const VolumeCallback& callback ) {
+    mVolumeCallback = callback;
+}
+
 void BitAbstractArchiveCreator::setThreadsCount( uint32_t threadsCount ) noexcept {
     mThreadsCount = threadsCount;
 }
@@ -12,15 +12,28 @@
 
 #include "bitabstractarchivehandler.hpp"
 
+#include <algorithm>
+
 using namespace bit7z;
 
+constexpr std::size_t BitAbstractArchiveHandler::kDefaultReadAheadBlocks;
+
+constexpr std::size_t BitAbstractArchiveHandler::kDefaultMaxOpenVolumes;
+
 BitAbstractArchiveHandler::BitAbstractArchiveHandler( const Bit7zLibrary& lib,
                                                       tstring password,
                                                       OverwriteMode overwriteMode )
     : mLibrary{ lib },
       mPassword{ std::move( password ) },
       mRetainDirectories{ true },
-      mOverwriteMode{ overwriteMode } {}
+      mOverwriteMode{ overwriteMode },
+      mFileAccessMode{ FileAccessMode::Stream },
+      mPreallocateFiles{ false },
+      mSparseFiles{ false },
+      mWriteBehind{ false },
+      mReadAheadBlockSize{ 0 },
+      mReadAheadBlocks{ kDefaultReadAheadBlocks },
+      mMaxOpenVolumes{ kDefaultMaxOpenVolumes } {}
 
 auto BitAbstractArchiveHandler::library() const noexcept -> const Bit7zLibrary& {
     return mLibrary;
@@ -62,6 +75,38 @@ auto BitAbstractArchiveHandler::overwriteMode() const -> OverwriteMode {
     return mOverwriteMode;
 }
 
+auto BitAbstractArchiveHandler::fileAccessMode() const noexcept -> FileAccessMode {
+    return mFileAccessMode;
+}
+
+auto BitAbstractArchiveHandler::preallocateFiles() const noexcept -> bool {
+    return mPreallocateFiles;
+}
+
+auto BitAbstractArchiveHandler::sparseFiles() const noexcept -> bool {
+    return mSparseFiles;
+}
+
+auto BitAbstractArchiveHandler::writeBehind() const noexcept -> bool {
+    return mWriteBehind;
+}
+
+auto BitAbstractArchiveHandler::readAheadBlockSize() const noexcept -> std::size_t {
+    return mReadAheadBlockSize;
+}
+
+auto BitAbstractArchiveHandler::readAheadBlocks() const noexcept -> std::size_t {
+    return mReadAheadBlocks;
+}
+
+auto BitAbstractArchiveHandler::maxOpenVolumes() const noexcept -> std::size_t {
+    return mMaxOpenVolumes;
+}
+
+auto BitAbstractArchiveHandler::extractionThreads() const noexcept -> uint32_t {
+    return 1;
+}
+
 void BitAbstractArchiveHandler::setPassword( const tstring& password ) {
     mPassword = password;
 }
@@ -97,3 +142,28 @@ void BitAbstractArchiveHandler::setPasswordCallback( const PasswordCallback& cal
 void BitAbstractArchiveHandler::setOverwriteMode( OverwriteMode mode ) {
     mOverwriteMode = mode;
 }
+
+void BitAbstractArchiveHandler::setFileAccessMode( FileAccessMode mode ) noexcept {
+    mFileAccessMode = mode;
+}
+
+void BitAbstractArchiveHandler::setPreallocateFiles( bool preallocate ) noexcept {
+    mPreallocateFiles = preallocate;
+}
+
+void BitAbstractArchiveHandler::setSparseFiles( bool sparse ) noexcept {
+    mSparseFiles = sparse;
+}
+
+void BitAbstractArchiveHandler::setWriteBehind( bool writeBehind ) noexcept {
+    mWriteBehind = writeBehind;
+}
+
+void BitAbstractArchiveHandler::setReadAhead( std::size_t blockSize, std::size_t blocksCount ) noexcept {
+    mReadAheadBlockSize = blockSize;
+    mReadAheadBlocks = std::max< std::size_t >( blocksCount, 1 );
+}
+
+void BitAbstractArchiveHandler::setMaxOpenVolumes( std::size_t maxOpenVolumes ) noexcept {
+    mMaxOpenVolumes = std::max< std::size_t >( maxOpenVolumes, 1 );
+}
@@ -17,7 +17,9 @@ using namespace bit7z;
 BitAbstractArchiveOpener::BitAbstractArchiveOpener( const Bit7zLibrary& lib,
                                                     const BitInFormat& format,
                                                     const tstring& password )
-    : BitAbstractArchiveHandler{ lib, password, OverwriteMode::Overwrite }, mFormat{ format } {}
+    : BitAbstractArchiveHandler{ lib, password, OverwriteMode::Overwrite },
+      mFormat{ format },
+      mExtractionThreads{ 1 } {}
 
 auto BitAbstractArchiveOpener::format() const noexcept -> const BitInFormat& {
     return mFormat;
@@ -26,3 +28,11 @@ auto BitAbstractArchiveOpener::format() const noexcept -> const BitInFormat& {
 auto BitAbstractArchiveOpener::extractionFormat() const noexcept -> const BitInFormat& {
     return mFormat;
 }
+
+auto BitAbstractArchiveOpener::extractionThreads() const noexcept -> uint32_t {
+    return mExtractionThreads;
+}
+
+void BitAbstractArchiveOpener::setExtractionThreads( uint32_t threadsCount ) noexcept {
+    mExtractionThreads = threadsCount;
+}
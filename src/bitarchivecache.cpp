@@ -0,0 +1,202 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitarchivecache.hpp"
+
+#include "bitexception.hpp"
+#include "internal/fsutil.hpp"
+#include "internal/stringutil.hpp"
+
+namespace bit7z {
+
+constexpr std::size_t BitArchiveCache::kDefaultMaxArchives;
+
+BitArchiveCache::BitArchiveCache( const Bit7zLibrary& lib, const BitInFormat& format, const tstring& password )
+    : mLibrary{ lib },
+      mFormat{ format },
+      mPassword{ password },
+      mMaxArchives{ kDefaultMaxArchives },
+      mMaxItems{ 0 },
+      mCachedItems{ 0 },
+      mStatistics{ 0, 0, 0, std::chrono::nanoseconds::zero() } {}
+
+auto BitArchiveCache::checkout( const tstring& inArchive ) -> Handle {
+    const fs::path archivePath = tstring_to_path( inArchive );
+    std::error_code error;
+    const std::uint64_t archiveSize = fs::file_size( archivePath, error );
+    if ( error ) {
+        throw BitException( "Failed to get the size of the archive", error, inArchive );
+    }
+    const auto writeTime = static_cast< std::int64_t >( fs::last_write_time( archivePath, error ).time_since_epoch()
+                                                                                                  .count() );
+    if ( error ) {
+        throw BitException( "Failed to get the last write time of the archive", error, inArchive );
+    }
+
+    std::list< Entry > erased; // Note: declared before the lock, so that the archives are closed after releasing it.
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        auto indexedEntries = mEntriesIndex.equal_range( inArchive );
+        for ( auto indexedEntry = indexedEntries.first; indexedEntry != indexedEntries.second; ) {
+            const auto entry = ( indexedEntry++ )->second;
+            if ( entry->inUse ) {
+                continue;
+            }
+            if ( entry->size != archiveSize || entry->writeTime != writeTime ) {
+                // The archive file was changed since it was opened, so the cached instance is stale.
+                erase( entry, erased );
+                continue;
+            }
+            entry->inUse = true;
+            mEntries.splice( mEntries.begin(), mEntries, entry );
+            ++mStatistics.hits;
+            return Handle{ *this, entry };
+        }
+        ++mStatistics.misses;
+    }
+
+    // Note: opening the archive is the slow operation we want to avoid, so we do it without holding the lock.
+    const auto openStart = std::chrono::steady_clock::now();
+    std::unique_ptr< BitArchiveReader > reader{ new BitArchiveReader( mLibrary, inArchive, mFormat, mPassword ) };
+    const auto openTime = std::chrono::steady_clock::now() - openStart;
+    const auto itemsCount = reader->itemsCount();
+
+    std::list< Entry > evicted;
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mStatistics.openTime += std::chrono::duration_cast< std::chrono::nanoseconds >( openTime );
+    mEntries.push_front( Entry{ inArchive, archiveSize, writeTime, itemsCount, true, std::move( reader ) } );
+    const auto entry = mEntries.begin();
+    mEntriesIndex.emplace( inArchive, entry );
+    mCachedItems += itemsCount;
+    evict( evicted );
+    return Handle{ *this, entry };
+}
+
+auto BitArchiveCache::maxArchives() const -> std::size_t {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    return mMaxArchives;
+}
+
+void BitArchiveCache::setMaxArchives( std::size_t maxArchives ) {
+    std::list< Entry > evicted;
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mMaxArchives = maxArchives;
+    evict( evicted );
+}
+
+auto BitArchiveCache::maxItems() const -> std::size_t {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    return mMaxItems;
+}
+
+void BitArchiveCache::setMaxItems( std::size_t maxItems ) {
+    std::list< Entry > evicted;
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mMaxItems = maxItems;
+    evict( evicted );
+}
+
+auto BitArchiveCache::size() const -> std::size_t {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    return mEntries.size();
+}
+
+auto BitArchiveCache::statistics() const -> Statistics {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    return mStatistics;
+}
+
+void BitArchiveCache::clear() {
+    std::list< Entry > erased;
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    for ( auto entry = mEntries.begin(); entry != mEntries.end(); ) {
+        const auto current = entry++;
+        if ( !current->inUse ) {
+            erase( current, erased );
+        }
+    }
+}
+
+void BitArchiveCache::release( EntryIterator entry ) noexcept {
+    std::list< Entry > evicted;
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    entry->inUse = false;
+    mEntries.splice( mEntries.begin(), mEntries, entry );
+    evict( evicted );
+}
+
+// Note: must be called with the lock held.
+void BitArchiveCache::erase( EntryIterator entry, std::list< Entry >& erased ) {
+    auto indexedEntries = mEntriesIndex.equal_range( entry->path );
+    for ( auto indexedEntry = indexedEntries.first; indexedEntry != indexedEntries.second; ++indexedEntry ) {
+        if ( indexedEntry->second == entry ) {
+            mEntriesIndex.erase( indexedEntry );
+            break;
+        }
+    }
+    mCachedItems -= entry->itemsCount;
+    erased.splice( erased.end(), mEntries, entry );
+}
+
+// Note: must be called with the lock held.
+void BitArchiveCache::evict( std::list< Entry >& evicted ) {
+    const auto isFull = [this]() -> bool {
+        return mEntries.size() > mMaxArchives || ( mMaxItems > 0 && mCachedItems > mMaxItems );
+    };
+    // Closing the least recently used archives first.
+    auto entry = mEntries.end();
+    while ( isFull() && entry != mEntries.begin() ) {
+        --entry;
+        if ( entry->inUse ) {
+            continue;
+        }
+        const auto evictedEntry = entry++;
+        erase( evictedEntry, evicted );
+        ++mStatistics.evictions;
+    }
+}
+
+BitArchiveCache::Handle::Handle( BitArchiveCache& cache, EntryIterator entry ) noexcept
+    : mCache{ &cache }, mEntry{ entry } {}
+
+BitArchiveCache::Handle::Handle( Handle&& other ) noexcept
+    : mCache{ other.mCache }, mEntry{ other.mEntry } {
+    other.mCache = nullptr;
+}
+
+auto BitArchiveCache::Handle::operator=( Handle&& other ) noexcept -> Handle& {
+    if ( this != &other ) {
+        if ( mCache != nullptr ) {
+            mCache->release( mEntry );
+        }
+        mCache = other.mCache;
+        mEntry = other.mEntry;
+        other.mCache = nullptr;
+    }
+    return *this;
+}
+
+BitArchiveCache::Handle::~Handle() {
+    if ( mCache != nullptr ) {
+        mCache->release( mEntry );
+    }
+}
+
+auto BitArchiveCache::Handle::operator*() const noexcept -> const BitArchiveReader& {
+    return *mEntry->reader;
+}
+
+auto BitArchiveCache::Handle::operator->() const noexcept -> const BitArchiveReader* {
+    return mEntry->reader.get();
+}
+
+} // namespace bit7z
@@ -11,21 +11,39 @@
  */
 
 #include "bitarchiveiteminfo.hpp"
+#include "bititemtable.hpp"
 
 using bit7z::BitArchiveItemInfo;
+using bit7z::BitItemTable;
 using bit7z::BitProperty;
 using bit7z::BitPropVariant;
 using std::map;
 
 BitArchiveItemInfo::BitArchiveItemInfo( uint32_t itemIndex ) : BitArchiveItem( itemIndex ) {}
 
+BitArchiveItemInfo::BitArchiveItemInfo( uint32_t itemIndex, std::shared_ptr< const BitItemTable > itemTable )
+    : BitArchiveItem( itemIndex ), mItemTable{ std::move( itemTable ) } {}
+
 auto BitArchiveItemInfo::itemProperty( BitProperty property ) const -> BitPropVariant {
+    if ( mItemTable ) {
+        return mItemTable->hasProperty( property ) ? mItemTable->itemProperty( index(), property ) : BitPropVariant();
+    }
     const auto propIt = mItemProperties.find( property );
     return ( propIt != mItemProperties.end() ? ( *propIt ).second : BitPropVariant() );
 }
 
 auto BitArchiveItemInfo::itemProperties() const -> map< BitProperty, BitPropVariant > {
-    return mItemProperties;
+    if ( !mItemTable ) {
+        return mItemProperties;
+    }
+    map< BitProperty, BitPropVariant > itemProperties;
+    for ( const auto property : mItemTable->properties() ) {
+        auto propertyValue = mItemTable->itemProperty( index(), property );
+        if ( !propertyValue.isEmpty() ) {
+            itemProperties.emplace( property, std::move( propertyValue ) );
+        }
+    }
+    return itemProperties;
 }
 
 void BitArchiveItemInfo::setProperty( BitProperty property, const BitPropVariant& value ) {
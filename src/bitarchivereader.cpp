@@ -14,8 +14,10 @@
 #include <numeric>
 
 #include "bitarchivereader.hpp"
+#include "internal/fsutil.hpp"
 #include "internal/operationresult.hpp"
 #include "internal/stringutil.hpp"
+#include "internal/util.hpp"
 
 using namespace bit7z;
 
@@ -72,21 +74,14 @@ auto BitArchiveReader::archiveProperties() const -> map< BitProperty, BitPropVar
 }
 
 auto BitArchiveReader::items() const -> std::vector< BitArchiveItemInfo > {
-    const auto count = itemsCount();
+    // All the items share a single columnar snapshot of their properties.
+    const auto table = fullItemTable();
+    const auto count = table->itemsCount();
 
     std::vector< BitArchiveItemInfo > result;
     result.reserve( count );
     for ( uint32_t i = 0; i < count; ++i ) {
-        BitArchiveItemInfo item( i );
-        for ( uint32_t j = kpidNoProperty; j <= kpidCopyLink; ++j ) {
-            // We cast property twice (here and in archiveProperty), to make the code is easier to read.
-            const auto property = static_cast< BitProperty >( j );
-            const auto propertyValue = itemProperty( i, property );
-            if ( !propertyValue.isEmpty() ) {
-                item.setProperty( property, propertyValue );
-            }
-        }
-        result.emplace_back( std::move( item ) );
+        result.emplace_back( BitArchiveItemInfo( i, table ) );
     }
     return result;
 }
@@ -145,18 +140,8 @@ auto BitArchiveReader::isSolid() const -> bool {
 
 auto BitArchiveReader::volumesCount() const -> std::uint32_t {
     if ( extractionFormat() != BitFormat::Split && ends_with( archivePath(), BIT7Z_STRING( ".001" ) ) ) {
-        constexpr size_t kVolumeDigits = 3u;
-
-        std::uint32_t result = 2u;
-        fs::path volumePath = tstring_to_path( archivePath() );
-        do {
-            tstring volumeExt = to_tstring( result++ );
-            if ( volumeExt.length() < kVolumeDigits ) {
-                volumeExt.insert( volumeExt.begin(), kVolumeDigits - volumeExt.length(), BIT7Z_STRING( '0' ) );
-            }
-            volumePath.replace_extension( volumeExt );
-        } while ( fs::exists( volumePath ) );
-        return result - 2;
+        const auto volumes = filesystem::fsutil::find_volumes( tstring_to_path( archivePath() ) );
+        return std::max< std::uint32_t >( clamp_cast< std::uint32_t >( volumes.size() ), 1 );
     }
 
     const BitPropVariant volumesCount = archiveProperty( BitProperty::NumVolumes );
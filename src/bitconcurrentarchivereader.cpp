@@ -0,0 +1,167 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitconcurrentarchivereader.hpp"
+
+#include <algorithm>
+
+namespace bit7z {
+
+BitConcurrentArchiveReader::BitConcurrentArchiveReader( const Bit7zLibrary& lib,
+                                                        const tstring& inArchive,
+                                                        std::size_t maxShards,
+                                                        const BitInFormat& format,
+                                                        const tstring& password )
+    : BitConcurrentArchiveReader( lib, inArchive, nullptr, maxShards, format, password ) {}
+
+BitConcurrentArchiveReader::BitConcurrentArchiveReader( const Bit7zLibrary& lib,
+                                                        const buffer_t& inArchive,
+                                                        std::size_t maxShards,
+                                                        const BitInFormat& format,
+                                                        const tstring& password )
+    : BitConcurrentArchiveReader( lib, tstring{}, &inArchive, maxShards, format, password ) {}
+
+BitConcurrentArchiveReader::BitConcurrentArchiveReader( const Bit7zLibrary& lib,
+                                                        tstring inArchivePath,
+                                                        const buffer_t* inArchiveBuffer,
+                                                        std::size_t maxShards,
+                                                        const BitInFormat& format,
+                                                        const tstring& password )
+    : mLibrary{ lib },
+      mArchivePath{ std::move( inArchivePath ) },
+      mArchiveBuffer{ inArchiveBuffer },
+      mFormat{ format },
+      mPassword{ password },
+      mMaxShards{ std::max< std::size_t >( maxShards, 1 ) },
+      mOpeningShards{ 0 },
+      mWaits{ 0 } {
+    // Opening the first shard immediately, so that invalid archives are reported by the constructor.
+    mShards.push_back( openShard() );
+}
+
+auto BitConcurrentArchiveReader::itemsCount() const -> uint32_t {
+    return use( []( const BitArchiveReader& reader ) -> uint32_t {
+        return reader.itemsCount();
+    } );
+}
+
+void BitConcurrentArchiveReader::extractTo( std::vector< byte_t >& outBuffer, uint32_t index ) const {
+    use( [ &outBuffer, index ]( const BitArchiveReader& reader ) {
+        reader.extractTo( outBuffer, index );
+    } );
+}
+
+void BitConcurrentArchiveReader::extractTo( byte_t* buffer, std::size_t size, uint32_t index ) const {
+    use( [ buffer, size, index ]( const BitArchiveReader& reader ) {
+        reader.extractTo( buffer, size, index );
+    } );
+}
+
+void BitConcurrentArchiveReader::extractTo( std::ostream& outStream, uint32_t index ) const {
+    use( [ &outStream, index ]( const BitArchiveReader& reader ) {
+        reader.extractTo( outStream, index );
+    } );
+}
+
+auto BitConcurrentArchiveReader::maxShards() const noexcept -> std::size_t {
+    return mMaxShards;
+}
+
+auto BitConcurrentArchiveReader::shardsCount() const -> std::size_t {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    return mShards.size();
+}
+
+auto BitConcurrentArchiveReader::statistics() const -> Statistics {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    Statistics result{ {}, mWaits };
+    result.shards.reserve( mShards.size() );
+    for ( const auto& shard : mShards ) {
+        result.shards.push_back( ShardStatistics{ shard->requests, shard->busyTime, shard->busy } );
+    }
+    return result;
+}
+
+auto BitConcurrentArchiveReader::openShard() const -> std::unique_ptr< Shard > {
+    std::unique_ptr< BitArchiveReader > reader{
+        mArchiveBuffer != nullptr ?
+        new BitArchiveReader( mLibrary, *mArchiveBuffer, mFormat, mPassword ) :
+        new BitArchiveReader( mLibrary, mArchivePath, mFormat, mPassword )
+    };
+    return std::unique_ptr< Shard >( new Shard{ std::move( reader ), false, 0, std::chrono::nanoseconds::zero() } );
+}
+
+auto BitConcurrentArchiveReader::acquireShard() const -> Shard& {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    bool waited = false;
+    while ( true ) {
+        const auto idleShard = std::find_if( mShards.begin(), mShards.end(),
+                                             []( const std::unique_ptr< Shard >& shard ) -> bool {
+                                                 return !shard->busy;
+                                             } );
+        if ( idleShard != mShards.end() ) {
+            ( *idleShard )->busy = true;
+            ++( *idleShard )->requests;
+            return **idleShard;
+        }
+
+        if ( mShards.size() + mOpeningShards < mMaxShards ) {
+            // All the shards are busy, but we can open a new one (without holding the lock, as it is slow).
+            ++mOpeningShards;
+            lock.unlock();
+            std::unique_ptr< Shard > newShard;
+            try {
+                newShard = openShard();
+            } catch ( ... ) {
+                lock.lock();
+                --mOpeningShards;
+                mShardReleased.notify_one();
+                throw;
+            }
+            lock.lock();
+            --mOpeningShards;
+            newShard->busy = true;
+            ++newShard->requests;
+            mShards.push_back( std::move( newShard ) );
+            return *mShards.back();
+        }
+
+        if ( !waited ) {
+            waited = true;
+            ++mWaits;
+        }
+        mShardReleased.wait( lock );
+    }
+}
+
+void BitConcurrentArchiveReader::releaseShard( Shard& shard, std::chrono::nanoseconds busyTime ) const noexcept {
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        shard.busy = false;
+        shard.busyTime += busyTime;
+    }
+    mShardReleased.notify_one();
+}
+
+BitConcurrentArchiveReader::ShardLease::ShardLease( const BitConcurrentArchiveReader& owner )
+    : mOwner{ owner }, mShard{ owner.acquireShard() }, mStart{ std::chrono::steady_clock::now() } {}
+
+BitConcurrentArchiveReader::ShardLease::~ShardLease() {
+    const auto busyTime = std::chrono::steady_clock::now() - mStart;
+    mOwner.releaseShard( mShard, std::chrono::duration_cast< std::chrono::nanoseconds >( busyTime ) );
+}
+
+auto BitConcurrentArchiveReader::ShardLease::reader() const noexcept -> const BitArchiveReader& {
+    return *mShard.reader;
+}
+
+} // namespace bit7z
@@ -0,0 +1,45 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitextractionbatch.hpp"
+
+namespace bit7z {
+
+void BitExtractionBatch::add( uint32_t index, std::vector< byte_t >& outBuffer ) {
+    mRequests.push_back( Request{ index, Destination::Buffer, &outBuffer, nullptr, {} } );
+}
+
+void BitExtractionBatch::add( uint32_t index, std::ostream& outStream ) {
+    mRequests.push_back( Request{ index, Destination::Stream, nullptr, &outStream, {} } );
+}
+
+void BitExtractionBatch::add( uint32_t index, const tstring& outFile ) {
+    mRequests.push_back( Request{ index, Destination::File, nullptr, nullptr, outFile } );
+}
+
+auto BitExtractionBatch::requests() const noexcept -> const std::vector< Request >& {
+    return mRequests;
+}
+
+auto BitExtractionBatch::size() const noexcept -> std::size_t {
+    return mRequests.size();
+}
+
+auto BitExtractionBatch::empty() const noexcept -> bool {
+    return mRequests.empty();
+}
+
+void BitExtractionBatch::clear() noexcept {
+    mRequests.clear();
+}
+
+} // namespace bit7z
@@ -11,6 +11,7 @@
  */
 
 #include "bitformat.hpp"
+#include "internal/formatdetect.hpp"
 
 using namespace std;
 
@@ -128,5 +129,19 @@ auto BitInOutFormat::defaultMethod() const noexcept -> BitCompressionMethod {
     return mDefaultMethod;
 }
 
+#ifdef BIT7Z_AUTO_FORMAT
+auto detectFormat( const byte_t* data, std::size_t size ) noexcept -> const BitInFormat& {
+    if ( data == nullptr ) {
+        return BitFormat::Auto;
+    }
+    const BitInFormat* format = find_format_by_signature( data, size );
+    return format != nullptr ? *format : BitFormat::Auto;
+}
+
+auto detectFormat( const buffer_t& buffer ) noexcept -> const BitInFormat& {
+    return detectFormat( buffer.data(), buffer.size() );
+}
+#endif
+
 }  // namespace bit7z
 
@@ -18,14 +18,23 @@
 
 #include "biterror.hpp"
 #include "bitexception.hpp"
+#include "internal/arenaextractcallback.hpp"
+#include "internal/batchextractcallback.hpp"
 #include "internal/bufferextractcallback.hpp"
 #include "internal/cbufferinstream.hpp"
 #include "internal/cfileinstream.hpp"
+#include "internal/cfilemapinstream.hpp"
 #include "internal/cmultivolumeinstream.hpp"
+#include "internal/creadaheadinstream.hpp"
+#include "internal/cstdinstream.hpp"
+#include "internal/cstdsequentialinstream.hpp"
 #include "internal/fileextractcallback.hpp"
 #include "internal/fixedbufferextractcallback.hpp"
+#include "internal/itempathindex.hpp"
 #include "internal/streamextractcallback.hpp"
 #include "internal/opencallback.hpp"
+#include "internal/sinkextractcallback.hpp"
+#include "internal/streamutil.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/util.hpp"
 
@@ -34,6 +43,10 @@
 #endif
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <thread>
 
 using namespace NWindows;
 using namespace NArchive;
@@ -43,7 +56,7 @@ namespace bit7z {
 void extract_arc( IInArchive* inArchive,
                   const std::vector< uint32_t >& indices,
                   ExtractCallback* extractCallback,
-                  ExtractMode mode = ExtractMode::Extract ) {
+                  ExtractMode mode ) {
     const uint32_t* itemIndices = indices.empty() ? nullptr : indices.data();
     const uint32_t numItems = indices.empty() ?
                               std::numeric_limits< uint32_t >::max() : static_cast< uint32_t >( indices.size() );
@@ -100,12 +113,14 @@ auto BitInputArchive::openArchiveStream( const fs::path& name,
          * NOTE 2: If signature detection was already performed (detectedBySignature == false), it detected
          *         a wrong format, no further check can be done, and an exception must be thrown (next if). */
 
-        /* Opening the file might have changed the current file pointer, so we reset it to the beginning of the file
-         * to correctly read the file signature. */
-        inStream->Seek( 0, STREAM_SEEK_SET, nullptr );
-        mDetectedFormat = &( detect_format_from_signature( inStream ) );
-        inArchive = mArchiveHandler.library().initInArchive( *mDetectedFormat );
-        res = inArchive->Open( inStream, nullptr, openCallback );
+        const BitInFormat& signatureFormat = detect_format_from_signature( inStream );
+        if ( signatureFormat != *mDetectedFormat ) {
+            /* NOTE 3: If the signature matches the format we already tried, opening the file again would fail again,
+             *         so we open it only if a different format was detected. */
+            mDetectedFormat = &signatureFormat;
+            inArchive = mArchiveHandler.library().initInArchive( *mDetectedFormat );
+            res = inArchive->Open( inStream, nullptr, openCallback );
+        }
     }
 #endif
 
@@ -118,6 +133,41 @@ auto BitInputArchive::openArchiveStream( const fs::path& name,
     return inArchive.Detach();
 }
 
+auto BitInputArchive::openArchiveSequentialStream( ISequentialInStream* inStream ) -> IInArchive* {
+#ifdef BIT7Z_AUTO_FORMAT
+    if ( *mDetectedFormat == BitFormat::Auto ) {
+        throw BitException( "Cannot detect the format of an archive in a non-seekable stream",
+                            make_error_code( BitError::FormatFeatureNotSupported ) );
+    }
+#endif
+    CMyComPtr< IInArchive > inArchive = mArchiveHandler.library().initInArchive( *mDetectedFormat );
+
+    CMyComPtr< IArchiveOpenSeq > inArchiveSeq;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    HRESULT res = inArchive->QueryInterface( bit7z::IID_IArchiveOpenSeq, reinterpret_cast< void** >( &inArchiveSeq ) );
+    if ( res != S_OK ) {
+        throw BitException( "The archive format does not support reading from non-seekable streams",
+                            make_error_code( BitError::FormatFeatureNotSupported ) );
+    }
+
+    res = inArchiveSeq->OpenSeq( inStream );
+    if ( res != S_OK ) {
+        throw BitException( "Could not open the archive", make_hresult_code( res ) );
+    }
+    return inArchive.Detach();
+}
+
+void BitInputArchive::beginExtraction() const {
+    // Note: a non-seekable input stream is consumed by the first extraction, so it cannot be extracted again.
+    if ( mSequentialAccess ) {
+        if ( mSequentialStreamConsumed ) {
+            throw BitException( "Cannot extract an archive read from a non-seekable stream more than once",
+                                make_error_code( BitError::FormatFeatureNotSupported ) );
+        }
+        mSequentialStreamConsumed = true;
+    }
+}
+
 inline auto detect_format( const BitInFormat& format, const fs::path& arcPath ) -> const BitInFormat* {
 #if defined( BIT7Z_AUTO_FORMAT ) && defined( BIT7Z_DETECT_FROM_EXTENSION )
     return ( ( format == BitFormat::Auto ) ? &detect_format_from_extension( arcPath ) : &format );
@@ -127,6 +177,14 @@ inline auto detect_format( const BitInFormat& format, const fs::path& arcPath )
 #endif
 }
 
+// Formats whose archives are usually read from start to end, without seeking back and forth.
+inline auto is_sequential_format( const BitInFormat& format ) -> bool {
+    return format == BitFormat::Tar || format == BitFormat::GZip || format == BitFormat::BZip2 ||
+           format == BitFormat::Xz || format == BitFormat::Lzma || format == BitFormat::Lzma86 ||
+           format == BitFormat::Z || format == BitFormat::Zstd || format == BitFormat::Ppmd ||
+           format == BitFormat::Cpio;
+}
+
 BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler,
                                   const tstring& inFile,
                                   ArchiveStartOffset startOffset )
@@ -137,13 +195,26 @@ BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler,
                                   ArchiveStartOffset startOffset )
     : mDetectedFormat{ detect_format( handler.format(), arcPath ) },
       mArchiveHandler{ handler },
-      mArchivePath{ path_to_tstring( arcPath ) } {
+      mArchivePath{ path_to_tstring( arcPath ) },
+      mReusableHandler{ true },
+      mSequentialAccess{ false },
+      mSequentialStreamConsumed{ false },
+      mStartOffset{ startOffset } {
     CMyComPtr< IInStream > fileStream;
     if ( *mDetectedFormat != BitFormat::Split && arcPath.extension() == ".001" ) {
-        fileStream = bit7z::make_com< CMultiVolumeInStream, IInStream >( arcPath );
+        fileStream = bit7z::make_com< CMultiVolumeInStream, IInStream >( arcPath,
+                                                                        handler.fileAccessMode(),
+                                                                        handler.maxOpenVolumes() );
+    } else if ( handler.fileAccessMode() == FileAccessMode::MemoryMapped && can_map_file( arcPath ) ) {
+        fileStream = bit7z::make_com< CFileMapInStream, IInStream >( arcPath, is_sequential_format( *mDetectedFormat ) );
     } else {
         fileStream = bit7z::make_com< CFileInStream, IInStream >( arcPath );
     }
+    if ( handler.readAheadBlockSize() > 0 && handler.fileAccessMode() != FileAccessMode::MemoryMapped ) {
+        fileStream = bit7z::make_com< CReadAheadInStream, IInStream >( fileStream,
+                                                                      handler.readAheadBlockSize(),
+                                                                      handler.readAheadBlocks() );
+    }
     mInArchive = openArchiveStream( arcPath, fileStream, startOffset );
 }
 
@@ -151,7 +222,11 @@ BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler,
                                   const buffer_t& inBuffer,
                                   ArchiveStartOffset startOffset )
     : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
-      mArchiveHandler{ handler } {
+      mArchiveHandler{ handler },
+      mReusableHandler{ true },
+      mSequentialAccess{ false },
+      mSequentialStreamConsumed{ false },
+      mStartOffset{ startOffset } {
     auto bufStream = bit7z::make_com< CBufferInStream, IInStream >( inBuffer );
     mInArchive = openArchiveStream( fs::path{}, bufStream, startOffset );
 }
@@ -160,7 +235,16 @@ BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler,
                                   std::istream& inStream,
                                   ArchiveStartOffset startOffset )
     : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
-      mArchiveHandler{ handler } {
+      mArchiveHandler{ handler },
+      mReusableHandler{ true },
+      mSequentialAccess{ !is_seekable( inStream, std::ios_base::in ) },
+      mSequentialStreamConsumed{ false },
+      mStartOffset{ startOffset } {
+    if ( mSequentialAccess ) {
+        auto seqStream = bit7z::make_com< CStdSequentialInStream, ISequentialInStream >( inStream );
+        mInArchive = openArchiveSequentialStream( seqStream );
+        return;
+    }
     auto stdStream = bit7z::make_com< CStdInStream, IInStream >( inStream );
     mInArchive = openArchiveStream( fs::path{}, stdStream, startOffset );
 }
@@ -175,6 +259,10 @@ auto BitInputArchive::archiveProperty( BitProperty property ) const -> BitPropVa
 }
 
 auto BitInputArchive::itemProperty( uint32_t index, BitProperty property ) const -> BitPropVariant {
+    if ( mItemTable && index < mItemTable->itemsCount() && mItemTable->hasProperty( property ) ) {
+        return mItemTable->itemProperty( index, property );
+    }
+
     BitPropVariant itemProperty;
     const HRESULT res = mInArchive->GetProperty( index, static_cast<PROPID>( property ), &itemProperty );
     if ( res != S_OK ) {
@@ -195,6 +283,29 @@ auto BitInputArchive::itemProperty( uint32_t index, BitProperty property ) const
     return itemProperty;
 }
 
+auto BitInputArchive::itemTable( const std::vector< BitProperty >& properties ) const
+    -> std::shared_ptr< const BitItemTable > {
+    // Note: we cannot use std::make_shared since the constructor of BitItemTable is private.
+    mItemTable = std::shared_ptr< const BitItemTable >( new BitItemTable( *this, properties ) );
+    return mItemTable;
+}
+
+auto BitInputArchive::fullItemTable() const -> std::shared_ptr< const BitItemTable > {
+    std::vector< BitProperty > properties;
+    properties.reserve( kpidCopyLink - kpidNoProperty + 1 );
+    for ( uint32_t propertyId = kpidNoProperty; propertyId <= kpidCopyLink; ++propertyId ) {
+        properties.push_back( static_cast< BitProperty >( propertyId ) );
+    }
+
+    // Reusing the last snapshot, if it already contains all the properties.
+    if ( mItemTable && std::all_of( properties.cbegin(), properties.cend(), [ this ]( BitProperty property ) {
+        return mItemTable->hasProperty( property );
+    } ) ) {
+        return mItemTable;
+    }
+    return itemTable( properties );
+}
+
 auto BitInputArchive::itemsCount() const -> uint32_t {
     uint32_t itemsCount{};
     const HRESULT res = mInArchive->GetNumberOfItems( &itemsCount );
@@ -215,6 +326,8 @@ auto BitInputArchive::isItemEncrypted( uint32_t index ) const -> bool {
 }
 
 auto BitInputArchive::initUpdatableArchive( IOutArchive** newArc ) const -> HRESULT {
+    // The updatable archive object is the same as the input archive one, so it must not be reused by other archives.
+    mReusableHandler = false;
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
     return mInArchive->QueryInterface( bit7z::IID_IOutArchive, reinterpret_cast< void** >( newArc ) );
 }
@@ -238,6 +351,9 @@ auto BitInputArchive::handler() const noexcept -> const BitAbstractArchiveHandle
 }
 
 void BitInputArchive::useFormatProperty( const wchar_t* name, const BitPropVariant& property ) const {
+    // The format property would be kept by the archive object, so it must not be reused by other archives.
+    mReusableHandler = false;
+
     CMyComPtr< ISetProperties > setProperties;
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
     HRESULT res = mInArchive->QueryInterface( bit7z::IID_ISetProperties, reinterpret_cast< void** >( &setProperties ) );
@@ -253,11 +369,17 @@ void BitInputArchive::useFormatProperty( const wchar_t* name, const BitPropVaria
     if ( res != S_OK ) {
         throw BitException( "Cannot use the archive format property", make_hresult_code( res ) );
     }
+
+    // Keeping the property, so that it can be applied again when the archive is reopened (e.g., by other threads).
+    mFormatProperties.emplace_back( name, property );
+
+    // The format property might change the values of the item properties (e.g., the code page of the paths).
+    mItemTable.reset();
+    mPathIndex.reset();
 }
 
 void BitInputArchive::extractTo( const tstring& outDir ) const {
-    auto callback = bit7z::make_com< FileExtractCallback, ExtractCallback >( *this, outDir );
-    extract_arc( mInArchive, {}, callback );
+    extractToDirectory( outDir, {} );
 }
 
 inline auto findInvalidIndex( const std::vector< uint32_t >& indices,
@@ -275,8 +397,170 @@ void BitInputArchive::extractTo( const tstring& outDir, const std::vector< uint3
                             make_error_code( BitError::InvalidIndex ) );
     }
 
-    auto callback = bit7z::make_com< FileExtractCallback, ExtractCallback >( *this, outDir );
-    extract_arc( mInArchive, indices, callback );
+    extractToDirectory( outDir, indices );
+}
+
+inline auto is_solid_archive( const BitInputArchive& archive ) -> bool {
+    const BitPropVariant isSolid = archive.archiveProperty( BitProperty::Solid );
+    return isSolid.isBool() && isSolid.getBool();
+}
+
+inline auto item_packed_size( const BitInputArchive& archive, uint32_t index ) -> uint64_t {
+    const BitPropVariant packSize = archive.itemProperty( index, BitProperty::PackSize );
+    if ( !packSize.isEmpty() ) {
+        return packSize.getUInt64();
+    }
+    // Some formats (e.g., Tar) do not report the packed size of the items, so we use the unpacked one.
+    const BitPropVariant size = archive.itemProperty( index, BitProperty::Size );
+    return size.isEmpty() ? 0 : size.getUInt64();
+}
+
+inline auto partition_by_packed_size( const BitInputArchive& archive,
+                                      const std::vector< uint32_t >& indices,
+                                      uint32_t partitionsCount ) -> std::vector< std::vector< uint32_t > > {
+    std::vector< std::pair< uint64_t, uint32_t > > items;
+    items.reserve( indices.size() );
+    for ( const auto index : indices ) {
+        items.emplace_back( item_packed_size( archive, index ), index );
+    }
+
+    // Greedy balancing: the largest items come first, and each item goes to the least loaded partition.
+    std::sort( items.begin(), items.end(), std::greater<>{} );
+    partitionsCount = std::min( partitionsCount, static_cast< uint32_t >( items.size() ) );
+    std::vector< std::vector< uint32_t > > partitions( partitionsCount );
+    std::vector< uint64_t > partitionsLoad( partitionsCount, 0 );
+    for ( const auto& item : items ) {
+        const auto lightestLoad = std::min_element( partitionsLoad.cbegin(), partitionsLoad.cend() );
+        const auto lightest = static_cast< std::size_t >( std::distance( partitionsLoad.cbegin(), lightestLoad ) );
+        // Note: empty items (e.g., folders) still have a cost, so they are spread among the partitions too.
+        partitionsLoad[ lightest ] += std::max< uint64_t >( item.first, 1 );
+        partitions[ lightest ].push_back( item.second );
+    }
+
+    // 7-Zip requires the indices of the items to be extracted to be sorted in ascending order.
+    for ( auto& partition : partitions ) {
+        std::sort( partition.begin(), partition.end() );
+    }
+    return partitions;
+}
+
+inline void rethrow_extraction_errors( const std::vector< std::exception_ptr >& errors, const tstring& archivePath ) {
+    std::exception_ptr firstError;
+    std::size_t errorsCount = 0;
+    std::error_code firstErrorCode;
+    FailedFiles failedFiles;
+    for ( const auto& error : errors ) {
+        if ( !error ) {
+            continue;
+        }
+        if ( !firstError ) {
+            firstError = error;
+        }
+        ++errorsCount;
+        try {
+            std::rethrow_exception( error );
+        } catch ( const BitException& ex ) {
+            if ( !firstErrorCode ) {
+                firstErrorCode = ex.code();
+            }
+            if ( ex.failedFiles().empty() ) {
+                failedFiles.emplace_back( archivePath, ex.code() );
+            } else {
+                failedFiles.insert( failedFiles.end(), ex.failedFiles().cbegin(), ex.failedFiles().cend() );
+            }
+        } catch ( ... ) { // Not a bit7z error (e.g., std::bad_alloc), so we propagate it as it is.
+            throw;
+        }
+    }
+
+    if ( errorsCount == 0 ) {
+        return;
+    }
+    if ( errorsCount == 1 ) {
+        std::rethrow_exception( firstError );
+    }
+    throw BitException( "Could not extract the archive", firstErrorCode, std::move( failedFiles ) );
+}
+
+auto BitInputArchive::extractionPartitions( const std::vector< uint32_t >& indices ) const
+    -> std::vector< std::vector< uint32_t > > {
+    const auto threadsCount = mArchiveHandler.extractionThreads();
+    // Only archive files can be reopened by the extraction threads, and solid archives must be decoded sequentially.
+    if ( threadsCount < 2 || mArchivePath.empty() || is_solid_archive( *this ) ) {
+        return {};
+    }
+
+    if ( !indices.empty() ) {
+        return partition_by_packed_size( *this, indices, threadsCount );
+    }
+    std::vector< uint32_t > allIndices( itemsCount() );
+    std::iota( allIndices.begin(), allIndices.end(), 0 );
+    return partition_by_packed_size( *this, allIndices, threadsCount );
+}
+
+void BitInputArchive::extractToDirectory( const tstring& outDir, const std::vector< uint32_t >& indices ) const {
+    beginExtraction();
+    const auto partitions = extractionPartitions( indices );
+    const SafeOutPathBuilder outPathBuilder{ outDir };
+    if ( partitions.size() < 2 ) {
+        auto callback = bit7z::make_com< FileExtractCallback >( *this, outDir );
+        extract_arc( mInArchive, indices, callback );
+        auto extractedDirectories = callback->takeExtractedDirectories();
+        restore_directories_metadata( outPathBuilder, extractedDirectories );
+        return;
+    }
+
+    std::vector< std::exception_ptr > errors( partitions.size() );
+    std::vector< std::vector< ExtractedDirectory > > partitionsDirectories( partitions.size() );
+    const auto extractPartition = [ this, &outDir, &partitions, &errors, &partitionsDirectories ]
+        ( std::size_t partitionIndex ) noexcept {
+        try {
+            if ( partitionIndex == 0 ) {
+                auto callback = bit7z::make_com< FileExtractCallback >( *this, outDir );
+                extract_arc( mInArchive, partitions[ 0 ], callback );
+                partitionsDirectories[ 0 ] = callback->takeExtractedDirectories();
+                return;
+            }
+            // 7-Zip's archive handlers are not thread-safe, so each thread opens its own instance of the archive.
+            const BitInputArchive partitionArchive{ mArchiveHandler, tstring_to_path( mArchivePath ), mStartOffset };
+            for ( const auto& formatProperty : mFormatProperties ) {
+                partitionArchive.useFormatProperty( formatProperty.first.c_str(), formatProperty.second );
+            }
+            auto callback = bit7z::make_com< FileExtractCallback >( partitionArchive, outDir );
+            extract_arc( partitionArchive.mInArchive, partitions[ partitionIndex ], callback );
+            partitionsDirectories[ partitionIndex ] = callback->takeExtractedDirectories();
+        } catch ( ... ) {
+            errors[ partitionIndex ] = std::current_exception();
+        }
+    };
+
+    std::vector< std::thread > workers;
+    workers.reserve( partitions.size() - 1 );
+    std::size_t nextPartition = 1;
+    try {
+        for ( ; nextPartition < partitions.size(); ++nextPartition ) {
+            workers.emplace_back( extractPartition, nextPartition );
+        }
+    } catch ( const std::system_error& ) {
+        // The system could not start more threads: the remaining partitions are extracted by the current thread.
+    }
+
+    extractPartition( 0 );
+    for ( ; nextPartition < partitions.size(); ++nextPartition ) {
+        extractPartition( nextPartition );
+    }
+    for ( auto& worker : workers ) {
+        worker.join();
+    }
+
+    // The metadata of the directories is restored only after all the partitions have been extracted.
+    std::vector< ExtractedDirectory > extractedDirectories;
+    for ( auto& partitionDirectories : partitionsDirectories ) {
+        std::move( partitionDirectories.begin(), partitionDirectories.end(),
+                   std::back_inserter( extractedDirectories ) );
+    }
+    restore_directories_metadata( outPathBuilder, extractedDirectories );
+    rethrow_extraction_errors( errors, mArchivePath );
 }
 
 void BitInputArchive::extractTo( std::vector< byte_t >& outBuffer, uint32_t index ) const {
@@ -294,6 +578,7 @@ void BitInputArchive::extractTo( std::vector< byte_t >& outBuffer, uint32_t inde
     const vector< uint32_t > indices( 1, index );
     map< tstring, vector< byte_t > > buffersMap;
     auto extractCallback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, buffersMap );
+    beginExtraction();
     extract_arc( mInArchive, indices, extractCallback );
     outBuffer = std::move( buffersMap.begin()->second );
 }
@@ -312,6 +597,7 @@ void BitInputArchive::extractTo( std::ostream& outStream, uint32_t index ) const
 
     const vector< uint32_t > indices( 1, index );
     auto extractCallback = bit7z::make_com< StreamExtractCallback, ExtractCallback >( *this, outStream );
+    beginExtraction();
     extract_arc( mInArchive, indices, extractCallback );
 }
 
@@ -340,11 +626,13 @@ void BitInputArchive::extractTo( byte_t* buffer, std::size_t size, uint32_t inde
 
     const vector< uint32_t > indices( 1, index );
     auto extractCallback = bit7z::make_com< FixedBufferExtractCallback, ExtractCallback >( *this, buffer, size );
+    beginExtraction();
     extract_arc( mInArchive, indices, extractCallback );
 }
 
 void BitInputArchive::extractTo( std::map< tstring, std::vector< byte_t > >& outMap ) const {
-    const uint32_t numberItems = itemsCount();
+    // Note: when reading sequentially, the items are not known in advance, so we extract all of them.
+    const uint32_t numberItems = mSequentialAccess ? 0 : itemsCount();
     vector< uint32_t > filesIndices;
     for ( uint32_t i = 0; i < numberItems; ++i ) {
         if ( !isItemFolder( i ) ) { // Consider only files, not folders
@@ -353,12 +641,103 @@ void BitInputArchive::extractTo( std::map< tstring, std::vector< byte_t > >& out
     }
 
     auto extractCallback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, outMap );
+    beginExtraction();
     extract_arc( mInArchive, filesIndices, extractCallback );
 }
 
+void BitInputArchive::extractTo( BitMemoryArena& outArena ) const {
+    // Note: when reading sequentially, the items are not known in advance, so we extract all of them.
+    const uint32_t numberItems = mSequentialAccess ? 0 : itemsCount();
+    vector< uint32_t > filesIndices;
+    for ( uint32_t i = 0; i < numberItems; ++i ) {
+        if ( !isItemFolder( i ) ) { // Consider only files, not folders
+            filesIndices.push_back( i );
+        }
+    }
+
+    auto extractCallback = bit7z::make_com< ArenaExtractCallback >( *this, outArena, filesIndices );
+    beginExtraction();
+    extract_arc( mInArchive, filesIndices, extractCallback );
+    extractCallback->finalizeArena();
+}
+
+void BitInputArchive::extractTo( const ItemSinkFactory& sinkFactory, const std::vector< uint32_t >& indices ) const {
+    const auto invalidIndex = findInvalidIndex( indices, itemsCount() );
+    if ( invalidIndex != indices.cend() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( *invalidIndex ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    beginExtraction();
+    auto extractCallback = bit7z::make_com< SinkExtractCallback >( *this, sinkFactory );
+    try {
+        extract_arc( mInArchive, indices, extractCallback );
+    } catch ( const BitException& ) {
+        const auto sinkException = extractCallback->sinkException();
+        if ( sinkException ) {
+            std::rethrow_exception( sinkException );
+        }
+        if ( !extractCallback->stopRequested() ) {
+            throw;
+        }
+        // The extraction was stopped by one of the sinks, so it is not an error.
+    }
+}
+
+inline auto item_block( const BitInputArchive& archive, uint32_t index ) -> uint64_t {
+    const BitPropVariant block = archive.itemProperty( index, BitProperty::Block );
+    // Items not belonging to any block (e.g., in non-solid formats) are all grouped together.
+    return block.isEmpty() ? std::numeric_limits< uint64_t >::max() : block.getUInt64();
+}
+
+void BitInputArchive::extractTo( const BitExtractionBatch& batch ) const {
+    const uint32_t numberItems = itemsCount();
+
+    // Validating all the requests before extracting anything.
+    std::vector< std::pair< uint64_t, uint32_t > > plan; // (block, index) pairs
+    plan.reserve( batch.size() );
+    for ( const auto& request : batch.requests() ) {
+        if ( request.index >= numberItems ) {
+            throw BitException( "Cannot extract item at the index " + std::to_string( request.index ),
+                                make_error_code( BitError::InvalidIndex ) );
+        }
+        if ( isItemFolder( request.index ) ) { // Consider only files, not folders
+            throw BitException( "Cannot extract item at the index " + std::to_string( request.index ),
+                                make_error_code( BitError::ItemIsAFolder ) );
+        }
+        plan.emplace_back( item_block( *this, request.index ), request.index );
+    }
+
+    std::sort( plan.begin(), plan.end() );
+    const auto duplicate = std::adjacent_find( plan.cbegin(), plan.cend() );
+    if ( duplicate != plan.cend() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( duplicate->second ) + " twice",
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    /* 7-Zip requires the indices passed to each Extract call to be in ascending order.
+     * Usually, the items of a solid block have contiguous indices, and blocks are stored in the order of the indices,
+     * so a single extraction pass is enough; a new pass is needed only when a block starts at a lower index
+     * than the last one of the previous block. */
+    std::vector< std::vector< uint32_t > > passes;
+    for ( const auto& step : plan ) {
+        if ( passes.empty() || passes.back().back() > step.second ) {
+            passes.emplace_back();
+        }
+        passes.back().push_back( step.second );
+    }
+
+    beginExtraction();
+    auto extractCallback = bit7z::make_com< BatchExtractCallback, ExtractCallback >( *this, batch );
+    for ( const auto& passIndices : passes ) {
+        extract_arc( mInArchive, passIndices, extractCallback );
+    }
+}
+
 void BitInputArchive::test() const {
     map< tstring, vector< byte_t > > dummyMap; // output map (not used since we are testing!)
     auto extractCallback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, dummyMap );
+    beginExtraction();
     extract_arc( mInArchive, {}, extractCallback, ExtractMode::Test );
 }
 
@@ -371,16 +750,21 @@ void BitInputArchive::testItem( uint32_t index ) const {
 
     map< tstring, vector< byte_t > > dummyMap; // output map (not used since we are testing!)
     auto extractCallback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, dummyMap );
+    beginExtraction();
     extract_arc( mInArchive, { index }, extractCallback, ExtractMode::Test );
 }
 
 auto BitInputArchive::close() const noexcept -> HRESULT {
+    mItemTable.reset();
+    mPathIndex.reset();
     return mInArchive->Close();
 }
 
 BitInputArchive::~BitInputArchive() {
     if ( mInArchive != nullptr ) {
-        mInArchive->Close();
+        if ( mInArchive->Close() == S_OK && mReusableHandler ) {
+            mArchiveHandler.library().recycleInArchive( *mDetectedFormat, mInArchive );
+        }
         mInArchive->Release();
     }
 }
@@ -404,10 +788,27 @@ auto BitInputArchive::cend() const noexcept -> BitInputArchive::ConstIterator {
     return end();
 }
 
+auto BitInputArchive::itemPathIndex() const -> const ItemPathIndex& {
+    if ( !mPathIndex ) {
+        auto pathIndex = std::make_unique< ItemPathIndex >( itemsCount() );
+        for ( const auto& item : *this ) {
+            pathIndex->insert( item.path(), item.index() );
+        }
+        mPathIndex = std::move( pathIndex );
+    }
+    return *mPathIndex;
+}
+
 auto BitInputArchive::find( const tstring& path ) const noexcept -> BitInputArchive::ConstIterator {
-    return std::find_if( begin(), end(), [ &path ]( auto& oldItem ) {
-        return oldItem.path() == path;
-    } );
+    try {
+        const auto itemIndex = itemPathIndex().find( path, [ this, &path ]( uint32_t candidateIndex ) {
+            // The index stores only the hashes of the paths, so we must check the actual path of the candidate.
+            return ItemPathIndex::equals( ConstIterator{ candidateIndex, *this }->path(), path );
+        } );
+        return itemIndex != ItemPathIndex::kNotFound ? ConstIterator{ itemIndex, *this } : end();
+    } catch ( const BitException& ) {
+        return end();
+    }
 }
 
 auto BitInputArchive::contains( const tstring& path ) const noexcept -> bool {
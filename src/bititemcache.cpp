@@ -0,0 +1,199 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bititemcache.hpp"
+
+#include <iterator>
+#include <limits>
+#include <string>
+#include <unordered_set>
+
+#include "biterror.hpp"
+#include "bitexception.hpp"
+#include "bitinputarchive.hpp"
+
+namespace bit7z {
+
+constexpr std::size_t BitItemCache::kDefaultMaxBytes;
+
+constexpr auto kNoBlock = std::numeric_limits< std::uint64_t >::max();
+
+BitItemCache::BitItemCache( const BitInputArchive& archive, std::size_t maxBytes )
+    : mArchive{ archive }, mMaxBytes{ maxBytes }, mCachedBytes{ 0 }, mStatistics{ 0, 0, 0, 0 } {}
+
+auto BitItemCache::content( uint32_t index ) -> std::shared_ptr< const buffer_t > {
+    const auto cachedEntry = mEntriesIndex.find( index );
+    if ( cachedEntry != mEntriesIndex.end() ) {
+        ++mStatistics.hits;
+        mEntries.splice( mEntries.begin(), mEntries, cachedEntry->second );
+        return cachedEntry->second->content;
+    }
+
+    if ( index >= mArchive.itemsCount() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    if ( mArchive.isItemFolder( index ) ) { // Consider only files, not folders
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ) + " to the buffer",
+                            make_error_code( BitError::ItemIsAFolder ) );
+    }
+    ++mStatistics.misses;
+
+    const auto indices = decodedTogetherWith( index );
+    std::unordered_map< uint32_t, buffer_t > decoded;
+
+    /* The files preceding the requested one in the same solid block are collected only while they fit
+     * in the memory budget left free by the requested file, so that decoding a big solid block
+     * doesn't buffer all of its content. */
+    const auto requestedSize = mArchive.itemAt( index ).size();
+    const auto usedBytes = mCachedBytes + requestedSize;
+    const auto freeBytes = usedBytes < mMaxBytes ? static_cast< std::size_t >( mMaxBytes - usedBytes ) : 0;
+    std::size_t speculativeBytes = 0;
+    std::unordered_set< uint32_t > discarded;
+    mArchive.extractTo( [ &, index ]( const BitArchiveItem& item ) -> ItemSink {
+        const auto itemIndex = item.index();
+        const auto itemSize = item.size();
+        if ( itemIndex != index && itemSize > freeBytes - speculativeBytes ) {
+            discarded.insert( itemIndex );
+            return []( const byte_t* /*data*/, std::size_t /*size*/ ) -> bool {
+                return true;
+            };
+        }
+
+        // Note: references to the elements of an unordered_map are not invalidated by the insertion of new elements.
+        auto& buffer = decoded[ itemIndex ];
+        buffer.reserve( static_cast< std::size_t >( itemSize ) );
+        if ( itemIndex == index ) {
+            return [ &buffer ]( const byte_t* data, std::size_t size ) -> bool {
+                buffer.insert( buffer.end(), data, data + size ); // NOLINT(*-pro-bounds-pointer-arithmetic)
+                return true;
+            };
+        }
+        return [ &, itemIndex ]( const byte_t* data, std::size_t size ) -> bool {
+            if ( discarded.count( itemIndex ) != 0 ) {
+                return true;
+            }
+            if ( size > freeBytes - speculativeBytes ) {
+                // The file is bigger than declared: we stop collecting it.
+                speculativeBytes -= buffer.size();
+                buffer_t{}.swap( buffer );
+                discarded.insert( itemIndex );
+                return true;
+            }
+            buffer.insert( buffer.end(), data, data + size ); // NOLINT(*-pro-bounds-pointer-arithmetic)
+            speculativeBytes += size;
+            return true;
+        };
+    }, indices );
+
+    auto requestedContent = std::make_shared< const buffer_t >( std::move( decoded[ index ] ) );
+    if ( requestedContent->size() <= mMaxBytes ) {
+        mEntries.push_front( Entry{ index, requestedContent } );
+        mEntriesIndex.emplace( index, mEntries.begin() );
+        mCachedBytes += requestedContent->size();
+        evict();
+    }
+
+    /* The other files were decoded only because they precede the requested one in the same solid block:
+     * they are cached as the least recently used files, and only if they fit in the free memory budget. */
+    for ( const auto decodedIndex : indices ) {
+        if ( decodedIndex == index || discarded.count( decodedIndex ) != 0 ) {
+            continue;
+        }
+        auto& decodedContent = decoded[ decodedIndex ];
+        if ( decodedContent.size() > mMaxBytes - mCachedBytes ) {
+            continue;
+        }
+        mCachedBytes += decodedContent.size();
+        mEntries.push_back( Entry{ decodedIndex, std::make_shared< const buffer_t >( std::move( decodedContent ) ) } );
+        mEntriesIndex.emplace( decodedIndex, std::prev( mEntries.end() ) );
+        ++mStatistics.speculative;
+    }
+    return requestedContent;
+}
+
+void BitItemCache::extractTo( buffer_t& outBuffer, uint32_t index ) {
+    const auto itemContent = content( index );
+    outBuffer.assign( itemContent->cbegin(), itemContent->cend() );
+}
+
+auto BitItemCache::contains( uint32_t index ) const -> bool {
+    return mEntriesIndex.find( index ) != mEntriesIndex.end();
+}
+
+auto BitItemCache::maxBytes() const noexcept -> std::size_t {
+    return mMaxBytes;
+}
+
+void BitItemCache::setMaxBytes( std::size_t maxBytes ) {
+    mMaxBytes = maxBytes;
+    evict();
+}
+
+auto BitItemCache::cachedBytes() const noexcept -> std::size_t {
+    return mCachedBytes;
+}
+
+auto BitItemCache::size() const noexcept -> std::size_t {
+    return mEntries.size();
+}
+
+auto BitItemCache::statistics() const noexcept -> Statistics {
+    return mStatistics;
+}
+
+void BitItemCache::clear() noexcept {
+    mEntriesIndex.clear();
+    mEntries.clear();
+    mCachedBytes = 0;
+}
+
+auto BitItemCache::decodedTogetherWith( uint32_t index ) -> std::vector< uint32_t > {
+    if ( mItemsBlocks.empty() ) {
+        const auto itemsCount = mArchive.itemsCount();
+        mItemsBlocks.reserve( itemsCount );
+        for ( uint32_t itemIndex = 0; itemIndex < itemsCount; ++itemIndex ) {
+            const auto block = mArchive.itemProperty( itemIndex, BitProperty::Block );
+            mItemsBlocks.push_back( block.isUInt64() ? block.getUInt64() : kNoBlock );
+        }
+    }
+
+    // Note: the indices must be sorted, as required by the extraction.
+    std::vector< uint32_t > indices;
+    const auto itemBlock = mItemsBlocks[ index ];
+    if ( itemBlock != kNoBlock ) {
+        for ( uint32_t itemIndex = 0; itemIndex < index; ++itemIndex ) {
+            if ( mItemsBlocks[ itemIndex ] == itemBlock && !contains( itemIndex ) ) {
+                indices.push_back( itemIndex );
+            }
+        }
+    }
+    indices.push_back( index );
+    return indices;
+}
+
+void BitItemCache::erase( EntryIterator entry ) noexcept {
+    mCachedBytes -= entry->content->size();
+    mEntriesIndex.erase( entry->index );
+    mEntries.erase( entry );
+}
+
+void BitItemCache::evict() {
+    // Evicting the least recently used files first.
+    while ( mCachedBytes > mMaxBytes && !mEntries.empty() ) {
+        erase( std::prev( mEntries.end() ) );
+        ++mStatistics.evictions;
+    }
+}
+
+} // namespace bit7z
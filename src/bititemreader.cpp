@@ -0,0 +1,125 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bititemreader.hpp"
+
+#include "biterror.hpp"
+#include "bitexception.hpp"
+#include "bitinputarchive.hpp"
+#include "bititemtable.hpp"
+#include "internal/itempipe.hpp"
+#include "internal/pipeextractcallback.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+constexpr auto kStreamBufferChunkSize = 64 * 1024;
+
+BitItemReader::BitItemReader( const BitInputArchive& archive, std::size_t bufferSize )
+    : mArchive{ archive },
+      // Note: the items of an archive read sequentially are not known before extracting them.
+      mItemTable{ archive.mSequentialAccess ? nullptr : archive.fullItemTable() },
+      mPipe{ std::make_unique< ItemPipe >( bufferSize ) },
+      mStreamBuffer{ *this } {
+    mArchive.beginExtraction();
+    mWorker = std::thread( [this]() {
+        try {
+            auto extractCallback = bit7z::make_com< PipeExtractCallback, ExtractCallback >( mArchive, *mPipe );
+            extract_arc( mArchive.mInArchive, {}, extractCallback );
+            mPipe->finish( nullptr );
+        } catch ( ... ) {
+            mPipe->finish( std::current_exception() );
+        }
+    } );
+}
+
+BitItemReader::~BitItemReader() {
+    mPipe->close();
+    if ( mWorker.joinable() ) {
+        mWorker.join();
+    }
+}
+
+auto BitItemReader::nextItem() -> bool {
+    mStreamBuffer.reset();
+    mCurrentItem.reset();
+
+    uint32_t itemIndex = 0;
+    if ( !mPipe->nextItem( itemIndex ) ) {
+        return false;
+    }
+
+    if ( mItemTable && itemIndex < mItemTable->itemsCount() ) {
+        mCurrentItem = std::unique_ptr< BitArchiveItemInfo >( new BitArchiveItemInfo( itemIndex, mItemTable ) );
+        mPipe->startItem();
+        return true;
+    }
+
+    // The extraction is waiting for us to start the item, so we can safely read its properties from the archive.
+    auto item = std::unique_ptr< BitArchiveItemInfo >( new BitArchiveItemInfo( itemIndex ) );
+    for ( uint32_t i = kpidNoProperty; i <= kpidCopyLink; ++i ) {
+        const auto property = static_cast< BitProperty >( i );
+        const auto propertyValue = mArchive.itemProperty( itemIndex, property );
+        if ( !propertyValue.isEmpty() ) {
+            item->setProperty( property, propertyValue );
+        }
+    }
+    mCurrentItem = std::move( item );
+    mPipe->startItem();
+    return true;
+}
+
+auto BitItemReader::currentItem() const -> const BitArchiveItemInfo& {
+    if ( !mCurrentItem ) {
+        throw BitException( "The reader is not positioned on an item", make_error_code( BitError::InvalidIndex ) );
+    }
+    return *mCurrentItem;
+}
+
+auto BitItemReader::read( byte_t* buffer, std::size_t size ) -> std::size_t {
+    if ( buffer == nullptr ) {
+        throw BitException( "Cannot read the item to the buffer", make_error_code( BitError::NullOutputBuffer ) );
+    }
+    return mCurrentItem ? mPipe->read( buffer, size ) : 0;
+}
+
+auto BitItemReader::read( std::vector< byte_t >& buffer ) -> std::size_t {
+    return buffer.empty() ? 0 : read( buffer.data(), buffer.size() );
+}
+
+auto BitItemReader::streamBuffer() -> std::streambuf& {
+    return mStreamBuffer;
+}
+
+BitItemReader::ItemStreamBuffer::ItemStreamBuffer( BitItemReader& reader )
+    : mReader{ reader }, mChunk( kStreamBufferChunkSize ) {}
+
+void BitItemReader::ItemStreamBuffer::reset() {
+    setg( nullptr, nullptr, nullptr );
+}
+
+auto BitItemReader::ItemStreamBuffer::underflow() -> int_type {
+    if ( gptr() < egptr() ) {
+        return traits_type::to_int_type( *gptr() );
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto readSize = mReader.read( reinterpret_cast< byte_t* >( mChunk.data() ), mChunk.size() );
+    if ( readSize == 0 ) {
+        return traits_type::eof();
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    setg( mChunk.data(), mChunk.data(), mChunk.data() + readSize );
+    return traits_type::to_int_type( *gptr() );
+}
+
+} // namespace bit7z
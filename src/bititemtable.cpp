@@ -0,0 +1,205 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bititemtable.hpp"
+
+#include "biterror.hpp"
+#include "bitexception.hpp"
+#include "bitinputarchive.hpp"
+#include "internal/stringutil.hpp"
+
+#include <algorithm>
+#include <cwchar>
+
+namespace bit7z {
+
+inline auto pack_file_time( FILETIME fileTime ) noexcept -> uint64_t {
+    return ( static_cast< uint64_t >( fileTime.dwHighDateTime ) << 32u ) | fileTime.dwLowDateTime;
+}
+
+inline auto unpack_file_time( uint64_t value ) noexcept -> FILETIME {
+    FILETIME fileTime{};
+    fileTime.dwHighDateTime = static_cast< DWORD >( value >> 32u );
+    fileTime.dwLowDateTime = static_cast< DWORD >( value & 0xFFFFFFFFu );
+    return fileTime;
+}
+
+BitItemTable::BitItemTable( const BitInputArchive& inputArchive, const std::vector< BitProperty >& properties )
+    : mItemsCount{ inputArchive.itemsCount() } {
+    mProperties.reserve( properties.size() );
+    for ( auto property : properties ) {
+        if ( std::find( mProperties.cbegin(), mProperties.cend(), property ) == mProperties.cend() ) {
+            mProperties.push_back( property );
+        }
+    }
+
+    mColumns.resize( mProperties.size() );
+    for ( std::size_t col = 0; col < mProperties.size(); ++col ) {
+        mColumns[ col ].property = mProperties[ col ];
+        mColumns[ col ].types.resize( mItemsCount, BitPropVariantType::Empty );
+        mColumns[ col ].values.resize( mItemsCount, 0 );
+    }
+
+    // Single pass over the items of the archive, reading all the requested properties of each item.
+    for ( uint32_t index = 0; index < mItemsCount; ++index ) {
+        for ( auto& column : mColumns ) {
+            const BitPropVariant value = inputArchive.itemProperty( index, column.property );
+            const BitPropVariantType type = value.type();
+            column.types[ index ] = type;
+            switch ( type ) {
+                case BitPropVariantType::Empty:
+                    break;
+                case BitPropVariantType::Bool:
+                    column.values[ index ] = value.getBool() ? 1 : 0;
+                    break;
+                case BitPropVariantType::String: {
+                    column.values[ index ] = mStringArena.size();
+                    if ( value.bstrVal != nullptr ) {
+                        mStringArena.append( value.bstrVal, ::SysStringLen( value.bstrVal ) );
+                    }
+                    mStringArena.push_back( L'\0' );
+                    break;
+                }
+                case BitPropVariantType::FileTime:
+                    column.values[ index ] = pack_file_time( value.getFileTime() );
+                    break;
+                case BitPropVariantType::Int8:
+                case BitPropVariantType::Int16:
+                case BitPropVariantType::Int32:
+                case BitPropVariantType::Int64:
+                    column.values[ index ] = static_cast< uint64_t >( value.getInt64() );
+                    break;
+                default: // Unsigned integers
+                    column.values[ index ] = value.getUInt64();
+                    break;
+            }
+        }
+    }
+    mStringArena.shrink_to_fit();
+
+    // Dropping the columns of the properties that no item has (e.g., the ones not supported by the format).
+    mColumns.erase( std::remove_if( mColumns.begin(), mColumns.end(), []( const Column& column ) {
+        return std::all_of( column.types.cbegin(), column.types.cend(), []( BitPropVariantType type ) {
+            return type == BitPropVariantType::Empty;
+        } );
+    } ), mColumns.end() );
+}
+
+auto BitItemTable::itemsCount() const noexcept -> uint32_t {
+    return mItemsCount;
+}
+
+auto BitItemTable::properties() const noexcept -> const std::vector< BitProperty >& {
+    return mProperties;
+}
+
+auto BitItemTable::hasProperty( BitProperty property ) const noexcept -> bool {
+    return std::find( mProperties.cbegin(), mProperties.cend(), property ) != mProperties.cend();
+}
+
+auto BitItemTable::column( BitProperty property ) const -> const Column* {
+    const auto columnIt = std::find_if( mColumns.cbegin(), mColumns.cend(), [ &property ]( const Column& column ) {
+        return column.property == property;
+    } );
+    if ( columnIt != mColumns.cend() ) {
+        return &( *columnIt );
+    }
+    if ( !hasProperty( property ) ) {
+        throw BitException( "The item table does not contain the requested property",
+                            make_error_code( BitError::UnsupportedOperation ) );
+    }
+    return nullptr; // No item has a value for the property.
+}
+
+auto BitItemTable::stringValue( const Column& column, uint32_t index ) const noexcept -> const wchar_t* {
+    return mStringArena.c_str() + column.values[ index ];
+}
+
+auto BitItemTable::itemProperty( uint32_t index, BitProperty property ) const -> BitPropVariant {
+    if ( index >= mItemsCount ) {
+        throw BitException( "Cannot get the property of the item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    const auto* propertyColumn = column( property );
+    if ( propertyColumn == nullptr ) {
+        return BitPropVariant{};
+    }
+    const auto value = propertyColumn->values[ index ];
+    switch ( propertyColumn->types[ index ] ) {
+        case BitPropVariantType::Bool:
+            return BitPropVariant{ value != 0 };
+        case BitPropVariantType::String:
+            return BitPropVariant{ stringValue( *propertyColumn, index ) };
+        case BitPropVariantType::UInt8:
+            return BitPropVariant{ static_cast< uint8_t >( value ) };
+        case BitPropVariantType::UInt16:
+            return BitPropVariant{ static_cast< uint16_t >( value ) };
+        case BitPropVariantType::UInt32:
+            return BitPropVariant{ static_cast< uint32_t >( value ) };
+        case BitPropVariantType::UInt64:
+            return BitPropVariant{ value };
+        case BitPropVariantType::Int8:
+            return BitPropVariant{ static_cast< int8_t >( value ) };
+        case BitPropVariantType::Int16:
+            return BitPropVariant{ static_cast< int16_t >( value ) };
+        case BitPropVariantType::Int32:
+            return BitPropVariant{ static_cast< int32_t >( value ) };
+        case BitPropVariantType::Int64:
+            return BitPropVariant{ static_cast< int64_t >( value ) };
+        case BitPropVariantType::FileTime:
+            return BitPropVariant{ unpack_file_time( value ) };
+        case BitPropVariantType::Empty:
+        default:
+            return BitPropVariant{};
+    }
+}
+
+auto BitItemTable::path( uint32_t index ) const -> tstring {
+    if ( index >= mItemsCount ) {
+        throw BitException( "Cannot get the path of the item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    const auto* pathColumn = column( BitProperty::Path );
+    if ( pathColumn == nullptr || pathColumn->types[ index ] != BitPropVariantType::String ) {
+        return tstring{};
+    }
+    const wchar_t* itemPath = stringValue( *pathColumn, index );
+#if defined( BIT7Z_USE_NATIVE_STRING ) && defined( _WIN32 )
+    return tstring{ itemPath };
+#else
+    return narrow( itemPath, std::wcslen( itemPath ) );
+#endif
+}
+
+auto BitItemTable::isDir( uint32_t index ) const -> bool {
+    const BitPropVariant isDir = itemProperty( index, BitProperty::IsDir );
+    return !isDir.isEmpty() && isDir.getBool();
+}
+
+auto BitItemTable::size( uint32_t index ) const -> uint64_t {
+    const BitPropVariant size = itemProperty( index, BitProperty::Size );
+    return size.isEmpty() ? 0 : size.getUInt64();
+}
+
+auto BitItemTable::packSize( uint32_t index ) const -> uint64_t {
+    const BitPropVariant packSize = itemProperty( index, BitProperty::PackSize );
+    return packSize.isEmpty() ? 0 : packSize.getUInt64();
+}
+
+auto BitItemTable::crc( uint32_t index ) const -> uint32_t {
+    const BitPropVariant crc = itemProperty( index, BitProperty::CRC );
+    return crc.isUInt32() ? crc.getUInt32() : 0;
+}
+
+} // namespace bit7z
@@ -0,0 +1,65 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitmemoryarena.hpp"
+
+#include <algorithm>
+
+namespace bit7z {
+
+auto BitMemoryArena::find( const tstring& path ) const noexcept -> const Entry* {
+    // Note: comparing the paths in place, without creating temporary strings.
+    const auto entry = std::lower_bound( mEntries.cbegin(), mEntries.cend(), path,
+                                         [this]( const Entry& element, const tstring& value ) {
+                                             return mPaths.compare( element.pathOffset, element.pathSize, value ) < 0;
+                                         } );
+    if ( entry == mEntries.cend() || mPaths.compare( entry->pathOffset, entry->pathSize, path ) != 0 ) {
+        return nullptr;
+    }
+    return &( *entry );
+}
+
+auto BitMemoryArena::contains( const tstring& path ) const noexcept -> bool {
+    return find( path ) != nullptr;
+}
+
+auto BitMemoryArena::content( const Entry& entry ) const noexcept -> const byte_t* {
+    return mBuffer.data() + entry.offset; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+auto BitMemoryArena::path( const Entry& entry ) const -> tstring {
+    return mPaths.substr( entry.pathOffset, entry.pathSize );
+}
+
+auto BitMemoryArena::entries() const noexcept -> const std::vector< Entry >& {
+    return mEntries;
+}
+
+auto BitMemoryArena::buffer() const noexcept -> const buffer_t& {
+    return mBuffer;
+}
+
+auto BitMemoryArena::size() const noexcept -> std::size_t {
+    return mEntries.size();
+}
+
+auto BitMemoryArena::empty() const noexcept -> bool {
+    return mEntries.empty();
+}
+
+void BitMemoryArena::clear() noexcept {
+    mBuffer.clear();
+    mPaths.clear();
+    mEntries.clear();
+}
+
+} // namespace bit7z
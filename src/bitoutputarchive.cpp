@@ -16,11 +16,16 @@
 #include "internal/archiveproperties.hpp"
 #include "internal/cbufferoutstream.hpp"
 #include "internal/cmultivolumeoutstream.hpp"
+#include "internal/cstdoutstream.hpp"
+#include "internal/cstdsequentialoutstream.hpp"
 #include "internal/genericinputitem.hpp"
+#include "internal/streamutil.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/updatecallback.hpp"
 #include "internal/util.hpp"
 
+#include <array>
+
 namespace bit7z {
 
 BitOutputArchive::BitOutputArchive( const BitAbstractArchiveCreator& creator )
@@ -169,10 +174,6 @@ auto BitOutputArchive::initOutArchive() const -> CMyComPtr< IOutArchive > {
 
 auto BitOutputArchive::initOutFileStream( const fs::path& outArchive,
                                           bool updatingArchive ) const -> CMyComPtr< IOutStream > {
-    if ( mArchiveCreator.volumeSize() > 0 ) {
-        return bit7z::make_com< CMultiVolumeOutStream, IOutStream >( mArchiveCreator.volumeSize(), outArchive );
-    }
-
     fs::path outPath = outArchive;
     if ( updatingArchive ) {
         outPath += ".tmp";
@@ -181,10 +182,137 @@ auto BitOutputArchive::initOutFileStream( const fs::path& outArchive,
     return bit7z::make_com< CFileOutStream, IOutStream >( outPath, updatingArchive );
 }
 
+// Precision (in 100-nanoseconds intervals) of the last write times stored by the output archive format.
+inline auto file_time_precision( IOutArchive* outArc ) -> uint64_t {
+    constexpr uint64_t kExactTimePrecision = 1; // 100 nanoseconds, i.e., the FILETIME resolution
+    constexpr uint64_t kUnixTimePrecision = 10000000; // 1 second
+    constexpr uint64_t kDosTimePrecision = 2 * kUnixTimePrecision; // 2 seconds
+    constexpr UInt32 k1nsFileTimeType = 3; // NFileTimeType::k1ns, not defined by older versions of 7-Zip
+
+    UInt32 fileTimeType = NFileTimeType::kWindows;
+    if ( outArc->GetFileTimeType( &fileTimeType ) != S_OK ) {
+        // When in doubt, an item is considered unchanged only if its time is the same.
+        return kExactTimePrecision;
+    }
+    switch ( fileTimeType ) {
+        case NFileTimeType::kWindows:
+        case k1nsFileTimeType:
+            return kExactTimePrecision;
+        case NFileTimeType::kUnix:
+            return kUnixTimePrecision;
+        case NFileTimeType::kDOS:
+            return kDosTimePrecision;
+        default:
+            return kExactTimePrecision;
+    }
+}
+
+inline auto file_time_ticks( FILETIME fileTime ) noexcept -> uint64_t {
+    return ( static_cast< uint64_t >( fileTime.dwHighDateTime ) << 32u ) | fileTime.dwLowDateTime;
+}
+
+constexpr auto kCrc32Slices = 4;
+
+// Lookup tables of the slicing-by-4 CRC32 algorithm.
+struct Crc32Tables {
+    uint32_t values[ kCrc32Slices ][ 256 ]; // NOLINT(*-avoid-c-arrays)
+};
+
+constexpr auto make_crc32_tables() noexcept -> Crc32Tables {
+    Crc32Tables tables{};
+    for ( uint32_t i = 0; i < 256; ++i ) {
+        uint32_t value = i;
+        for ( int bit = 0; bit < 8; ++bit ) {
+            value = ( value & 1u ) != 0 ? ( 0xEDB88320u ^ ( value >> 1u ) ) : ( value >> 1u );
+        }
+        tables.values[ 0 ][ i ] = value;
+    }
+    for ( uint32_t i = 0; i < 256; ++i ) {
+        for ( int slice = 1; slice < kCrc32Slices; ++slice ) {
+            const uint32_t previous = tables.values[ slice - 1 ][ i ];
+            tables.values[ slice ][ i ] = ( previous >> 8u ) ^ tables.values[ 0 ][ previous & 0xFFu ];
+        }
+    }
+    return tables;
+}
+
+constexpr Crc32Tables kCrc32Tables = make_crc32_tables();
+
+inline auto crc32_update( uint32_t crc, const byte_t* data, std::size_t size ) noexcept -> uint32_t {
+    const auto& table = kCrc32Tables.values;
+    std::size_t position = 0;
+    for ( ; position + kCrc32Slices <= size; position += kCrc32Slices ) {
+        crc ^= static_cast< uint32_t >( data[ position ] ) |
+               ( static_cast< uint32_t >( data[ position + 1 ] ) << 8u ) |
+               ( static_cast< uint32_t >( data[ position + 2 ] ) << 16u ) |
+               ( static_cast< uint32_t >( data[ position + 3 ] ) << 24u );
+        crc = table[ 3 ][ crc & 0xFFu ] ^ table[ 2 ][ ( crc >> 8u ) & 0xFFu ] ^
+              table[ 1 ][ ( crc >> 16u ) & 0xFFu ] ^ table[ 0 ][ crc >> 24u ];
+    }
+    for ( ; position < size; ++position ) {
+        crc = table[ 0 ][ ( crc ^ data[ position ] ) & 0xFFu ] ^ ( crc >> 8u );
+    }
+    return crc;
+}
+
+inline auto item_crc( const GenericInputItem& item, uint32_t& crc ) -> bool {
+    CMyComPtr< ISequentialInStream > inStream;
+    if ( item.getStream( &inStream ) != S_OK || inStream == nullptr ) {
+        return false;
+    }
+
+    constexpr auto kBufferSize = 64 * 1024;
+    std::array< byte_t, kBufferSize > buffer{};
+    uint32_t result = 0xFFFFFFFFu;
+    UInt32 readBytes = 0;
+    do {
+        if ( inStream->Read( buffer.data(), kBufferSize, &readBytes ) != S_OK ) {
+            return false;
+        }
+        result = crc32_update( result, buffer.data(), readBytes );
+    } while ( readBytes > 0 );
+    crc = result ^ 0xFFFFFFFFu;
+    return true;
+}
+
+auto BitOutputArchive::isItemUnchanged( uint32_t oldIndex,
+                                        const GenericInputItem& newItem,
+                                        uint64_t timePrecision ) const -> bool {
+    if ( mInputArchive->isItemFolder( oldIndex ) != newItem.isDir() ) {
+        return false;
+    }
+    if ( newItem.isDir() ) {
+        return true;
+    }
+
+    const BitPropVariant oldSize = mInputArchive->itemProperty( oldIndex, BitProperty::Size );
+    if ( oldSize.isEmpty() || oldSize.getUInt64() != newItem.size() ) {
+        return false;
+    }
+
+    const BitPropVariant oldWriteTime = mInputArchive->itemProperty( oldIndex, BitProperty::MTime );
+    if ( !oldWriteTime.isFileTime() ) {
+        return false;
+    }
+    const auto oldTicks = file_time_ticks( oldWriteTime.getFileTime() );
+    const auto newTicks = file_time_ticks( newItem.lastWriteTime() );
+    if ( ( oldTicks > newTicks ? oldTicks - newTicks : newTicks - oldTicks ) >= timePrecision ) {
+        return false;
+    }
+
+    if ( !mArchiveCreator.freshenChecksCrc() ) {
+        return true;
+    }
+    const BitPropVariant oldCrc = mInputArchive->itemProperty( oldIndex, BitProperty::CRC );
+    uint32_t newCrc = 0;
+    return oldCrc.isUInt32() && item_crc( newItem, newCrc ) && oldCrc.getUInt32() == newCrc;
+}
+
 void BitOutputArchive::compressOut( IOutArchive* outArc,
-                                    IOutStream* outStream,
+                                    ISequentialOutStream* outStream,
                                     UpdateCallback* updateCallback ) {
-    if ( mInputArchive != nullptr && mArchiveCreator.updateMode() == UpdateMode::Update ) {
+    const UpdateMode updateMode = mArchiveCreator.updateMode();
+    if ( mInputArchive != nullptr && updateMode == UpdateMode::Update ) {
         for ( const auto& newItem : mNewItemsVector ) {
             auto newItemPath = path_to_tstring( newItem->inArchivePath() );
             auto updatedItem = mInputArchive->find( newItemPath );
@@ -192,6 +320,23 @@ void BitOutputArchive::compressOut( IOutArchive* outArc,
                 setDeletedIndex( updatedItem->index() );
             }
         }
+    } else if ( mInputArchive != nullptr && updateMode == UpdateMode::Freshen ) {
+        const auto timePrecision = file_time_precision( outArc );
+        for ( std::size_t newItemIndex = 0; newItemIndex < mNewItemsVector.size(); ++newItemIndex ) {
+            const GenericInputItem& newItem = mNewItemsVector[ newItemIndex ];
+            auto updatedItem = mInputArchive->find( path_to_tstring( newItem.inArchivePath() ) );
+            if ( updatedItem == mInputArchive->cend() ) {
+                continue;
+            }
+            if ( isItemUnchanged( updatedItem->index(), newItem, timePrecision ) ) {
+                /* The old item is kept as it is (i.e., without recompressing it), while the new item is skipped.
+                 * Note: new items are indexed after the items of the input archive (see itemProperty),
+                 *       so marking the new item as deleted excludes it from the output archive. */
+                setDeletedIndex( mInputArchiveItemsCount + static_cast< uint32_t >( newItemIndex ) );
+            } else {
+                setDeletedIndex( updatedItem->index() );
+            }
+        }
     }
     updateInputIndices();
 
@@ -204,9 +349,46 @@ void BitOutputArchive::compressOut( IOutArchive* outArc,
     if ( result != S_OK ) {
         throw BitException( "Error while compressing files", make_hresult_code( result ), std::move( mFailedFiles ) );
     }
+
+    if ( mInputArchive == nullptr ) {
+        // The archive object was created only for this archive, so it can be reused for creating other archives.
+        mArchiveCreator.library().recycleOutArchive( mArchiveCreator.compressionFormat(), outArc );
+    }
+}
+
+void BitOutputArchive::compressToVolumes( const fs::path& outFile, UpdateCallback* updateCallback ) {
+    const CMyComPtr< IOutArchive > newArc = initOutArchive();
+    auto outStream = bit7z::make_com< CMultiVolumeOutStream >( mArchiveCreator.volumeSize(),
+                                                               outFile,
+                                                               mArchiveCreator.volumeCallback() );
+    try {
+        compressOut( newArc, outStream, updateCallback );
+    } catch ( const BitException& ) {
+        const auto volumeCallbackException = outStream->volumeCallbackException();
+        if ( volumeCallbackException ) {
+            std::rethrow_exception( volumeCallbackException );
+        }
+        throw;
+    }
+
+    // The archive was written successfully, so the volumes that are still open can be completed.
+    const HRESULT result = outStream->finish();
+    const auto volumeCallbackException = outStream->volumeCallbackException();
+    if ( volumeCallbackException ) {
+        std::rethrow_exception( volumeCallbackException );
+    }
+    if ( result != S_OK ) {
+        throw BitException( "Failed to complete the archive volumes", make_hresult_code( result ),
+                            path_to_tstring( outFile ) );
+    }
 }
 
 void BitOutputArchive::compressToFile( const fs::path& outFile, UpdateCallback* updateCallback ) {
+    if ( mArchiveCreator.volumeSize() > 0 ) {
+        compressToVolumes( outFile, updateCallback );
+        return;
+    }
+
     // Note: if mInputArchive != nullptr, newArc will actually point to the same IInArchive object used by the old_arc
     // (see initUpdatableArchive function of BitInputArchive)!
     const bool updatingArchive = mInputArchive != nullptr && tstring_to_path( mInputArchive->archivePath() ) == outFile;
@@ -285,6 +467,13 @@ void BitOutputArchive::compressTo( std::vector< byte_t >& outBuffer ) {
 
 void BitOutputArchive::compressTo( std::ostream& outStream ) {
     const CMyComPtr< IOutArchive > newArc = initOutArchive();
+    if ( !is_seekable( outStream, std::ios_base::out ) ) {
+        // The archive handler will see only a sequential stream, so it will write the archive forward-only.
+        auto outSeqStream = bit7z::make_com< CStdSequentialOutStream, ISequentialOutStream >( outStream );
+        auto updateCallback = bit7z::make_com< UpdateCallback >( *this );
+        compressOut( newArc, outSeqStream, updateCallback );
+        return;
+    }
     auto outStdStream = bit7z::make_com< CStdOutStream, IOutStream >( outStream );
     auto updateCallback = bit7z::make_com< UpdateCallback >( *this );
     compressOut( newArc, outStdStream, updateCallback );
@@ -0,0 +1,146 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+
+#include "bitexception.hpp"
+#include "internal/arenaextractcallback.hpp"
+#include "internal/bufferutil.hpp"
+#include "internal/cbufferoutstream.hpp"
+#include "internal/fs.hpp"
+#include "internal/stringutil.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+ArenaExtractCallback::ArenaExtractCallback( const BitInputArchive& inputArchive,
+                                            BitMemoryArena& arena,
+                                            const std::vector< uint32_t >& indices )
+    : ExtractCallback( inputArchive ), mArena( arena ), mWritingEntry{ false } {
+    mArena.clear();
+    mArena.mEntries.reserve( indices.size() );
+
+    /* Allocating the arena at once, using the sizes of the items declared by the archive (if any).
+     * Since the declared sizes might be bogus, only up to kMaxReservedBufferSize bytes are reserved up front
+     * (the arena grows on demand while writing), and the sum stops there, so that it cannot overflow. */
+    uint64_t totalSize = 0;
+    for ( const auto index : indices ) {
+        const BitPropVariant itemSize = itemProperty( index, BitProperty::Size );
+        if ( itemSize.isUInt64() ) {
+            totalSize += std::min( itemSize.getUInt64(), kMaxReservedBufferSize );
+            if ( totalSize >= kMaxReservedBufferSize ) {
+                break;
+            }
+        }
+    }
+    reserve_buffer( mArena.mBuffer, totalSize );
+}
+
+void ArenaExtractCallback::releaseStream() {
+    mOutMemStream.Release();
+}
+
+auto ArenaExtractCallback::finishOperation( OperationResult operationResult ) -> HRESULT {
+    releaseStream();
+    if ( mWritingEntry ) {
+        auto& entry = mArena.mEntries.back();
+        entry.size = mArena.mBuffer.size() - entry.offset;
+        mWritingEntry = false;
+    }
+    return operationResult != OperationResult::Success ? E_FAIL : S_OK;
+}
+
+auto ArenaExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT {
+    if ( isItemFolder( index ) ) {
+        return S_OK;
+    }
+
+    // Get Name
+    const BitPropVariant prop = itemProperty( index, BitProperty::Path );
+    tstring fullPath;
+
+    if ( prop.isEmpty() ) {
+        fullPath = kEmptyFileAlias;
+    } else if ( prop.isString() ) {
+        if ( !mHandler.retainDirectories() ) {
+            fullPath = path_to_tstring( fs::path{ prop.getNativeString() }.filename() );
+        } else {
+            fullPath = prop.getString();
+        }
+    } else {
+        return E_FAIL;
+    }
+
+    if ( mHandler.fileCallback() ) {
+        mHandler.fileCallback()( fullPath );
+    }
+
+    // The content of the item is appended to the arena, after the contents of the previous items.
+    mArena.mEntries.push_back( BitMemoryArena::Entry{ mArena.mPaths.size(), fullPath.size(),
+                                                      mArena.mBuffer.size(), 0 } );
+    mArena.mPaths += fullPath;
+    mWritingEntry = true;
+
+    auto outStreamLoc = bit7z::make_com< CBufferOutStream, IOutStream >( mArena.mBuffer );
+    const HRESULT res = outStreamLoc->Seek( 0, STREAM_SEEK_END, nullptr );
+    if ( res != S_OK ) {
+        return res;
+    }
+    mOutMemStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
+
+void ArenaExtractCallback::finalizeArena() {
+    const auto& paths = mArena.mPaths;
+    auto& entries = mArena.mEntries;
+
+    // Note: the sorting is stable, so the entries with the same path keep the extraction order.
+    std::stable_sort( entries.begin(), entries.end(),
+                      [&paths]( const BitMemoryArena::Entry& first, const BitMemoryArena::Entry& second ) {
+                          return paths.compare( first.pathOffset, first.pathSize,
+                                                paths, second.pathOffset, second.pathSize ) < 0;
+                      } );
+
+    const auto samePath = [&paths]( const BitMemoryArena::Entry& first, const BitMemoryArena::Entry& second ) {
+        return paths.compare( first.pathOffset, first.pathSize, paths, second.pathOffset, second.pathSize ) == 0;
+    };
+    if ( std::adjacent_find( entries.cbegin(), entries.cend(), samePath ) == entries.cend() ) {
+        return;
+    }
+
+    switch ( mHandler.overwriteMode() ) {
+        case OverwriteMode::None: {
+            throw BitException( "Cannot erase output buffer", make_hresult_code( E_ABORT ) );
+        }
+        case OverwriteMode::Skip: { // Keeping the first extracted entry for each path.
+            entries.erase( std::unique( entries.begin(), entries.end(), samePath ), entries.end() );
+            break;
+        }
+        case OverwriteMode::Overwrite:
+        default: { // Keeping the last extracted entry for each path.
+            auto last = entries.begin();
+            for ( auto it = entries.begin(); it != entries.end(); ++it ) {
+                if ( last != entries.begin() && samePath( *( last - 1 ), *it ) ) {
+                    *( last - 1 ) = *it;
+                } else {
+                    *last++ = *it;
+                }
+            }
+            entries.erase( last, entries.end() );
+            break;
+        }
+    }
+    // Note: the contents of the discarded entries are still in the arena's buffer, but they are not indexed.
+}
+
+} // namespace bit7z
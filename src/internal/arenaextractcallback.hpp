@@ -0,0 +1,55 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ARENAEXTRACTCALLBACK_HPP
+#define ARENAEXTRACTCALLBACK_HPP
+
+#include <vector>
+
+#include "bitmemoryarena.hpp"
+#include "internal/extractcallback.hpp"
+
+namespace bit7z {
+
+class ArenaExtractCallback final : public ExtractCallback {
+    public:
+        ArenaExtractCallback( const BitInputArchive& inputArchive,
+                              BitMemoryArena& arena,
+                              const std::vector< uint32_t >& indices );
+
+        ArenaExtractCallback( const ArenaExtractCallback& ) = delete;
+
+        ArenaExtractCallback( ArenaExtractCallback&& ) = delete;
+
+        auto operator=( const ArenaExtractCallback& ) -> ArenaExtractCallback& = delete;
+
+        auto operator=( ArenaExtractCallback&& ) -> ArenaExtractCallback& = delete;
+
+        ~ArenaExtractCallback() override = default;
+
+        /**
+         * @brief Sorts the index of the arena by path, resolving the duplicate paths
+         * according to the overwrite mode of the archive handler.
+         */
+        void finalizeArena();
+
+    private:
+        BitMemoryArena& mArena;
+        CMyComPtr< ISequentialOutStream > mOutMemStream;
+        bool mWritingEntry;
+
+        auto finishOperation( OperationResult operationResult ) -> HRESULT override;
+
+        void releaseStream() override;
+
+        auto getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT override;
+};
+
+}  // namespace bit7z
+#endif // ARENAEXTRACTCALLBACK_HPP
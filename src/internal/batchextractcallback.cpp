@@ -0,0 +1,128 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitexception.hpp"
+#include "internal/batchextractcallback.hpp"
+#include "internal/bufferutil.hpp"
+#include "internal/cbufferoutstream.hpp"
+#include "internal/cfileoutstream.hpp"
+#include "internal/cstdoutstream.hpp"
+#include "internal/fsutil.hpp"
+#include "internal/stringutil.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+BatchExtractCallback::BatchExtractCallback( const BitInputArchive& inputArchive, const BitExtractionBatch& batch )
+    : ExtractCallback( inputArchive ) {
+    mRequests.reserve( batch.size() );
+    for ( const auto& request : batch.requests() ) {
+        mRequests.emplace( request.index, &request );
+    }
+}
+
+void BatchExtractCallback::releaseStream() {
+    mOutStream.Release();
+}
+
+auto BatchExtractCallback::finishOperation( OperationResult operationResult ) -> HRESULT {
+    mOutStream.Release(); // We need to release the file to change its modified time!
+
+    if ( !mFilePathOnDisk.empty() && operationResult == OperationResult::Success && mModifiedTime.isFileTime() ) {
+#ifdef _WIN32
+        filesystem::fsutil::set_file_time( mFilePathOnDisk, FILETIME{}, FILETIME{}, mModifiedTime.getFileTime() );
+#else
+        filesystem::fsutil::set_file_modified_time( mFilePathOnDisk, mModifiedTime.getFileTime() );
+#endif
+    }
+    mFilePathOnDisk.clear();
+    return operationResult != OperationResult::Success ? E_FAIL : S_OK;
+}
+
+auto BatchExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT {
+    const auto request = mRequests.find( index );
+    if ( request == mRequests.end() ) { // Not requested by the batch (e.g., items of a solid block being skipped).
+        return S_OK;
+    }
+
+    if ( mHandler.fileCallback() ) {
+        const BitPropVariant itemPath = itemProperty( index, BitProperty::Path );
+        mHandler.fileCallback()( itemPath.isString() ? itemPath.getString() : kEmptyFileAlias );
+    }
+
+    switch ( request->second->destination ) {
+        case BitExtractionBatch::Destination::Buffer: {
+            auto& outBuffer = *request->second->buffer;
+            outBuffer.clear();
+
+            // Reserving the memory needed by the item in advance, so that the buffer is allocated only once.
+            const BitPropVariant itemSize = itemProperty( index, BitProperty::Size );
+            if ( itemSize.isUInt64() ) {
+                reserve_buffer( outBuffer, itemSize.getUInt64() );
+            }
+
+            auto outStreamLoc = bit7z::make_com< CBufferOutStream, ISequentialOutStream >( outBuffer );
+            mOutStream = outStreamLoc;
+            *outStream = outStreamLoc.Detach();
+            return S_OK;
+        }
+        case BitExtractionBatch::Destination::Stream: {
+            auto outStreamLoc = bit7z::make_com< CStdOutStream, ISequentialOutStream >( *request->second->stream );
+            mOutStream = outStreamLoc;
+            *outStream = outStreamLoc.Detach();
+            return S_OK;
+        }
+        case BitExtractionBatch::Destination::File:
+        default:
+            return getFileOutStream( index, request->second->filePath, outStream );
+    }
+}
+
+constexpr auto kCannotDeleteOutput = "Cannot delete output file";
+
+auto BatchExtractCallback::getFileOutStream( uint32_t index,
+                                             const tstring& outFile,
+                                             ISequentialOutStream** outStream ) -> HRESULT {
+    const fs::path filePath = tstring_to_path( outFile );
+
+    std::error_code error;
+    if ( filePath.has_parent_path() ) {
+        fs::create_directories( filePath.parent_path(), error );
+    }
+
+    if ( fs::exists( filePath, error ) ) {
+        switch ( mHandler.overwriteMode() ) {
+            case OverwriteMode::None: {
+                throw BitException( kCannotDeleteOutput, make_hresult_code( E_ABORT ), outFile );
+            }
+            case OverwriteMode::Skip: {
+                return S_OK;
+            }
+            case OverwriteMode::Overwrite:
+            default: {
+                if ( !fs::remove( filePath, error ) ) {
+                    throw BitException( kCannotDeleteOutput, make_hresult_code( E_ABORT ), outFile );
+                }
+                break;
+            }
+        }
+    }
+
+    auto outStreamLoc = bit7z::make_com< CFileOutStream, ISequentialOutStream >( filePath, true );
+    mOutStream = outStreamLoc;
+    mFilePathOnDisk = filePath;
+    mModifiedTime = itemProperty( index, BitProperty::MTime );
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
+
+} // namespace bit7z
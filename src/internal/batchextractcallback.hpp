@@ -0,0 +1,52 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BATCHEXTRACTCALLBACK_HPP
+#define BATCHEXTRACTCALLBACK_HPP
+
+#include <unordered_map>
+
+#include "bitextractionbatch.hpp"
+#include "internal/extractcallback.hpp"
+#include "internal/fs.hpp"
+
+namespace bit7z {
+
+class BatchExtractCallback final : public ExtractCallback {
+    public:
+        BatchExtractCallback( const BitInputArchive& inputArchive, const BitExtractionBatch& batch );
+
+        BatchExtractCallback( const BatchExtractCallback& ) = delete;
+
+        BatchExtractCallback( BatchExtractCallback&& ) = delete;
+
+        auto operator=( const BatchExtractCallback& ) -> BatchExtractCallback& = delete;
+
+        auto operator=( BatchExtractCallback&& ) -> BatchExtractCallback& = delete;
+
+        ~BatchExtractCallback() override = default;
+
+    private:
+        std::unordered_map< uint32_t, const BitExtractionBatch::Request* > mRequests;
+        CMyComPtr< ISequentialOutStream > mOutStream;
+        fs::path mFilePathOnDisk; // Path of the file being extracted (empty if the destination is not a file).
+        BitPropVariant mModifiedTime;
+
+        auto finishOperation( OperationResult operationResult ) -> HRESULT override;
+
+        void releaseStream() override;
+
+        auto getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT override;
+
+        auto getFileOutStream( uint32_t index, const tstring& outFile, ISequentialOutStream** outStream ) -> HRESULT;
+};
+
+}  // namespace bit7z
+
+#endif // BATCHEXTRACTCALLBACK_HPP
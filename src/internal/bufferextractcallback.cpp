@@ -12,6 +12,7 @@
 
 #include "bitexception.hpp"
 #include "internal/bufferextractcallback.hpp"
+#include "internal/bufferutil.hpp"
 #include "internal/cbufferoutstream.hpp"
 #include "internal/fs.hpp"
 #include "internal/stringutil.hpp"
@@ -73,6 +74,12 @@ auto BufferExtractCallback::getOutStream( uint32_t index, ISequentialOutStream**
         }
     }
 
+    // Reserving the memory needed by the item in advance, so that the buffer is allocated only once.
+    const BitPropVariant itemSize = itemProperty( index, BitProperty::Size );
+    if ( itemSize.isUInt64() ) {
+        reserve_buffer( outBuffer, itemSize.getUInt64() );
+    }
+
     auto outStreamLoc = bit7z::make_com< CBufferOutStream, ISequentialOutStream >( outBuffer );
     mOutMemStream = outStreamLoc;
     *outStream = outStreamLoc.Detach();
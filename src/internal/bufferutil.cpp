@@ -13,6 +13,10 @@
 #include "internal/bufferutil.hpp"
 #include "internal/windows.hpp"
 
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
 auto bit7z::seek( const buffer_t& buffer,
                   const buffer_t::const_iterator& currentPosition,
                   int64_t offset,
@@ -43,4 +47,18 @@ auto bit7z::seek( const buffer_t& buffer,
 
     newPosition = currentIndex;
     return S_OK;
-}
\ No newline at end of file
+}
+
+void bit7z::reserve_buffer( buffer_t& buffer, uint64_t size ) noexcept {
+    size = std::min( size, kMaxReservedBufferSize );
+    if ( size > buffer.max_size() ) {
+        return;
+    }
+    try {
+        buffer.reserve( static_cast< buffer_t::size_type >( size ) );
+    } catch ( const std::bad_alloc& ) {
+        // The buffer will grow while writing the data.
+    } catch ( const std::length_error& ) {
+        // As above.
+    }
+}
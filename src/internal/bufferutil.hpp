@@ -21,6 +21,18 @@ auto seek( const buffer_t& buffer,
            uint32_t seekOrigin,
            uint64_t& newPosition ) -> HRESULT;
 
+/**
+ * The maximum number of bytes reserved up front for a buffer: bigger buffers grow while writing the data.
+ */
+constexpr auto kMaxReservedBufferSize = static_cast< uint64_t >( 64 * 1024 * 1024 );
+
+/**
+ * Reserves the memory needed for storing the given number of bytes in the buffer, if possible
+ * (e.g., the size of an item declared by an archive might be bogus, so failing to reserve it is not an error).
+ * At most kMaxReservedBufferSize bytes are reserved, so that a corrupted archive cannot force huge allocations.
+ */
+void reserve_buffer( buffer_t& buffer, uint64_t size ) noexcept;
+
 } // namespace bit7z
 
 #endif //BUFFERUTIL_HPP
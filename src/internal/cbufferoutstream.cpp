@@ -23,7 +23,9 @@ CBufferOutStream::CBufferOutStream( vector< byte_t >& outBuffer )
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferOutStream::SetSize( UInt64 newSize ) noexcept {
     try {
+        const auto oldPos = std::min( mCurrentPosition - mBuffer.begin(), static_cast< index_t >( newSize ) );
         mBuffer.resize( static_cast< vector< byte_t >::size_type >( newSize ) );
+        mCurrentPosition = mBuffer.begin() + oldPos; // resize(...) might have invalidated the iterator.
         return S_OK;
     } catch ( ... ) {
         return E_OUTOFMEMORY;
@@ -60,25 +62,24 @@ STDMETHODIMP CBufferOutStream::Write( const void* data, UInt32 size, UInt32* pro
         return E_FAIL;
     }
 
-    auto oldPos = ( mCurrentPosition - mBuffer.begin() );
-    const size_t newPos = static_cast< size_t >( oldPos ) + static_cast< size_t >( size );
-    if ( newPos > mBuffer.size() ) {
-        try {
-            mBuffer.resize( newPos );
-        } catch ( ... ) {
-            return E_OUTOFMEMORY;
-        }
-        mCurrentPosition = mBuffer.begin() + oldPos; // resize(...) invalidated the old mCurrentPosition iterator
-    }
-
     const auto* byteData = static_cast< const byte_t* >( data ); //-V2571
+    const auto oldPos = mCurrentPosition - mBuffer.begin();
+    const auto overwrittenSize = std::min( static_cast< std::size_t >( size ),
+                                           static_cast< std::size_t >( mBuffer.end() - mCurrentPosition ) );
     try {
-        std::copy_n( byteData, size, mCurrentPosition );
+        // Overwriting the bytes following the current position (if any)...
+        std::copy_n( byteData, overwrittenSize, mCurrentPosition );
+
+        /* ...and appending the remaining ones: unlike resize(...), insert(...) doesn't zero-fill the new bytes
+         * before copying them, and it grows the buffer geometrically. */
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        mBuffer.insert( mBuffer.end(), byteData + overwrittenSize, byteData + size );
     } catch ( ... ) {
         return E_OUTOFMEMORY;
     }
 
-    std::advance( mCurrentPosition, clamp_cast< std::ptrdiff_t >( size ) );
+    // Note: insert(...) might have invalidated the old mCurrentPosition iterator.
+    mCurrentPosition = mBuffer.begin() + oldPos + static_cast< index_t >( size );
 
     if ( processedSize != nullptr ) {
         *processedSize = size;
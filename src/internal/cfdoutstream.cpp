@@ -0,0 +1,208 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _WIN32
+
+#include "internal/cfdoutstream.hpp"
+#include "internal/util.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bit7z {
+
+// The size of the blocks that can be turned into holes (i.e., the usual size of a filesystem block).
+constexpr std::size_t kSparseBlockSize = 4096;
+
+/* Checking whether all the bytes are zero by comparing the data with itself shifted by one byte:
+ * this lets memcmp use its vectorized implementation, instead of checking one byte at a time. */
+inline auto is_zero_block( const byte_t* data, std::size_t size ) noexcept -> bool {
+    return size > 0 && data[ 0 ] == 0 && std::memcmp( data, data + 1, size - 1 ) == 0; // NOLINT(*-pointer-arithmetic)
+}
+
+CFdOutStream::CFdOutStream( int fileDescriptor, fs::path filePath )
+    : mFileDescriptor{ fileDescriptor },
+      mFilePath{ std::move( filePath ) },
+      mFailed{ false },
+      mSparse{ false },
+      mPreallocated{ false },
+      mPosition{ 0 },
+      mFileSize{ 0 } {
+    // Getting the current size of the file, which is then tracked by the stream.
+    struct stat fileStat{};
+    if ( ::fstat( mFileDescriptor, &fileStat ) == 0 ) {
+        mFileSize = static_cast< uint64_t >( fileStat.st_size );
+    }
+}
+
+CFdOutStream::~CFdOutStream() {
+    ::close( mFileDescriptor );
+}
+
+auto CFdOutStream::fileDescriptor() const noexcept -> int {
+    return mFileDescriptor;
+}
+
+auto CFdOutStream::path() const -> const fs::path& {
+    return mFilePath;
+}
+
+auto CFdOutStream::fail() const -> bool {
+    return mFailed;
+}
+
+auto CFdOutStream::preallocate( uint64_t size ) noexcept -> bool {
+#ifdef __linux__
+    if ( size == 0 ) {
+        return false;
+    }
+    mPreallocated = ::fallocate( mFileDescriptor, FALLOC_FL_KEEP_SIZE, 0, static_cast< off_t >( size ) ) == 0;
+    return mPreallocated;
+#else
+    (void)size;
+    return false;
+#endif
+}
+
+void CFdOutStream::setSparse( bool sparse ) noexcept {
+    mSparse = sparse;
+}
+
+auto CFdOutStream::writeData( const byte_t* data, std::size_t size ) noexcept -> bool {
+    while ( size > 0 ) {
+        const auto result = ::pwrite( mFileDescriptor, data, size, static_cast< off_t >( mPosition ) );
+        if ( result < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            return false;
+        }
+        data += result; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size -= static_cast< std::size_t >( result );
+        mPosition += static_cast< uint64_t >( result );
+    }
+    mFileSize = std::max( mFileSize, mPosition );
+    return true;
+}
+
+auto CFdOutStream::skipZeros( std::size_t size ) noexcept -> bool {
+    const auto offset = static_cast< off_t >( mPosition );
+    mPosition += size;
+    if ( mPosition > mFileSize ) { // Extending the file, so that the skipped zeros are part of it.
+        if ( ::ftruncate( mFileDescriptor, static_cast< off_t >( mPosition ) ) != 0 ) {
+            return false;
+        }
+        mFileSize = mPosition;
+    }
+#ifdef __linux__
+    if ( mPreallocated ) { // Deallocating the preallocated blocks that were skipped (now within the file size).
+        ::fallocate( mFileDescriptor,
+                     FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                     offset,
+                     static_cast< off_t >( size ) );
+    }
+#else
+    (void)offset;
+#endif
+    return true;
+}
+
+auto CFdOutStream::writeSparse( const byte_t* data, std::size_t size ) noexcept -> bool {
+    /* Splitting the data into blocks aligned to the file offset:
+     * consecutive blocks of zeros are skipped, while consecutive blocks of data are written at once.
+     * Note: mPosition is always the file offset of the start of the current run of blocks. */
+    std::size_t runStart = 0;
+    bool runIsZero = false;
+    const auto flushRun = [ this, data, &runStart, &runIsZero ]( std::size_t runEnd ) noexcept -> bool {
+        const auto runSize = runEnd - runStart;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const bool result = runIsZero ? skipZeros( runSize ) : writeData( data + runStart, runSize );
+        runStart = runEnd;
+        return result;
+    };
+
+    std::size_t blockStart = 0;
+    while ( blockStart < size ) {
+        const auto blockOffset = ( mPosition + ( blockStart - runStart ) ) % kSparseBlockSize;
+        const auto blockSize = std::min( kSparseBlockSize - static_cast< std::size_t >( blockOffset ), size - blockStart );
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const bool blockIsZero = blockSize == kSparseBlockSize && is_zero_block( data + blockStart, blockSize );
+        if ( blockIsZero != runIsZero && blockStart > runStart && !flushRun( blockStart ) ) {
+            return false;
+        }
+        runIsZero = blockIsZero;
+        blockStart += blockSize;
+    }
+    return blockStart == runStart || flushRun( blockStart );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFdOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    const auto* bytes = static_cast< const byte_t* >( data ); //-V2571
+    // Note: once a write failed, the file is incomplete, so the failure is sticky.
+    mFailed = mFailed || ( mSparse ? !writeSparse( bytes, size ) : !writeData( bytes, size ) );
+    if ( mFailed ) {
+        return HRESULT_FROM_WIN32( ERROR_WRITE_FAULT );
+    }
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFdOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mFileSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mPosition;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFdOutStream::SetSize( UInt64 newSize ) noexcept {
+    if ( ::ftruncate( mFileDescriptor, static_cast< off_t >( newSize ) ) != 0 ) {
+        return E_FAIL;
+    }
+    mFileSize = newSize;
+    return S_OK;
+}
+
+} // namespace bit7z
+
+#endif
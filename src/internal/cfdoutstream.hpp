@@ -0,0 +1,101 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CFDOUTSTREAM_HPP
+#define CFDOUTSTREAM_HPP
+
+#ifndef _WIN32
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An output stream writing to an already open file descriptor, which is owned (and closed) by the stream.
+ *
+ * The stream starts writing at the beginning of the file, and it keeps track of its position by itself
+ * (writing with pwrite), so that seeking never needs a system call.
+ */
+class CFdOutStream : public IOutStream, public CMyUnknownImp {
+    public:
+        /**
+         * @param fileDescriptor    the descriptor of the file opened for writing.
+         * @param filePath          the path of the file (used only for reporting errors).
+         */
+        CFdOutStream( int fileDescriptor, fs::path filePath );
+
+        CFdOutStream( const CFdOutStream& ) = delete;
+
+        CFdOutStream( CFdOutStream&& ) = delete;
+
+        auto operator=( const CFdOutStream& ) -> CFdOutStream& = delete;
+
+        auto operator=( CFdOutStream&& ) -> CFdOutStream& = delete;
+
+        MY_UNKNOWN_VIRTUAL_DESTRUCTOR( ~CFdOutStream() );
+
+        BIT7Z_NODISCARD auto fileDescriptor() const noexcept -> int;
+
+        BIT7Z_NODISCARD auto path() const -> const fs::path&;
+
+        BIT7Z_NODISCARD auto fail() const -> bool;
+
+        /**
+         * @brief Allocates the disk space for the given number of bytes, without changing the size of the file.
+         *
+         * @return true if the space was allocated, false otherwise (e.g., if not supported by the OS or filesystem).
+         */
+        auto preallocate( uint64_t size ) noexcept -> bool;
+
+        /**
+         * @brief Makes the stream skip the blocks of the file containing only zero bytes, turning them into holes.
+         */
+        void setSparse( bool sparse ) noexcept;
+
+        // IOutStream
+        BIT7Z_STDMETHOD( Write, void const* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        BIT7Z_STDMETHOD( SetSize, UInt64 newSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IOutStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        int mFileDescriptor;
+        fs::path mFilePath;
+        bool mFailed;
+        bool mSparse;
+        bool mPreallocated;
+        uint64_t mPosition; // Current position in the file.
+        uint64_t mFileSize; // Current size of the file.
+
+        auto writeData( const byte_t* data, std::size_t size ) noexcept -> bool;
+
+        auto skipZeros( std::size_t size ) noexcept -> bool;
+
+        auto writeSparse( const byte_t* data, std::size_t size ) noexcept -> bool;
+};
+
+}  // namespace bit7z
+
+#endif
+
+#endif // CFDOUTSTREAM_HPP
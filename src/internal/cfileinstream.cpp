@@ -14,8 +14,19 @@
 #include "internal/cfileinstream.hpp"
 #include "internal/stringutil.hpp"
 
+#ifndef _WIN32
+#include "internal/util.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace bit7z {
 
+#ifdef _WIN32
 CFileInStream::CFileInStream( const fs::path& filePath ) : CStdInStream( mFileStream ) {
     /* Disabling std::ifstream's buffering, as unbuffered IO gives better performance
      * with the block sizes read/written by 7-Zip.
@@ -39,5 +50,75 @@ void CFileInStream::openFile( const fs::path& filePath ) {
         throw BitException( "Failed to open the archive file", error, path_to_tstring( filePath ) );
     }
 }
+#else
+CFileInStream::CFileInStream( const fs::path& filePath ) : mCurrentPosition{ 0 }, mFileSize{ 0 } {
+    mFileDescriptor = ::open( filePath.c_str(), O_RDONLY | O_CLOEXEC ); // NOLINT(*-vararg)
+    if ( mFileDescriptor < 0 ) {
+        throw BitException( "Failed to open the archive file", last_error_code(), path_to_tstring( filePath ) );
+    }
+
+    struct stat fileStat{};
+    if ( ::fstat( mFileDescriptor, &fileStat ) != 0 ) {
+        const auto error = last_error_code();
+        ::close( mFileDescriptor );
+        throw BitException( "Failed to get the size of the archive file", error, path_to_tstring( filePath ) );
+    }
+    mFileSize = static_cast< uint64_t >( fileStat.st_size );
+}
+
+CFileInStream::~CFileInStream() {
+    ::close( mFileDescriptor );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFileInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    ssize_t result; // NOLINT(cppcoreguidelines-init-variables)
+    do {
+        result = ::pread( mFileDescriptor, data, size, static_cast< off_t >( mCurrentPosition ) );
+    } while ( result < 0 && errno == EINTR );
+    if ( result < 0 ) {
+        return HRESULT_FROM_WIN32( ERROR_READ_FAULT );
+    }
+    mCurrentPosition += static_cast< uint64_t >( result );
+
+    if ( processedSize != nullptr ) {
+        *processedSize = static_cast< UInt32 >( result );
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFileInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mFileSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+#endif
 
 } // namespace bit7z
\ No newline at end of file
@@ -10,14 +10,24 @@
 #ifndef CFILEINSTREAM_HPP
 #define CFILEINSTREAM_HPP
 
-#include <array>
-
 #include "bitdefines.hpp"
-#include "internal/cstdinstream.hpp"
 #include "internal/fs.hpp"
 
+#ifdef _WIN32
+#include "internal/cstdinstream.hpp"
+#else
+#include <cstdint>
+
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+#endif
+
 namespace bit7z {
 
+#ifdef _WIN32
 class CFileInStream : public CStdInStream {
     public:
         explicit CFileInStream( const fs::path& filePath );
@@ -27,6 +37,39 @@ class CFileInStream : public CStdInStream {
     private:
         fs::ifstream mFileStream;
 };
+#else
+/**
+ * An input stream reading a file through its descriptor with pread, keeping track of the position by itself,
+ * so that seeking never needs a system call.
+ */
+class CFileInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        explicit CFileInStream( const fs::path& filePath );
+
+        CFileInStream( const CFileInStream& ) = delete;
+
+        CFileInStream( CFileInStream&& ) = delete;
+
+        auto operator=( const CFileInStream& ) -> CFileInStream& = delete;
+
+        auto operator=( CFileInStream&& ) -> CFileInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CFileInStream() );
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        int mFileDescriptor;
+        uint64_t mCurrentPosition;
+        uint64_t mFileSize;
+};
+#endif
 
 }  // namespace bit7z
 
@@ -0,0 +1,184 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "internal/cfilemapinstream.hpp"
+
+#include "bitexception.hpp"
+#include "internal/stringutil.hpp"
+#include "internal/util.hpp"
+
+#include <cstring>
+#include <limits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bit7z {
+
+#ifdef _WIN32
+CFileMapInStream::CFileMapInStream( const fs::path& filePath, bool /*sequentialAccess*/ )
+    : mData{ nullptr }, mSize{ 0 }, mCurrentPosition{ 0 }, mMappingHandle{ nullptr } {
+    mFileHandle = ::CreateFileW( filePath.c_str(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL,
+                                 nullptr );
+    if ( mFileHandle == INVALID_HANDLE_VALUE ) {
+        throw BitException( "Failed to open the archive file", last_error_code(), path_to_tstring( filePath ) );
+    }
+
+    LARGE_INTEGER fileSize{};
+    if ( ::GetFileSizeEx( mFileHandle, &fileSize ) == FALSE ) {
+        const auto error = last_error_code();
+        ::CloseHandle( mFileHandle );
+        throw BitException( "Failed to get the size of the archive file", error, path_to_tstring( filePath ) );
+    }
+    mSize = static_cast< uint64_t >( fileSize.QuadPart );
+    if ( mSize == 0 ) { // Empty files cannot be mapped.
+        return;
+    }
+    if ( mSize > std::numeric_limits< std::size_t >::max() ) {
+        ::CloseHandle( mFileHandle );
+        throw BitException( "The archive file is too big to be mapped in memory",
+                            std::make_error_code( std::errc::file_too_large ), path_to_tstring( filePath ) );
+    }
+
+    mMappingHandle = ::CreateFileMappingW( mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( mMappingHandle != nullptr ) {
+        mData = static_cast< const byte_t* >( ::MapViewOfFile( mMappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+    }
+    if ( mData == nullptr ) {
+        const auto error = last_error_code();
+        if ( mMappingHandle != nullptr ) {
+            ::CloseHandle( mMappingHandle );
+        }
+        ::CloseHandle( mFileHandle );
+        throw BitException( "Failed to map the archive file", error, path_to_tstring( filePath ) );
+    }
+}
+
+CFileMapInStream::~CFileMapInStream() {
+    if ( mData != nullptr ) {
+        ::UnmapViewOfFile( mData );
+    }
+    if ( mMappingHandle != nullptr ) {
+        ::CloseHandle( mMappingHandle );
+    }
+    ::CloseHandle( mFileHandle );
+}
+#else
+CFileMapInStream::CFileMapInStream( const fs::path& filePath, bool sequentialAccess )
+    : mData{ nullptr }, mSize{ 0 }, mCurrentPosition{ 0 } {
+    const int fileDescriptor = ::open( filePath.c_str(), O_RDONLY | O_CLOEXEC ); // NOLINT(*-vararg)
+    if ( fileDescriptor < 0 ) {
+        throw BitException( "Failed to open the archive file", last_error_code(), path_to_tstring( filePath ) );
+    }
+
+    struct stat fileStat{};
+    if ( ::fstat( fileDescriptor, &fileStat ) != 0 ) {
+        const auto error = last_error_code();
+        ::close( fileDescriptor );
+        throw BitException( "Failed to get the size of the archive file", error, path_to_tstring( filePath ) );
+    }
+    mSize = static_cast< uint64_t >( fileStat.st_size );
+    if ( mSize == 0 ) { // Empty files cannot be mapped.
+        ::close( fileDescriptor );
+        return;
+    }
+    if ( mSize > std::numeric_limits< std::size_t >::max() ) {
+        ::close( fileDescriptor );
+        throw BitException( "The archive file is too big to be mapped in memory",
+                            std::make_error_code( std::errc::file_too_large ), path_to_tstring( filePath ) );
+    }
+
+    void* mapping = ::mmap( nullptr, static_cast< std::size_t >( mSize ), PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+    // Note: the mapping keeps a reference to the file, so we can close the file descriptor.
+    ::close( fileDescriptor );
+    if ( mapping == MAP_FAILED ) { // NOLINT(*-cstyle-cast, *-pro-type-cstyle-cast)
+        throw BitException( "Failed to map the archive file", last_error_code(), path_to_tstring( filePath ) );
+    }
+    // Advising the kernel on the access pattern, so that it can tune the read-ahead of the mapped pages.
+    ::madvise( mapping, static_cast< std::size_t >( mSize ), sequentialAccess ? MADV_SEQUENTIAL : MADV_NORMAL );
+    mData = static_cast< const byte_t* >( mapping );
+}
+
+CFileMapInStream::~CFileMapInStream() {
+    if ( mData != nullptr ) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        ::munmap( const_cast< byte_t* >( mData ), static_cast< std::size_t >( mSize ) );
+    }
+}
+#endif
+
+auto CFileMapInStream::size() const noexcept -> uint64_t {
+    return mSize;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFileMapInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 || mCurrentPosition >= mSize ) {
+        return S_OK;
+    }
+
+    const uint64_t remaining = mSize - mCurrentPosition;
+    if ( size > remaining ) {
+        size = static_cast< UInt32 >( remaining );
+    }
+    std::memcpy( data, mData + mCurrentPosition, size ); //-V2571
+    mCurrentPosition += size;
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CFileMapInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
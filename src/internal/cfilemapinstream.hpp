@@ -0,0 +1,85 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CFILEMAPINSTREAM_HPP
+#define CFILEMAPINSTREAM_HPP
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+#include <cstddef>
+#include <limits>
+
+namespace bit7z {
+
+/**
+ * @return whether the given file can be mapped in the address space of the process
+ *         (e.g., on 32-bit targets, files bigger than 4 GiB cannot).
+ */
+inline auto can_map_file( const fs::path& filePath ) -> bool {
+    if ( sizeof( std::size_t ) >= sizeof( uint64_t ) ) {
+        return true;
+    }
+    std::error_code error;
+    const uint64_t fileSize = fs::file_size( filePath, error );
+    return !error && fileSize <= std::numeric_limits< std::size_t >::max();
+}
+
+/**
+ * An input stream reading a file through a read-only memory mapping of its whole content,
+ * so that each Read is just a copy from the mapped pages.
+ */
+class CFileMapInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        /**
+         * @param filePath          the path to the file to be mapped.
+         * @param sequentialAccess  whether the file is expected to be read sequentially
+         *                          (used to advise the OS on the access pattern to the mapped pages).
+         */
+        CFileMapInStream( const fs::path& filePath, bool sequentialAccess );
+
+        CFileMapInStream( const CFileMapInStream& ) = delete;
+
+        CFileMapInStream( CFileMapInStream&& ) = delete;
+
+        auto operator=( const CFileMapInStream& ) -> CFileMapInStream& = delete;
+
+        auto operator=( CFileMapInStream&& ) -> CFileMapInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CFileMapInStream() );
+
+        BIT7Z_NODISCARD auto size() const noexcept -> uint64_t;
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        const byte_t* mData;
+        uint64_t mSize;
+        uint64_t mCurrentPosition;
+#ifdef _WIN32
+        HANDLE mFileHandle;
+        HANDLE mMappingHandle;
+#endif
+};
+
+}  // namespace bit7z
+
+#endif // CFILEMAPINSTREAM_HPP
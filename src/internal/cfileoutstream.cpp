@@ -16,8 +16,13 @@
 #include "internal/cfileoutstream.hpp"
 #include "internal/stringutil.hpp"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
 namespace bit7z {
 
+#ifdef _WIN32
 CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways )
     : CStdOutStream( mFileStream ), mFilePath{ std::move( filePath ) } {
     std::error_code error;
@@ -62,5 +67,26 @@ STDMETHODIMP CFileOutStream::SetSize( UInt64 newSize ) noexcept {
 auto CFileOutStream::path() const -> const fs::path& {
     return mFilePath;
 }
+#else
+// The same permissions used by std::ofstream for the files it creates (before applying the umask).
+constexpr auto kOutputFileMode = 0666;
+
+inline auto open_output_file( const fs::path& filePath, bool createAlways ) -> int {
+    // Note: O_EXCL makes the check for the existence of the file and its creation a single atomic operation.
+    const int openFlags = O_WRONLY | O_CREAT | O_CLOEXEC | ( createAlways ? O_TRUNC : O_EXCL );
+    const int fileDescriptor = ::open( filePath.c_str(), openFlags, kOutputFileMode ); // NOLINT(*-vararg)
+    if ( fileDescriptor < 0 ) {
+        const auto error = last_error_code();
+        const bool fileExists = error == std::errc::file_exists;
+        throw BitException( fileExists ? "Failed to create the output file" : "Failed to open the output file",
+                            error,
+                            path_to_tstring( filePath ) );
+    }
+    return fileDescriptor;
+}
+
+CFileOutStream::CFileOutStream( const fs::path& filePath, bool createAlways )
+    : CFdOutStream( open_output_file( filePath, createAlways ), filePath ) {}
+#endif
 
 } // namespace bit7z
\ No newline at end of file
@@ -10,14 +10,18 @@
 #ifndef CFILEOUTSTREAM_HPP
 #define CFILEOUTSTREAM_HPP
 
-#include <array>
-
 #include "bitdefines.hpp"
-#include "internal/cstdoutstream.hpp"
 #include "internal/fs.hpp"
 
+#ifdef _WIN32
+#include "internal/cstdoutstream.hpp"
+#else
+#include "internal/cfdoutstream.hpp"
+#endif
+
 namespace bit7z {
 
+#ifdef _WIN32
 class CFileOutStream : public CStdOutStream {
     public:
         explicit CFileOutStream( fs::path filePath, bool createAlways = false );
@@ -32,6 +36,15 @@ class CFileOutStream : public CStdOutStream {
         fs::path mFilePath;
         fs::ofstream mFileStream;
 };
+#else
+/**
+ * An output stream creating the file at the given path, and writing it through its file descriptor.
+ */
+class CFileOutStream : public CFdOutStream {
+    public:
+        explicit CFileOutStream( const fs::path& filePath, bool createAlways = false );
+};
+#endif
 
 }  // namespace bit7z
 
@@ -15,54 +15,63 @@
 #endif
 
 #include "internal/cmultivolumeinstream.hpp"
+#include "bitexception.hpp"
 #include "internal/util.hpp"
 #include "internal/fsutil.hpp"
 
+#include <algorithm>
+#include <new>
+
 namespace bit7z {
 
-CMultiVolumeInStream::CMultiVolumeInStream( const fs::path& firstVolume ) : mCurrentPosition{ 0 }, mTotalSize{ 0 } {
-    constexpr size_t kVolumeDigits = 3u;
-    size_t volumeIndex = 1u;
-    fs::path volumePath = firstVolume;
-    while ( fs::exists( volumePath ) ) {
-        addVolume( volumePath );
-
-        ++volumeIndex;
-        tstring volumeExt = to_tstring( volumeIndex );
-        if ( volumeExt.length() < kVolumeDigits ) {
-            volumeExt.insert( volumeExt.begin(), kVolumeDigits - volumeExt.length(), BIT7Z_STRING( '0' ) );
-        }
-        volumePath.replace_extension( volumeExt );
-
-        // TODO: Avoid keeping all the volumes streams open
-        constexpr auto kOpenedFilesThreshold = 500;
-        if ( volumeIndex == kOpenedFilesThreshold ) {
-            // Note: we use == to avoid increasing the limit more than once;
-            // the volumeIndex is always increasing, so it is not an issue here.
-            filesystem::fsutil::increase_opened_files_limit();
-        }
+CMultiVolumeInStream::CMultiVolumeInStream( const fs::path& firstVolume,
+                                            FileAccessMode accessMode,
+                                            std::size_t maxOpenVolumes )
+    : mCurrentPosition{ 0 }, mTotalSize{ 0 }, mMaxOpenVolumes{ std::max< std::size_t >( maxOpenVolumes, 1 ) } {
+    for ( const auto& volumePath : filesystem::fsutil::find_volumes( firstVolume ) ) {
+        addVolume( volumePath, accessMode );
     }
 }
 
-auto CMultiVolumeInStream::currentVolume() -> const CMyComPtr< CVolumeInStream >& {
+auto CMultiVolumeInStream::currentVolume() const -> std::size_t {
     size_t left = 0;
     size_t right = mVolumes.size();
     size_t midpoint = right / 2;
     while ( true ) {
-        auto& volume = mVolumes[ midpoint ];
+        const auto& volume = mVolumes[ midpoint ];
         if ( mCurrentPosition < volume->globalOffset() ) {
             right = midpoint;
         } else if ( mCurrentPosition >= volume->globalOffset() + volume->size() ) {
             left = midpoint + 1;
         } else {
-            return volume;
+            return midpoint;
         }
         midpoint = ( left + right ) / 2;
     }
 }
 
+auto CMultiVolumeInStream::openVolume( std::size_t volumeIndex ) -> CVolumeInStream& {
+    auto& volume = *mVolumes[ volumeIndex ];
+    if ( !mOpenVolumes.empty() && mOpenVolumes.back() == volumeIndex ) { // Still reading the same volume.
+        return volume;
+    }
+
+    const auto openVolume = std::find( mOpenVolumes.begin(), mOpenVolumes.end(), volumeIndex );
+    if ( openVolume != mOpenVolumes.end() ) {
+        mOpenVolumes.erase( openVolume );
+    } else {
+        if ( mOpenVolumes.size() >= mMaxOpenVolumes ) { // Closing the least recently used volume.
+            mVolumes[ mOpenVolumes.front() ]->close();
+            mOpenVolumes.erase( mOpenVolumes.begin() );
+        }
+        volume.open();
+    }
+    mOpenVolumes.push_back( volumeIndex );
+    return volume;
+}
+
 COM_DECLSPEC_NOTHROW
-STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept try {
     if ( processedSize != nullptr ) {
         *processedSize = 0;
     }
@@ -71,24 +80,23 @@ STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* proces
         return S_OK;
     }
 
-    const auto& volume = currentVolume();
-    UInt64 localOffset = mCurrentPosition - volume->globalOffset();
-    HRESULT result = volume->Seek( static_cast< Int64 >( localOffset ), STREAM_SEEK_SET, &localOffset );
-    if ( result != S_OK ) {
-        return result;
-    }
-
-    const uint64_t remaining = volume->size() - localOffset;
+    auto& volume = openVolume( currentVolume() );
+    const uint64_t localOffset = mCurrentPosition - volume.globalOffset();
+    const uint64_t remaining = volume.size() - localOffset;
     if ( size > remaining ) {
         size = static_cast< UInt32 >( remaining );
     }
-    result = volume->Read( data, size, &size );
+    const HRESULT result = volume.readAt( localOffset, data, size, &size );
     mCurrentPosition += size;
 
     if ( processedSize != nullptr ) {
         *processedSize = size;
     }
     return result;
+} catch ( const BitException& ex ) {
+    return ex.hresultCode();
+} catch ( const std::bad_alloc& ) {
+    return E_OUTOFMEMORY;
 }
 
 COM_DECLSPEC_NOTHROW
@@ -116,13 +124,13 @@ STDMETHODIMP CMultiVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64
     return S_OK;
 }
 
-void CMultiVolumeInStream::addVolume( const fs::path& volumePath ) {
+void CMultiVolumeInStream::addVolume( const fs::path& volumePath, FileAccessMode accessMode ) {
     uint64_t globalOffset = 0;
     if ( !mVolumes.empty() ) {
         const auto& lastStream = mVolumes.back();
         globalOffset = lastStream->globalOffset() + lastStream->size();
     }
-    mVolumes.emplace_back( make_com< CVolumeInStream >( volumePath, globalOffset ) );
+    mVolumes.emplace_back( make_com< CVolumeInStream >( volumePath, globalOffset, accessMode ) );
     mTotalSize += mVolumes.back()->size();
 }
 
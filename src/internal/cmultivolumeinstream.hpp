@@ -10,6 +10,9 @@
 #ifndef CMULTIVOLUMEINSTREAM_HPP
 #define CMULTIVOLUMEINSTREAM_HPP
 
+#include <cstddef>
+#include <vector>
+
 #include "internal/com.hpp"
 #include "internal/cvolumeinstream.hpp"
 #include "internal/macros.hpp"
@@ -25,12 +28,23 @@ class CMultiVolumeInStream : public IInStream, public CMyUnknownImp {
 
         std::vector< CMyComPtr< CVolumeInStream > > mVolumes;
 
-        auto currentVolume() -> const CMyComPtr< CVolumeInStream >&;
+        // The indices of the volumes currently open, from the least to the most recently used one.
+        std::vector< std::size_t > mOpenVolumes;
+        std::size_t mMaxOpenVolumes;
+
+        auto currentVolume() const -> std::size_t;
+
+        auto openVolume( std::size_t volumeIndex ) -> CVolumeInStream&;
 
-        void addVolume( const fs::path& volumePath );
+        void addVolume( const fs::path& volumePath, FileAccessMode accessMode );
 
     public:
-        explicit CMultiVolumeInStream( const fs::path& firstVolume );
+        /**
+         * @param firstVolume       the path of the first volume (e.g., "archive.7z.001").
+         * @param accessMode        how the volume files must be read.
+         * @param maxOpenVolumes    the maximum number of volume files kept open at the same time.
+         */
+        CMultiVolumeInStream( const fs::path& firstVolume, FileAccessMode accessMode, std::size_t maxOpenVolumes );
 
         CMultiVolumeInStream( const CMultiVolumeInStream& ) = delete;
 
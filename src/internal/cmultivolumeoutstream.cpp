@@ -10,22 +10,83 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <limits>
+#include <new>
 #include <utility>
 
 #include "bitexception.hpp"
 #include "internal/cmultivolumeoutstream.hpp"
 #include "internal/fsutil.hpp"
+#include "internal/stringutil.hpp"
 #include "internal/util.hpp"
 
 namespace bit7z {
 
-CMultiVolumeOutStream::CMultiVolumeOutStream( uint64_t volSize, fs::path archiveName )
+CMultiVolumeOutStream::CMultiVolumeOutStream( uint64_t volSize, fs::path archiveName, VolumeCallback volumeCallback )
     : mMaxVolumeSize( volSize ),
       mVolumePrefix( std::move( archiveName ) ),
       mCurrentVolumeIndex( 0 ),
       mCurrentVolumeOffset( 0 ),
       mAbsoluteOffset( 0 ),
-      mFullSize( 0 ) {}
+      mFullSize( 0 ),
+      // Until the archive handler tells us otherwise, the whole output archive might still be modified.
+      mRestrictionBegin( 0 ),
+      mRestrictionEnd( ( std::numeric_limits< uint64_t >::max )() ),
+      mVolumeCallback( std::move( volumeCallback ) ) {}
+
+auto CMultiVolumeOutStream::completeVolume( size_t volumeIndex ) -> HRESULT try {
+    const fs::path volumePath = mVolumes[ volumeIndex ]->path();
+    mVolumes[ volumeIndex ].Release(); // Closing the volume file.
+    if ( mVolumeCallback ) {
+        mVolumeCallback( path_to_tstring( volumePath ) );
+    }
+    return S_OK;
+} catch ( const BitException& ex ) {
+    return ex.hresultCode();
+} catch ( const std::bad_alloc& ) {
+    return E_OUTOFMEMORY;
+} catch ( ... ) {
+    // Any other exception thrown by the volume callback is rethrown after the compression is stopped.
+    mVolumeCallbackException = std::current_exception();
+    return E_FAIL;
+}
+
+auto CMultiVolumeOutStream::volumeCallbackException() const noexcept -> std::exception_ptr {
+    return mVolumeCallbackException;
+}
+
+auto CMultiVolumeOutStream::completeVolumes() -> HRESULT {
+    const bool isRestricted = mRestrictionBegin < mRestrictionEnd;
+    auto openVolume = mOpenVolumes.begin();
+    while ( openVolume != mOpenVolumes.end() ) {
+        const uint64_t volumeBegin = static_cast< uint64_t >( *openVolume ) * mMaxVolumeSize;
+        const uint64_t volumeEnd = volumeBegin + mMaxVolumeSize;
+        if ( volumeEnd > mFullSize ) {
+            /* We did not move past this volume yet (and hence, neither past the following ones). */
+            break;
+        }
+
+        const bool isComplete = mVolumes[ *openVolume ]->currentSize() == mMaxVolumeSize;
+        const bool isModifiable = isRestricted && volumeBegin < mRestrictionEnd && volumeEnd > mRestrictionBegin;
+        if ( !isComplete || isModifiable ) {
+            ++openVolume;
+            continue;
+        }
+        const auto volumeIndex = *openVolume;
+        openVolume = mOpenVolumes.erase( openVolume );
+        RINOK( completeVolume( volumeIndex ) )
+    }
+    return S_OK;
+}
+
+auto CMultiVolumeOutStream::finish() noexcept -> HRESULT {
+    while ( !mOpenVolumes.empty() ) {
+        const auto volumeIndex = mOpenVolumes.front();
+        mOpenVolumes.erase( mOpenVolumes.begin() );
+        RINOK( completeVolume( volumeIndex ) )
+    }
+    return S_OK;
+}
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
@@ -38,7 +99,7 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
 
     while ( mCurrentVolumeIndex >= mVolumes.size() ) {
         /* The current volume stream still doesn't exist, so we need to create it. */
-        tstring name = to_tstring( static_cast< uint64_t >( mCurrentVolumeIndex ) + 1 );
+        tstring name = to_tstring( static_cast< uint64_t >( mVolumes.size() ) + 1 );
         if ( name.length() < 3 ) {
             name.insert( 0, 3 - name.length(), BIT7Z_STRING( '0' ) );
         }
@@ -46,15 +107,17 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
         fs::path volumePath = mVolumePrefix;
         volumePath += BIT7Z_STRING( "." ) + name;
         try {
-            // TODO: Avoid keeping all the volumes streams open
+            /* Note: the volumes are kept open until they are completed, which happens only if the archive handler
+             * tells us which parts of the archive it might still modify (i.e., via the SetRestriction method). */
             constexpr auto kOpenedFilesThreshold = 500;
-            if ( mCurrentVolumeIndex == kOpenedFilesThreshold ) {
-                // Since we have created many volumes, it is likely we'll keep creating more.
+            if ( mOpenVolumes.size() == kOpenedFilesThreshold ) {
+                // Since we have many volumes open, it is likely we'll keep creating more.
                 // Hence, we increase the limit to the number of files that can be opened by the current process
                 // to avoid problems in the future.
                 filesystem::fsutil::increase_opened_files_limit();
             }
             mVolumes.emplace_back( make_com< CVolumeOutStream >( volumePath ) );
+            mOpenVolumes.push_back( mVolumes.size() - 1 );
         } catch ( const BitException& ex ) {
             return ex.nativeCode();
         }
@@ -62,6 +125,10 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
 
     /* Getting the current volume stream. */
     const CMyComPtr< CVolumeOutStream >& volume = mVolumes[ mCurrentVolumeIndex ];
+    if ( volume == nullptr ) {
+        /* The volume was already completed, so it must not be modified anymore. */
+        return E_FAIL;
+    }
 
     if ( mCurrentVolumeOffset != volume->currentOffset() ) {
         /* The offset we must write to is different from the last offset we wrote to. */
@@ -97,6 +164,7 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
         /* We reached the max size for the current volume, so we need to continue on the next one. */
         ++mCurrentVolumeIndex;
         mCurrentVolumeOffset = 0;
+        return completeVolumes();
     }
     return S_OK;
 }
@@ -129,16 +197,22 @@ STDMETHODIMP CMultiVolumeOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt6
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CMultiVolumeOutStream::SetSize( UInt64 newSize ) noexcept {
-    for ( auto& volume : mVolumes ) {
-        if ( newSize < volume->currentSize() ) {
-            RINOK( volume->SetSize( newSize ) )
-            break;
+    // Index of the volume that will contain the new end of the archive.
+    const auto lastVolume = static_cast< size_t >( newSize / mMaxVolumeSize );
+    for ( auto volumeIndex = lastVolume; volumeIndex < mVolumes.size(); ++volumeIndex ) {
+        if ( mVolumes[ volumeIndex ] == nullptr ) {
+            /* The volume was already completed, so it must not be modified anymore. */
+            return E_FAIL;
         }
-        newSize -= volume->currentSize();
     }
-    while ( !mVolumes.empty() ) {
+
+    if ( lastVolume < mVolumes.size() ) {
+        RINOK( mVolumes[ lastVolume ]->SetSize( newSize % mMaxVolumeSize ) )
+    }
+    while ( mVolumes.size() > lastVolume + 1 ) {
         const fs::path volumePath = mVolumes.back()->path();
         mVolumes.pop_back();
+        mOpenVolumes.pop_back();
         std::error_code error;
         fs::remove( volumePath, error );
         if ( error ) {
@@ -151,4 +225,14 @@ STDMETHODIMP CMultiVolumeOutStream::SetSize( UInt64 newSize ) noexcept {
     return S_OK;
 }
 
-} // namespace bit7z
\ No newline at end of file
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CMultiVolumeOutStream::SetRestriction( UInt64 begin, UInt64 end ) noexcept {
+    if ( begin > end ) {
+        return E_FAIL;
+    }
+    mRestrictionBegin = begin;
+    mRestrictionEnd = end;
+    return completeVolumes();
+}
+
+} // namespace bit7z
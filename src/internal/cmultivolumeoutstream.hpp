@@ -13,7 +13,9 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <exception>
 
+#include "bitabstractarchivecreator.hpp"
 #include "internal/com.hpp"
 #include "internal/guiddef.hpp"
 #include "internal/cvolumeoutstream.hpp"
@@ -26,7 +28,14 @@ using std::wstring;
 
 namespace bit7z {
 
-class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp {
+/* Interface used by the archive handlers of 7-zip (since v23.01) to tell the output stream which region of the
+ * output archive might still be modified (i.e., [begin, end), or nothing if begin == end).
+ * Note: we declare it here, so that it is available also when using the source code of previous 7-zip versions. */
+struct IStreamSetRestriction : public IUnknown {
+    STDMETHOD( SetRestriction )( UInt64 begin, UInt64 end ) PURE;
+};
+
+class CMultiVolumeOutStream final : public IOutStream, public IStreamSetRestriction, public CMyUnknownImp {
         // Size of a single volume.
         uint64_t mMaxVolumeSize;
 
@@ -45,10 +54,27 @@ class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp {
         // Total size of the output archive (sum of the volumes' sizes).
         uint64_t mFullSize;
 
+        // The region of the output archive that might still be modified by the archive handler.
+        uint64_t mRestrictionBegin;
+        uint64_t mRestrictionEnd;
+
+        // The volume streams created so far; the streams of the completed volumes are released (i.e., nullptr).
         vector< CMyComPtr< CVolumeOutStream > > mVolumes;
 
+        // The indices of the volumes that are not completed yet, in increasing order.
+        vector< size_t > mOpenVolumes;
+
+        VolumeCallback mVolumeCallback;
+
+        // The exception thrown by the volume callback, if any (to be rethrown once the compression is stopped).
+        std::exception_ptr mVolumeCallbackException;
+
+        auto completeVolume( size_t volumeIndex ) -> HRESULT;
+
+        auto completeVolumes() -> HRESULT;
+
     public:
-        CMultiVolumeOutStream( uint64_t volSize, fs::path archiveName );
+        CMultiVolumeOutStream( uint64_t volSize, fs::path archiveName, VolumeCallback volumeCallback = {} );
 
         CMultiVolumeOutStream( const CMultiVolumeOutStream& ) = delete;
 
@@ -60,6 +86,18 @@ class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp {
 
         MY_UNKNOWN_DESTRUCTOR( ~CMultiVolumeOutStream() ) = default;
 
+        /**
+         * @brief Completes all the volumes that were not completed yet (to be called after the archive was written).
+         *
+         * @return S_OK if the volumes were completed successfully, an error code otherwise.
+         */
+        auto finish() noexcept -> HRESULT;
+
+        /**
+         * @return the exception thrown by the volume callback, if any.
+         */
+        BIT7Z_NODISCARD auto volumeCallbackException() const noexcept -> std::exception_ptr;
+
         // IOutStream
         BIT7Z_STDMETHOD( Write, const void* data, UInt32 size, UInt32* processedSize );
 
@@ -67,8 +105,11 @@ class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp {
 
         BIT7Z_STDMETHOD( SetSize, UInt64 newSize );
 
+        // IStreamSetRestriction
+        BIT7Z_STDMETHOD( SetRestriction, UInt64 begin, UInt64 end );
+
         // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
-        MY_UNKNOWN_IMP1( IOutStream ) //-V2507 //-V2511 //-V835
+        MY_UNKNOWN_IMP2( IOutStream, IStreamSetRestriction ) //-V2507 //-V2511 //-V835
 };
 
 }  // namespace bit7z
@@ -45,6 +45,10 @@
 #define MY_UNKNOWN_IMP3 Z7_COM_UNKNOWN_IMP_3
 #endif
 
+#ifndef MY_UNKNOWN_IMP2 // 7-zip 23.01+
+#define MY_UNKNOWN_IMP2 Z7_COM_UNKNOWN_IMP_2
+#endif
+
 #ifndef MY_UNKNOWN_IMP1 // 7-zip 23.01+
 #define MY_UNKNOWN_IMP1 Z7_COM_UNKNOWN_IMP_1
 #endif
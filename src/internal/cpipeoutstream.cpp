@@ -0,0 +1,46 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/cpipeoutstream.hpp"
+
+#include <system_error>
+
+namespace bit7z {
+
+CPipeOutStream::CPipeOutStream( ItemPipe& pipe ) : mPipe( pipe ) {}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CPipeOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( data == nullptr || size == 0 ) {
+        return E_FAIL;
+    }
+
+    // Note: write(...) blocks until the reader consumed enough data, and fails only if the reader was closed.
+    try {
+        if ( !mPipe.write( static_cast< const byte_t* >( data ), size ) ) { //-V2571
+            return E_ABORT;
+        }
+    } catch ( const std::system_error& ) {
+        return E_FAIL;
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,48 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CPIPEOUTSTREAM_HPP
+#define CPIPEOUTSTREAM_HPP
+
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/itempipe.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+class CPipeOutStream final : public ISequentialOutStream, public CMyUnknownImp {
+    public:
+        explicit CPipeOutStream( ItemPipe& pipe );
+
+        CPipeOutStream( const CPipeOutStream& ) = delete;
+
+        CPipeOutStream( CPipeOutStream&& ) = delete;
+
+        auto operator=( const CPipeOutStream& ) -> CPipeOutStream& = delete;
+
+        auto operator=( CPipeOutStream&& ) -> CPipeOutStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CPipeOutStream() ) = default;
+
+        // ISequentialOutStream
+        BIT7Z_STDMETHOD( Write, const void* data, UInt32 size, UInt32* processedSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( ISequentialOutStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        ItemPipe& mPipe;
+};
+
+}  // namespace bit7z
+
+#endif // CPIPEOUTSTREAM_HPP
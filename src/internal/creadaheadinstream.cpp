@@ -0,0 +1,251 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "internal/creadaheadinstream.hpp"
+
+#include "bitexception.hpp"
+#include "internal/util.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace bit7z {
+
+// The number of consecutive sequential reads after which the stream starts reading ahead.
+constexpr uint32_t kSequentialReadsThreshold = 2;
+
+CReadAheadInStream::CReadAheadInStream( CMyComPtr< IInStream > stream, std::size_t blockSize, std::size_t blocksCount )
+    : mStream{ std::move( stream ) },
+      mBlockSize{ std::max< std::size_t >( blockSize, 1 ) },
+      mStreamSize{ 0 },
+      mCurrentPosition{ 0 },
+      mLastReadEnd{ 0 },
+      mSequentialReads{ 0 },
+      mBlocks( std::max< std::size_t >( blocksCount, 1 ), Block{ 0, 0, false, S_OK, {} } ),
+      mNextBlockOffset{ 0 },
+      mReading{ false },
+      mStopped{ false } {
+    const HRESULT result = mStream->Seek( 0, STREAM_SEEK_END, &mStreamSize );
+    if ( result != S_OK ) {
+        throw BitException( "Failed to get the size of the input stream", make_hresult_code( result ) );
+    }
+    mFreeBlocks.reserve( mBlocks.size() );
+    for ( std::size_t index = mBlocks.size(); index > 0; --index ) {
+        mFreeBlocks.push_back( index - 1 );
+    }
+    mReader = std::thread( [this]() { readBlocks(); } );
+}
+
+CReadAheadInStream::~CReadAheadInStream() {
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        mStopped = true;
+        mReaderCondition.notify_all();
+    }
+    if ( mReader.joinable() ) {
+        mReader.join();
+    }
+}
+
+void CReadAheadInStream::readBlocks() {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    while ( true ) {
+        // The blocks are read in the order they were scheduled (i.e., by offset).
+        auto nextBlock = mScheduledBlocks.cend();
+        mReaderCondition.wait( lock, [this, &nextBlock]() {
+            nextBlock = std::find_if( mScheduledBlocks.cbegin(), mScheduledBlocks.cend(),
+                                      [this]( std::size_t index ) { return !mBlocks[ index ].ready; } );
+            return mStopped || nextBlock != mScheduledBlocks.cend();
+        } );
+        if ( mStopped ) {
+            return;
+        }
+
+        // Note: the block is not touched by the consumer thread until it is ready.
+        Block& block = mBlocks[ *nextBlock ];
+        mReading = true;
+        lock.unlock();
+
+        HRESULT result = S_OK;
+        std::size_t blockSize = 0;
+        try {
+            block.data.resize( mBlockSize );
+        } catch ( ... ) {
+            result = E_OUTOFMEMORY;
+        }
+        if ( result == S_OK ) {
+            result = mStream->Seek( static_cast< Int64 >( block.offset ), STREAM_SEEK_SET, nullptr );
+        }
+        while ( result == S_OK && blockSize < mBlockSize ) {
+            UInt32 readSize = 0;
+            result = mStream->Read( &block.data[ blockSize ], clamp_cast< UInt32 >( mBlockSize - blockSize ), &readSize );
+            if ( readSize == 0 ) {
+                break;
+            }
+            blockSize += readSize;
+        }
+
+        lock.lock();
+        block.size = blockSize;
+        block.result = result;
+        block.ready = true;
+        mReading = false;
+        mConsumerCondition.notify_all();
+    }
+}
+
+void CReadAheadInStream::scheduleBlocks( std::unique_lock< std::mutex >& /*lock*/ ) {
+    if ( mScheduledBlocks.empty() ) {
+        mNextBlockOffset = mCurrentPosition;
+    }
+    bool scheduled = false;
+    while ( !mFreeBlocks.empty() && mNextBlockOffset < mStreamSize ) {
+        const auto index = mFreeBlocks.back();
+        mFreeBlocks.pop_back();
+
+        Block& block = mBlocks[ index ];
+        block.offset = mNextBlockOffset;
+        block.size = 0;
+        block.ready = false;
+        block.result = S_OK;
+        mScheduledBlocks.push_back( index );
+        mNextBlockOffset += mBlockSize;
+        scheduled = true;
+    }
+    if ( scheduled ) {
+        mReaderCondition.notify_all();
+    }
+}
+
+void CReadAheadInStream::cancelReadAhead( std::unique_lock< std::mutex >& lock ) {
+    mConsumerCondition.wait( lock, [this]() { return !mReading; } );
+    mFreeBlocks.insert( mFreeBlocks.end(), mScheduledBlocks.cbegin(), mScheduledBlocks.cend() );
+    mScheduledBlocks.clear();
+}
+
+auto CReadAheadInStream::readBuffered( byte_t* data, UInt32 size, std::unique_lock< std::mutex >& lock ) -> UInt32 {
+    UInt32 processedSize = 0;
+    while ( processedSize < size && !mScheduledBlocks.empty() ) {
+        const uint64_t position = mCurrentPosition + processedSize;
+        const Block& block = mBlocks[ mScheduledBlocks.front() ];
+        if ( position < block.offset || position >= mNextBlockOffset ) { // Outside the read-ahead blocks.
+            break;
+        }
+
+        // Since the blocks are read in order, we wait for the first one even if the position is in a later one.
+        mConsumerCondition.wait( lock, [&block]() { return block.ready; } );
+        if ( block.result != S_OK ) { // The failed read will be retried directly on the wrapped stream.
+            break;
+        }
+
+        const uint64_t blockEnd = block.offset + block.size;
+        if ( position < blockEnd ) {
+            const auto chunkSize = static_cast< UInt32 >( std::min< uint64_t >( size - processedSize,
+                                                                                  blockEnd - position ) );
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcpy( data + processedSize, &block.data[ position - block.offset ], chunkSize );
+            processedSize += chunkSize;
+        }
+
+        if ( mCurrentPosition + processedSize < blockEnd ) { // The block has still some data to be read.
+            break;
+        }
+        // The block was completely read: it can be reused for reading ahead.
+        mFreeBlocks.push_back( mScheduledBlocks.front() );
+        mScheduledBlocks.pop_front();
+        if ( block.size < mBlockSize ) { // End of the stream.
+            break;
+        }
+    }
+    return processedSize;
+}
+
+auto CReadAheadInStream::readDirectly( void* data, UInt32 size, UInt32& processedSize ) noexcept -> HRESULT {
+    RINOK( mStream->Seek( static_cast< Int64 >( mCurrentPosition ), STREAM_SEEK_SET, nullptr ) )
+    return mStream->Read( data, size, &processedSize );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CReadAheadInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept try {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    std::unique_lock< std::mutex > lock{ mMutex };
+    if ( mCurrentPosition == mLastReadEnd ) {
+        mSequentialReads = std::min( mSequentialReads + 1, kSequentialReadsThreshold );
+    } else {
+        mSequentialReads = 0;
+    }
+
+    HRESULT result = S_OK;
+    UInt32 readSize = readBuffered( static_cast< byte_t* >( data ), size, lock ); //-V2571
+    if ( readSize == 0 ) {
+        // The data was not read ahead: stopping the read-ahead, and reading the data from the wrapped stream.
+        cancelReadAhead( lock );
+        lock.unlock();
+        result = readDirectly( data, size, readSize );
+        lock.lock();
+    }
+    mCurrentPosition += readSize;
+    mLastReadEnd = mCurrentPosition;
+
+    if ( result == S_OK && mSequentialReads >= kSequentialReadsThreshold ) {
+        scheduleBlocks( lock );
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = readSize;
+    }
+    return result;
+} catch ( ... ) {
+    return E_FAIL;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CReadAheadInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept try {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mStreamSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+} catch ( ... ) {
+    return E_FAIL;
+}
+
+} // namespace bit7z
@@ -0,0 +1,107 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CREADAHEADINSTREAM_HPP
+#define CREADAHEADINSTREAM_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An input stream wrapping another one, and reading ahead its next blocks on a background thread
+ * while it is being read sequentially.
+ *
+ * The wrapped stream is read ahead only after a few consecutive sequential reads; a read at any other position
+ * stops the read-ahead (discarding the blocks read so far), and it is served directly by the wrapped stream.
+ */
+class CReadAheadInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        /**
+         * @param stream        the stream to be read ahead.
+         * @param blockSize     the size (in bytes) of the blocks read ahead.
+         * @param blocksCount   the maximum number of blocks read ahead at the same time.
+         */
+        CReadAheadInStream( CMyComPtr< IInStream > stream, std::size_t blockSize, std::size_t blocksCount );
+
+        CReadAheadInStream( const CReadAheadInStream& ) = delete;
+
+        CReadAheadInStream( CReadAheadInStream&& ) = delete;
+
+        auto operator=( const CReadAheadInStream& ) -> CReadAheadInStream& = delete;
+
+        auto operator=( CReadAheadInStream&& ) -> CReadAheadInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CReadAheadInStream() );
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        struct Block {
+            uint64_t offset;
+            std::size_t size;
+            bool ready;
+            HRESULT result;
+            buffer_t data;
+        };
+
+        CMyComPtr< IInStream > mStream;
+        std::size_t mBlockSize;
+        uint64_t mStreamSize;
+        uint64_t mCurrentPosition;
+        uint64_t mLastReadEnd;
+        uint32_t mSequentialReads;
+
+        std::mutex mMutex;
+        std::condition_variable mReaderCondition;
+        std::condition_variable mConsumerCondition;
+
+        std::vector< Block > mBlocks;
+        std::deque< std::size_t > mScheduledBlocks; // Indices of the blocks to be read ahead, sorted by offset.
+        std::vector< std::size_t > mFreeBlocks;
+        uint64_t mNextBlockOffset;
+        bool mReading;
+        bool mStopped;
+
+        std::thread mReader;
+
+        void readBlocks();
+
+        void scheduleBlocks( std::unique_lock< std::mutex >& lock );
+
+        void cancelReadAhead( std::unique_lock< std::mutex >& lock );
+
+        auto readBuffered( byte_t* data, UInt32 size, std::unique_lock< std::mutex >& lock ) -> UInt32;
+
+        auto readDirectly( void* data, UInt32 size, UInt32& processedSize ) noexcept -> HRESULT;
+};
+
+}  // namespace bit7z
+
+#endif //CREADAHEADINSTREAM_HPP
@@ -0,0 +1,54 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/csinkoutstream.hpp"
+
+namespace bit7z {
+
+CSinkOutStream::CSinkOutStream( ItemSink sink )
+    : mSink{ std::move( sink ) }, mStopRequested{ false } {}
+
+auto CSinkOutStream::stopRequested() const noexcept -> bool {
+    return mStopRequested;
+}
+
+auto CSinkOutStream::sinkException() const noexcept -> const std::exception_ptr& {
+    return mSinkException;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CSinkOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( data == nullptr || size == 0 ) {
+        return E_FAIL;
+    }
+
+    try {
+        if ( !mSink( static_cast< const byte_t* >( data ), size ) ) { //-V2571
+            mStopRequested = true;
+            return E_ABORT;
+        }
+    } catch ( ... ) {
+        mSinkException = std::current_exception();
+        return E_ABORT;
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,65 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CSINKOUTSTREAM_HPP
+#define CSINKOUTSTREAM_HPP
+
+#include <exception>
+
+#include "bitinputarchive.hpp"
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An output stream passing the written data directly to a user-provided sink function.
+ */
+class CSinkOutStream final : public ISequentialOutStream, public CMyUnknownImp {
+    public:
+        explicit CSinkOutStream( ItemSink sink );
+
+        CSinkOutStream( const CSinkOutStream& ) = delete;
+
+        CSinkOutStream( CSinkOutStream&& ) = delete;
+
+        auto operator=( const CSinkOutStream& ) -> CSinkOutStream& = delete;
+
+        auto operator=( CSinkOutStream&& ) -> CSinkOutStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CSinkOutStream() ) = default;
+
+        /**
+         * @return true if the sink asked to stop the extraction.
+         */
+        BIT7Z_NODISCARD auto stopRequested() const noexcept -> bool;
+
+        /**
+         * @return the exception thrown by the sink, if any.
+         */
+        BIT7Z_NODISCARD auto sinkException() const noexcept -> const std::exception_ptr&;
+
+        // ISequentialOutStream
+        BIT7Z_STDMETHOD( Write, const void* data, UInt32 size, UInt32* processedSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( ISequentialOutStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        ItemSink mSink;
+        bool mStopRequested;
+        std::exception_ptr mSinkException;
+};
+
+}  // namespace bit7z
+
+#endif // CSINKOUTSTREAM_HPP
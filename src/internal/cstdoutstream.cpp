@@ -10,7 +10,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-#include <iterator>
+#include <algorithm>
+#include <array>
 
 #include "internal/cstdoutstream.hpp"
 #include "internal/streamutil.hpp"
@@ -18,6 +19,8 @@
 
 namespace bit7z {
 
+constexpr std::size_t kZeroPaddingChunkSize = 4096;
+
 CStdOutStream::CStdOutStream( std::ostream& outputStream ) : mOutputStream( outputStream ) {}
 
 COM_DECLSPEC_NOTHROW
@@ -30,15 +33,18 @@ STDMETHODIMP CStdOutStream::Write( const void* data, UInt32 size, UInt32* proces
         return S_OK;
     }
 
-    const auto oldPos = mOutputStream.tellp();
-
+    /* Note: std::ostream::write sets the badbit if it could not write all the data,
+     * so we don't need to query the stream position (which might require a system call) to know what was written. */
     mOutputStream.write( static_cast< const char* >( data ), clamp_cast< std::streamsize >( size ) ); //-V2571
 
-    if ( processedSize != nullptr ) {
-        *processedSize = static_cast< uint32_t >( mOutputStream.tellp() - oldPos );
+    if ( mOutputStream.bad() ) {
+        return HRESULT_FROM_WIN32( ERROR_WRITE_FAULT );
     }
 
-    return mOutputStream.bad() ? HRESULT_FROM_WIN32( ERROR_WRITE_FAULT ) : S_OK;
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
 }
 
 COM_DECLSPEC_NOTHROW
@@ -77,9 +83,13 @@ STDMETHODIMP CStdOutStream::SetSize( UInt64 newSize ) noexcept {
         return E_FAIL;
     }
 
-    const auto diffPos = newSize - currentPos;
-    if ( diffPos > 0 ) {
-        std::fill_n( std::ostream_iterator< char >( mOutputStream ), diffPos, '\0' );
+    // Padding the stream with zeros, writing them in chunks rather than one character at a time.
+    static constexpr std::array< char, kZeroPaddingChunkSize > zeros{};
+    auto diffPos = newSize - currentPos;
+    while ( diffPos > 0 && mOutputStream ) {
+        const auto chunkSize = std::min< uint64_t >( diffPos, zeros.size() );
+        mOutputStream.write( zeros.data(), static_cast< std::streamsize >( chunkSize ) );
+        diffPos -= chunkSize;
     }
 
     mOutputStream.seekp( oldPos );
@@ -0,0 +1,55 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CSTDSEQUENTIALINSTREAM_HPP
+#define CSTDSEQUENTIALINSTREAM_HPP
+
+#include <istream>
+
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * A sequential input stream reading from a non-seekable std::istream (e.g., a pipe or a socket).
+ *
+ * Note: unlike CStdInStream, it doesn't implement IInStream,
+ * so that archive handlers cannot try to seek within the stream.
+ */
+class CStdSequentialInStream final : public ISequentialInStream, public CMyUnknownImp {
+    public:
+        explicit CStdSequentialInStream( std::istream& inputStream );
+
+        CStdSequentialInStream( const CStdSequentialInStream& ) = delete;
+
+        CStdSequentialInStream( CStdSequentialInStream&& ) = delete;
+
+        auto operator=( const CStdSequentialInStream& ) -> CStdSequentialInStream& = delete;
+
+        auto operator=( CStdSequentialInStream&& ) -> CStdSequentialInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CStdSequentialInStream() ) = default;
+
+        // ISequentialInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( ISequentialInStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        std::istream& mInputStream;
+};
+
+}  // namespace bit7z
+
+#endif // CSTDSEQUENTIALINSTREAM_HPP
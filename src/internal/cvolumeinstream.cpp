@@ -11,11 +11,27 @@
  */
 
 #include "internal/cvolumeinstream.hpp"
+#include "bitexception.hpp"
+#include "internal/cfileinstream.hpp"
+#include "internal/cfilemapinstream.hpp"
+#include "internal/util.hpp"
+
+#include <utility>
 
 namespace bit7z {
 
-CVolumeInStream::CVolumeInStream( const fs::path& volumePath, uint64_t globalOffset )
-    : CFileInStream{ volumePath }, mSize{ fs::file_size( volumePath ) }, mGlobalOffset{ globalOffset } {}
+inline auto open_volume( const fs::path& volumePath, FileAccessMode accessMode ) -> CMyComPtr< IInStream > {
+    if ( accessMode == FileAccessMode::MemoryMapped && can_map_file( volumePath ) ) {
+        return bit7z::make_com< CFileMapInStream, IInStream >( volumePath, false );
+    }
+    return bit7z::make_com< CFileInStream, IInStream >( volumePath );
+}
+
+CVolumeInStream::CVolumeInStream( fs::path volumePath, uint64_t globalOffset, FileAccessMode accessMode )
+    : mVolumePath{ std::move( volumePath ) },
+      mAccessMode{ accessMode },
+      mSize{ fs::file_size( mVolumePath ) },
+      mGlobalOffset{ globalOffset } {}
 
 BIT7Z_NODISCARD
 auto CVolumeInStream::globalOffset() const -> uint64_t {
@@ -27,4 +43,40 @@ auto CVolumeInStream::size() const -> uint64_t {
     return mSize;
 }
 
-} // namespace bit7z
\ No newline at end of file
+auto CVolumeInStream::isOpen() const noexcept -> bool {
+    return mVolumeStream != nullptr;
+}
+
+void CVolumeInStream::open() {
+    if ( mVolumeStream == nullptr ) {
+        mVolumeStream = open_volume( mVolumePath, mAccessMode );
+    }
+}
+
+void CVolumeInStream::close() noexcept {
+    mVolumeStream.Release();
+}
+
+auto CVolumeInStream::readAt( uint64_t offset, void* data, UInt32 size, UInt32* processedSize ) noexcept -> HRESULT {
+    // Note: the volume streams keep track of their position by themselves, so seeking does not require system calls.
+    RINOK( mVolumeStream->Seek( static_cast< Int64 >( offset ), STREAM_SEEK_SET, nullptr ) )
+    return mVolumeStream->Read( data, size, processedSize );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CVolumeInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept try {
+    open();
+    return mVolumeStream->Read( data, size, processedSize );
+} catch ( const BitException& ex ) {
+    return ex.hresultCode();
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept try {
+    open();
+    return mVolumeStream->Seek( offset, seekOrigin, newPosition );
+} catch ( const BitException& ex ) {
+    return ex.hresultCode();
+}
+
+} // namespace bit7z
@@ -10,19 +10,70 @@
 #ifndef CVOLUMEINSTREAM_HPP
 #define CVOLUMEINSTREAM_HPP
 
-#include "internal/cfileinstream.hpp"
+#include "bitabstractarchivehandler.hpp"
+#include "internal/com.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
 
 namespace bit7z {
 
-class CVolumeInStream final : public CFileInStream {
+/**
+ * An input stream reading a volume of a multi-volume archive; the volume file is opened only when needed,
+ * and it can be closed (e.g., to limit the number of open files), being reopened on the next read.
+ */
+class CVolumeInStream final : public IInStream, public CMyUnknownImp {
     public:
-        explicit CVolumeInStream( const fs::path& volumePath, uint64_t globalOffset );
+        CVolumeInStream( fs::path volumePath, uint64_t globalOffset, FileAccessMode accessMode );
+
+        CVolumeInStream( const CVolumeInStream& ) = delete;
+
+        CVolumeInStream( CVolumeInStream&& ) = delete;
+
+        auto operator=( const CVolumeInStream& ) -> CVolumeInStream& = delete;
+
+        auto operator=( CVolumeInStream&& ) -> CVolumeInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CVolumeInStream() ) = default;
 
         BIT7Z_NODISCARD auto globalOffset() const -> uint64_t;
 
         BIT7Z_NODISCARD auto size() const -> uint64_t;
 
+        BIT7Z_NODISCARD auto isOpen() const noexcept -> bool;
+
+        /**
+         * @brief Opens the volume file, if it is not already open.
+         */
+        void open();
+
+        /**
+         * @brief Closes the volume file.
+         */
+        void close() noexcept;
+
+        /**
+         * @brief Reads the data at the given offset of the (open) volume.
+         */
+        auto readAt( uint64_t offset, void* data, UInt32 size, UInt32* processedSize ) noexcept -> HRESULT;
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
     private:
+        fs::path mVolumePath;
+
+        FileAccessMode mAccessMode;
+
+        CMyComPtr< IInStream > mVolumeStream;
+
         uint64_t mSize;
 
         uint64_t mGlobalOffset;
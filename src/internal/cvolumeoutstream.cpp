@@ -20,7 +20,7 @@ CVolumeOutStream::CVolumeOutStream( const fs::path& volumeName )
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CVolumeOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
     UInt64 pos{};
-    RINOK( CStdOutStream::Seek( offset, seekOrigin, &pos ) )
+    RINOK( CFileOutStream::Seek( offset, seekOrigin, &pos ) )
     mCurrentOffset = pos;
     if ( newPosition != nullptr ) {
         *newPosition = pos;
@@ -35,7 +35,7 @@ STDMETHODIMP CVolumeOutStream::Write( const void* data, UInt32 size, UInt32* pro
     }
 
     UInt32 writtenSize{};
-    RINOK( CStdOutStream::Write( data, size, &writtenSize ) )
+    RINOK( CFileOutStream::Write( data, size, &writtenSize ) )
 
     if ( writtenSize == 0 && size != 0 ) {
         return E_FAIL;
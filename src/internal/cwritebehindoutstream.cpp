@@ -0,0 +1,85 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/cwritebehindoutstream.hpp"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace bit7z {
+
+CWriteBehindOutStream::CWriteBehindOutStream( WriteBehindQueue& queue, CMyComPtr< ISequentialOutStream > stream )
+    : mQueue{ queue }, mStream{ std::move( stream ) } {}
+
+CWriteBehindOutStream::~CWriteBehindOutStream() {
+    // The queue's I/O thread must not use the wrapped stream after it is released.
+    static_cast< void >( close() );
+}
+
+auto CWriteBehindOutStream::close() noexcept -> HRESULT {
+    if ( mStream == nullptr ) {
+        return S_OK;
+    }
+    HRESULT result = S_OK;
+    if ( !mBuffer.empty() ) {
+        try {
+            mQueue.submit( mStream, std::move( mBuffer ) );
+        } catch ( ... ) {
+            result = E_OUTOFMEMORY;
+        }
+        mBuffer = buffer_t{};
+    }
+    // Note: the queue must not have pending writes to the wrapped stream when we release it.
+    const HRESULT flushResult = mQueue.flush();
+    mStream.Release();
+    return result != S_OK ? result : flushResult;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CWriteBehindOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept try {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( mStream == nullptr ) {
+        return E_FAIL;
+    }
+
+    const auto* bytes = static_cast< const byte_t* >( data ); //-V2571
+    const auto bufferSize = mQueue.bufferSize();
+    UInt32 written = 0;
+    while ( written < size ) {
+        if ( mBuffer.capacity() == 0 ) {
+            mBuffer = mQueue.acquireBuffer();
+        }
+        const auto chunkSize = std::min< std::size_t >( size - written, bufferSize - mBuffer.size() );
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        mBuffer.insert( mBuffer.end(), bytes + written, bytes + written + chunkSize );
+        written += static_cast< UInt32 >( chunkSize );
+        if ( mBuffer.size() == bufferSize ) {
+            mQueue.submit( mStream, std::move( mBuffer ) );
+            mBuffer = buffer_t{};
+        }
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+} catch ( const std::bad_alloc& ) {
+    return E_OUTOFMEMORY;
+} catch ( ... ) {
+    return E_FAIL;
+}
+
+} // namespace bit7z
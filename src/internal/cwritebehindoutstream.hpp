@@ -0,0 +1,64 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CWRITEBEHINDOUTSTREAM_HPP
+#define CWRITEBEHINDOUTSTREAM_HPP
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+#include "internal/writebehindqueue.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * A sequential output stream collecting the written data into the buffers of a WriteBehindQueue,
+ * so that the data is written to the wrapped stream by the queue's I/O thread.
+ */
+class CWriteBehindOutStream final : public ISequentialOutStream, public CMyUnknownImp {
+    public:
+        CWriteBehindOutStream( WriteBehindQueue& queue, CMyComPtr< ISequentialOutStream > stream );
+
+        CWriteBehindOutStream( const CWriteBehindOutStream& ) = delete;
+
+        CWriteBehindOutStream( CWriteBehindOutStream&& ) = delete;
+
+        auto operator=( const CWriteBehindOutStream& ) -> CWriteBehindOutStream& = delete;
+
+        auto operator=( CWriteBehindOutStream&& ) -> CWriteBehindOutStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CWriteBehindOutStream() );
+
+        /**
+         * @brief Submits the buffered data, waits until all the data written to the stream has reached
+         * the wrapped stream, and then releases the wrapped stream (any subsequent write will fail).
+         *
+         * @return the result of the first failed write to the wrapped stream, or S_OK if all the writes succeeded.
+         */
+        auto close() noexcept -> HRESULT;
+
+        // ISequentialOutStream
+        BIT7Z_STDMETHOD( Write, void const* data, UInt32 size, UInt32* processedSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( ISequentialOutStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        WriteBehindQueue& mQueue;
+        CMyComPtr< ISequentialOutStream > mStream;
+        buffer_t mBuffer;
+};
+
+}  // namespace bit7z
+
+#endif //CWRITEBEHINDOUTSTREAM_HPP
@@ -49,6 +49,23 @@ auto time_to_FILETIME( std::time_t value ) -> FILETIME {
     return fileTime;
 }
 
+auto FILETIME_to_timespec( FILETIME fileTime ) -> timespec {
+    const FileTimeDuration fileTimeDuration{
+        ( static_cast< std::uint64_t >( fileTime.dwHighDateTime ) << 32ull ) + fileTime.dwLowDateTime
+    };
+
+    const auto unixFileTime = fileTimeDuration + nt_to_unix_epoch;
+    auto seconds = std::chrono::duration_cast< std::chrono::seconds >( unixFileTime );
+    if ( seconds > unixFileTime ) { // Flooring, so that the nanoseconds are non-negative also before the Unix epoch.
+        seconds -= std::chrono::seconds{ 1 };
+    }
+    const auto nanoseconds = std::chrono::duration_cast< std::chrono::nanoseconds >( unixFileTime - seconds );
+    timespec result{};
+    result.tv_sec = static_cast< std::time_t >( seconds.count() );
+    result.tv_nsec = static_cast< long >( nanoseconds.count() ); // NOLINT(google-runtime-int)
+    return result;
+}
+
 #endif
 
 auto FILETIME_to_time_type( FILETIME fileTime ) -> time_type {
@@ -0,0 +1,134 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _WIN32
+
+#include "internal/directoryfdcache.hpp"
+
+#include <cerrno>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bit7z {
+
+constexpr std::size_t DirectoryFdCache::kDefaultMaxDirectories;
+
+constexpr auto kDirectoryOpenFlags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+constexpr auto kDirectoryMode = 0777;
+
+// Note: the base path must be followed by a separator, otherwise, e.g., "/tmp/out" would match "/tmp/outside".
+inline auto is_inside( const std::string& path, const std::string& basePath ) -> bool {
+    if ( path.compare( 0, basePath.size(), basePath ) != 0 ) {
+        return false;
+    }
+    return path.size() == basePath.size() || basePath.empty() || basePath.back() == '/' ||
+           path[ basePath.size() ] == '/';
+}
+
+DirectoryFdCache::DirectoryFdCache( fs::path basePath, std::size_t maxDirectories )
+    : mBasePath{ std::move( basePath ) }, mBaseFd{ -1 }, mMaxDirectories{ maxDirectories > 0 ? maxDirectories : 1 } {}
+
+DirectoryFdCache::~DirectoryFdCache() {
+    closeDirectories();
+    if ( mBaseFd >= 0 ) {
+        ::close( mBaseFd );
+    }
+}
+
+auto DirectoryFdCache::directoryFd( const fs::path& directoryPath ) -> int {
+    if ( mBaseFd < 0 ) {
+        std::error_code error;
+        fs::create_directories( mBasePath, error );
+        mBaseFd = ::open( mBasePath.c_str(), kDirectoryOpenFlags ); // NOLINT(*-vararg)
+        if ( mBaseFd < 0 ) {
+            return -1;
+        }
+    }
+
+    // The path is inside the base path (SafeOutPathBuilder ensures it), so the relative path is just its suffix.
+    const auto& nativePath = directoryPath.native();
+    const auto& nativeBase = mBasePath.native();
+    if ( !is_inside( nativePath, nativeBase ) ) {
+        errno = EINVAL;
+        return -1;
+    }
+    const auto relativeStart = nativePath.find_first_not_of( '/', nativeBase.size() );
+    if ( relativeStart == std::string::npos ) {
+        return mBaseFd;
+    }
+
+    auto relativePath = nativePath.substr( relativeStart );
+    while ( !relativePath.empty() && relativePath.back() == '/' ) {
+        relativePath.pop_back();
+    }
+    return openDirectory( relativePath );
+}
+
+auto DirectoryFdCache::openDirectory( const std::string& relativePath ) -> int {
+    if ( relativePath.empty() ) {
+        return mBaseFd;
+    }
+
+    const auto cachedDirectory = mDirectoryFds.find( relativePath );
+    if ( cachedDirectory != mDirectoryFds.end() ) {
+        mDirectories.splice( mDirectories.begin(), mDirectories, cachedDirectory->second );
+        return cachedDirectory->second->fd;
+    }
+
+    const auto separatorPos = relativePath.rfind( '/' );
+    const int parentFd = separatorPos == std::string::npos ?
+                         mBaseFd : openDirectory( relativePath.substr( 0, separatorPos ) );
+    if ( parentFd < 0 ) {
+        return -1;
+    }
+
+    const auto* name = relativePath.c_str() + ( separatorPos == std::string::npos ? 0 : separatorPos + 1 ); //-V2563
+    if ( ::mkdirat( parentFd, name, kDirectoryMode ) != 0 && errno != EEXIST ) {
+        return -1;
+    }
+    const int directoryFd = ::openat( parentFd, name, kDirectoryOpenFlags | O_NOFOLLOW ); // NOLINT(*-vararg)
+    if ( directoryFd < 0 ) {
+        return -1;
+    }
+
+    /* Closing the least recently used directory, if the cache is full.
+     * Note: the parent directories were just used, so they are the most recently used ones and are kept open. */
+    if ( mDirectories.size() >= mMaxDirectories ) {
+        const auto& evictedDirectory = mDirectories.back();
+        ::close( evictedDirectory.fd );
+        mDirectoryFds.erase( evictedDirectory.relativePath );
+        mDirectories.pop_back();
+    }
+    mDirectories.push_front( CachedDirectory{ relativePath, directoryFd } );
+    mDirectoryFds.emplace( relativePath, mDirectories.begin() );
+    return directoryFd;
+}
+
+auto DirectoryFdCache::size() const noexcept -> std::size_t {
+    return mDirectories.size();
+}
+
+void DirectoryFdCache::closeDirectories() noexcept {
+    for ( const auto& directory : mDirectories ) {
+        ::close( directory.fd );
+    }
+    mDirectoryFds.clear();
+    mDirectories.clear();
+}
+
+} // namespace bit7z
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DIRECTORYFDCACHE_HPP
+#define DIRECTORYFDCACHE_HPP
+
+#ifndef _WIN32
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "bitdefines.hpp"
+#include "internal/fs.hpp"
+
+namespace bit7z {
+
+/**
+ * A cache of the file descriptors of the directories created while extracting an archive,
+ * keyed by their paths relative to the output directory.
+ *
+ * Missing directories are created one component at a time with mkdirat, and then opened with openat,
+ * so that the files can be created relative to their parent directory without walking their full path.
+ * The components of the paths inside the output directory are never followed if they are symbolic links.
+ */
+class DirectoryFdCache final {
+    public:
+        // Keeping the number of open directories well below the usual limit of open files per process.
+        static constexpr auto kDefaultMaxDirectories = static_cast< std::size_t >( 256 );
+
+        /**
+         * @param basePath          the absolute and normalized path of the output directory
+         *                          (which is created when the first directory is requested, if it doesn't exist).
+         * @param maxDirectories    the maximum number of directories kept open; when the cache is full,
+         *                          the least recently used directory is closed.
+         */
+        explicit DirectoryFdCache( fs::path basePath, std::size_t maxDirectories = kDefaultMaxDirectories );
+
+        DirectoryFdCache( const DirectoryFdCache& ) = delete;
+
+        DirectoryFdCache( DirectoryFdCache&& ) = delete;
+
+        auto operator=( const DirectoryFdCache& ) -> DirectoryFdCache& = delete;
+
+        auto operator=( DirectoryFdCache&& ) -> DirectoryFdCache& = delete;
+
+        ~DirectoryFdCache();
+
+        /**
+         * @brief Opens the given directory (creating it and its missing parents, if needed).
+         *
+         * @note The returned descriptor is owned by the cache, and it is valid only until the next call.
+         *
+         * @param directoryPath the path of the directory, inside the output directory.
+         *
+         * @return the file descriptor of the directory, or -1 on failure (errno is set).
+         */
+        BIT7Z_NODISCARD auto directoryFd( const fs::path& directoryPath ) -> int;
+
+        /**
+         * @return the number of directories kept open by the cache (excluding the output directory).
+         */
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+    private:
+        struct CachedDirectory {
+            std::string relativePath;
+            int fd;
+        };
+
+        using CachedDirectoryIterator = std::list< CachedDirectory >::iterator;
+
+        fs::path mBasePath;
+        int mBaseFd;
+        std::size_t mMaxDirectories;
+        std::list< CachedDirectory > mDirectories; // Sorted from the most recently used to the least recently used.
+        std::unordered_map< std::string, CachedDirectoryIterator > mDirectoryFds;
+
+        auto openDirectory( const std::string& relativePath ) -> int;
+
+        void closeDirectories() noexcept;
+};
+
+}  // namespace bit7z
+
+#endif
+
+#endif //DIRECTORYFDCACHE_HPP
@@ -11,6 +11,7 @@
 #define EXTRACTCALLBACK_HPP
 
 #include <system_error>
+#include <vector>
 
 #include "bitinputarchive.hpp"
 #include "internal/callback.hpp"
@@ -112,6 +113,11 @@ class ExtractCallback : public Callback,
         std::exception_ptr mErrorException;
 };
 
+void extract_arc( IInArchive* inArchive,
+                  const std::vector< uint32_t >& indices,
+                  ExtractCallback* extractCallback,
+                  ExtractMode mode = ExtractMode::Extract );
+
 }  // namespace bit7z
 
 #endif // EXTRACTCALLBACK_HPP
@@ -10,12 +10,21 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
+
 #include "bitexception.hpp"
 #include "internal/fileextractcallback.hpp"
 #include "internal/fsutil.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/util.hpp"
 
+#ifndef _WIN32
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 using namespace NWindows;
 
@@ -25,9 +34,40 @@ FileExtractCallback::FileExtractCallback( const BitInputArchive& inputArchive, c
     : ExtractCallback( inputArchive ),
       mInFilePath( tstring_to_path( inputArchive.archivePath() ) ),
       mOutPathBuilder( directoryPath ),
-      mRetainDirectories( inputArchive.handler().retainDirectories() ) {}
+#ifndef _WIN32
+      mDirectoryCache( mOutPathBuilder.basePath() ),
+#endif
+      mRetainDirectories( inputArchive.handler().retainDirectories() ) {
+    if ( inputArchive.handler().writeBehind() ) {
+        mWriteBehindQueue = std::make_unique< WriteBehindQueue >();
+    }
+}
+
+inline void set_item_times( const fs::path& itemPath, const ProcessedItem& item ) noexcept {
+#ifdef _WIN32
+    const auto creationTime = item.hasCreationTime() ? item.creationTime() : FILETIME{};
+    const auto accessTime = item.hasAccessTime() ? item.accessTime() : FILETIME{};
+    const auto modifiedTime = item.hasModifiedTime() ? item.modifiedTime() : FILETIME{};
+    filesystem::fsutil::set_file_time( itemPath, creationTime, accessTime, modifiedTime );
+#else
+    if ( item.hasModifiedTime() ) {
+        filesystem::fsutil::set_file_modified_time( itemPath, item.modifiedTime() );
+    }
+#endif
+}
+
+auto FileExtractCallback::flushWriteBehindStream() -> HRESULT {
+    if ( mWriteBehindStream == nullptr ) {
+        return S_OK;
+    }
+    // Waiting for the I/O thread to write all the data of the current file.
+    const HRESULT result = mWriteBehindStream->close();
+    mWriteBehindStream.Release();
+    return result;
+}
 
 void FileExtractCallback::releaseStream() {
+    static_cast< void >( flushWriteBehindStream() );
     mFileOutStream.Release(); // We need to release the file to change its modified time!
 }
 
@@ -37,33 +77,53 @@ auto FileExtractCallback::finishOperation( OperationResult operationResult ) ->
         return result;
     }
 
-    if ( mFileOutStream->fail() ) {
-        return E_FAIL;
+    const HRESULT writeResult = flushWriteBehindStream();
+    if ( writeResult != S_OK || mFileOutStream->fail() ) {
+        mFileOutStream.Release();
+        return writeResult != S_OK ? writeResult : E_FAIL;
     }
 
+#ifdef _WIN32
     mFileOutStream.Release(); // We need to release the file to change its modified time!
 
     if ( extractMode() != ExtractMode::Extract ) { // No need to set attributes or modified time of the file.
         return result;
     }
 
-#ifdef _WIN32
-    const auto creationTime = mCurrentItem.hasCreationTime() ? mCurrentItem.creationTime() : FILETIME{};
-    const auto accessTime = mCurrentItem.hasAccessTime() ? mCurrentItem.accessTime() : FILETIME{};
-    const auto modifiedTime = mCurrentItem.hasModifiedTime() ? mCurrentItem.modifiedTime() : FILETIME{};
-    filesystem::fsutil::set_file_time( mFilePathOnDisk, creationTime, accessTime, modifiedTime );
+    set_item_times( mFilePathOnDisk, mCurrentItem );
+    if ( mCurrentItem.areAttributesDefined() ) {
+        filesystem::fsutil::set_file_attributes( mOutPathBuilder, mFilePathOnDisk, mCurrentItem.attributes() );
+    }
 #else
-    if ( mCurrentItem.hasModifiedTime() ) {
-        filesystem::fsutil::set_file_modified_time( mFilePathOnDisk, mCurrentItem.modifiedTime() );
+    if ( extractMode() != ExtractMode::Extract ) { // No need to set attributes or modified time of the file.
+        mFileOutStream.Release();
+        return result;
     }
-#endif
 
+    // Setting the metadata through the still open descriptor of the file, without resolving its path again.
+    const int fileDescriptor = mFileOutStream->fileDescriptor();
+    if ( mCurrentItem.hasModifiedTime() ) {
+        filesystem::fsutil::set_file_modified_time( fileDescriptor, mCurrentItem.modifiedTime() );
+    }
     if ( mCurrentItem.areAttributesDefined() ) {
-        filesystem::fsutil::set_file_attributes( mOutPathBuilder, mFilePathOnDisk, mCurrentItem.attributes() );
+        filesystem::fsutil::set_file_attributes( fileDescriptor, mCurrentItem.attributes() );
     }
+    mFileOutStream.Release();
+
+    // Symbolic links are extracted as files containing the link's target, and then restored through their path.
+    const bool isSymlink = mCurrentItem.areAttributesDefined() &&
+                           filesystem::fsutil::is_symlink_attributes( mCurrentItem.attributes() );
+    if ( isSymlink ) {
+        static_cast< void >( mOutPathBuilder.restoreSymlink( mFilePathOnDisk ) );
+    }
+#endif
     return result;
 }
 
+auto FileExtractCallback::takeExtractedDirectories() -> std::vector< ExtractedDirectory > {
+    return std::move( mExtractedDirectories );
+}
+
 auto FileExtractCallback::getCurrentItemPath() const -> fs::path {
     fs::path filePath = mCurrentItem.path();
     if ( filePath.empty() ) {
@@ -109,43 +169,149 @@ auto FileExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** o
             mHandler.fileCallback()( filePathString );
         }
 
+        RINOK( openOutputFile( outStream ) )
+        if ( mFileOutStream == nullptr ) { // Skipped file.
+            return S_OK;
+        }
+#ifndef _WIN32
+        if ( mHandler.preallocateFiles() ) {
+            const BitPropVariant itemSize = itemProperty( index, BitProperty::Size );
+            if ( itemSize.isUInt64() ) {
+                static_cast< void >( mFileOutStream->preallocate( itemSize.getUInt64() ) );
+            }
+        }
+        mFileOutStream->setSparse( mHandler.sparseFiles() );
+#endif
+        if ( mWriteBehindQueue != nullptr ) { // The file will be written by the I/O thread of the queue.
+            CMyComPtr< ISequentialOutStream > fileStream;
+            fileStream.Attach( *outStream );
+            *outStream = nullptr;
+            auto writeBehindStream = bit7z::make_com< CWriteBehindOutStream >( *mWriteBehindQueue, fileStream );
+            mWriteBehindStream = writeBehindStream;
+            *outStream = writeBehindStream.Detach();
+        }
+        return S_OK;
+    } else if ( mRetainDirectories ) { // Directory, and we must retain it
+#ifdef _WIN32
         std::error_code error;
-        fs::create_directories( mFilePathOnDisk.parent_path(), error );
+        fs::create_directories( mFilePathOnDisk, error );
+#else
+        static_cast< void >( mDirectoryCache.directoryFd( mFilePathOnDisk ) );
+#endif
+        // The metadata of the directory is restored at the end of the extraction,
+        // otherwise the extraction of its content would modify it.
+        const bool hasMetadata = mCurrentItem.hasModifiedTime() || mCurrentItem.areAttributesDefined();
+        if ( extractMode() == ExtractMode::Extract && hasMetadata ) {
+            mExtractedDirectories.push_back( ExtractedDirectory{ mFilePathOnDisk, mCurrentItem } );
+        }
+    } else {
+        // No action needed
+    }
+    return S_OK;
+}
 
-        if ( fs::exists( mFilePathOnDisk, error ) ) {
-            const OverwriteMode overwriteMode = mHandler.overwriteMode();
+void restore_directories_metadata( const SafeOutPathBuilder& outPathBuilder,
+                                   std::vector< ExtractedDirectory >& directories ) {
+    // Sorting the paths in reverse order, so that subdirectories are restored before their parent directories.
+    std::sort( directories.begin(), directories.end(),
+               []( const ExtractedDirectory& first, const ExtractedDirectory& second ) -> bool {
+                   return first.path.native() > second.path.native();
+               } );
+    for ( const auto& directory : directories ) {
+        set_item_times( directory.path, directory.item );
+        if ( directory.item.areAttributesDefined() ) {
+            filesystem::fsutil::set_file_attributes( outPathBuilder, directory.path, directory.item.attributes() );
+        }
+    }
+}
+
+#ifdef _WIN32
+auto FileExtractCallback::openOutputFile( ISequentialOutStream** outStream ) -> HRESULT {
+    std::error_code error;
+    fs::create_directories( mFilePathOnDisk.parent_path(), error );
 
-            switch ( overwriteMode ) {
-                case OverwriteMode::None: {
+    if ( fs::exists( mFilePathOnDisk, error ) ) {
+        const OverwriteMode overwriteMode = mHandler.overwriteMode();
+
+        switch ( overwriteMode ) {
+            case OverwriteMode::None: {
+                throw BitException( kCannotDeleteOutput,
+                                    make_hresult_code( E_ABORT ),
+                                    path_to_tstring( mFilePathOnDisk ) );
+            }
+            case OverwriteMode::Skip: {
+                return S_OK;
+            }
+            case OverwriteMode::Overwrite:
+            default: {
+                if ( !fs::remove( mFilePathOnDisk, error ) ) {
                     throw BitException( kCannotDeleteOutput,
                                         make_hresult_code( E_ABORT ),
                                         path_to_tstring( mFilePathOnDisk ) );
                 }
-                case OverwriteMode::Skip: {
-                    return S_OK;
-                }
-                case OverwriteMode::Overwrite:
-                default: {
-                    if ( !fs::remove( mFilePathOnDisk, error ) ) {
-                        throw BitException( kCannotDeleteOutput,
-                                            make_hresult_code( E_ABORT ),
-                                            path_to_tstring( mFilePathOnDisk ) );
-                    }
-                    break;
+                break;
+            }
+        }
+    }
+
+    auto outStreamLoc = bit7z::make_com< CFileOutStream >( mFilePathOnDisk, true );
+    mFileOutStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
+#else
+constexpr auto kOutputFileOpenFlags = O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC;
+
+constexpr auto kOutputFileMode = 0666;
+
+auto FileExtractCallback::openOutputFile( ISequentialOutStream** outStream ) -> HRESULT {
+    const int directoryFd = mDirectoryCache.directoryFd( mFilePathOnDisk.parent_path() );
+    if ( directoryFd < 0 ) {
+        throw BitException( "Failed to create the output directory",
+                            last_error_code(),
+                            path_to_tstring( mFilePathOnDisk.parent_path() ) );
+    }
+
+    /* Instead of checking whether the file exists before creating it, we try to create it exclusively,
+     * and we handle the overwrite mode only if it already exists. */
+    const auto fileName = mFilePathOnDisk.filename();
+    // NOLINTNEXTLINE(*-vararg)
+    int fileDescriptor = ::openat( directoryFd, fileName.c_str(), kOutputFileOpenFlags, kOutputFileMode );
+    if ( fileDescriptor < 0 && errno == EEXIST ) {
+        switch ( mHandler.overwriteMode() ) {
+            case OverwriteMode::None: {
+                throw BitException( kCannotDeleteOutput,
+                                    make_hresult_code( E_ABORT ),
+                                    path_to_tstring( mFilePathOnDisk ) );
+            }
+            case OverwriteMode::Skip: {
+                return S_OK;
+            }
+            case OverwriteMode::Overwrite:
+            default: {
+                // Note: like fs::remove, we also remove the existing entry if it is an empty directory.
+                if ( ::unlinkat( directoryFd, fileName.c_str(), 0 ) != 0 &&
+                     ::unlinkat( directoryFd, fileName.c_str(), AT_REMOVEDIR ) != 0 ) {
+                    throw BitException( kCannotDeleteOutput,
+                                        make_hresult_code( E_ABORT ),
+                                        path_to_tstring( mFilePathOnDisk ) );
                 }
+                // NOLINTNEXTLINE(*-vararg)
+                fileDescriptor = ::openat( directoryFd, fileName.c_str(), kOutputFileOpenFlags, kOutputFileMode );
+                break;
             }
         }
+    }
 
-        auto outStreamLoc = bit7z::make_com< CFileOutStream >( mFilePathOnDisk, true );
-        mFileOutStream = outStreamLoc;
-        *outStream = outStreamLoc.Detach();
-    } else if ( mRetainDirectories ) { // Directory, and we must retain it
-        std::error_code error;
-        fs::create_directories( mFilePathOnDisk, error );
-    } else {
-        // No action needed
+    if ( fileDescriptor < 0 ) {
+        throw BitException( "Failed to open the output file", last_error_code(), path_to_tstring( mFilePathOnDisk ) );
     }
+
+    auto outStreamLoc = bit7z::make_com< CFdOutStream >( fileDescriptor, mFilePathOnDisk );
+    mFileOutStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
     return S_OK;
 }
+#endif
 
 } // namespace bit7z
\ No newline at end of file
@@ -10,9 +10,14 @@
 #ifndef FILEEXTRACTCALLBACK_HPP
 #define FILEEXTRACTCALLBACK_HPP
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "internal/cfdoutstream.hpp"
 #include "internal/cfileoutstream.hpp"
+#include "internal/cwritebehindoutstream.hpp"
+#include "internal/directoryfdcache.hpp"
 #include "internal/extractcallback.hpp"
 #include "internal/fsutil.hpp"
 #include "internal/processeditem.hpp"
@@ -21,6 +26,14 @@ namespace bit7z {
 
 using std::wstring;
 
+/**
+ * A directory created by the extraction, whose metadata must be restored once the extraction is finished.
+ */
+struct ExtractedDirectory {
+    fs::path path;
+    ProcessedItem item;
+};
+
 class FileExtractCallback final : public ExtractCallback {
     public:
         FileExtractCallback( const BitInputArchive& inputArchive, const tstring& directoryPath );
@@ -35,15 +48,36 @@ class FileExtractCallback final : public ExtractCallback {
 
         ~FileExtractCallback() override = default;
 
+        /**
+         * @return the directories extracted so far, whose metadata has not been restored yet.
+         */
+        auto takeExtractedDirectories() -> std::vector< ExtractedDirectory >;
+
     private:
         fs::path mInFilePath;     // Input file path
         SafeOutPathBuilder mOutPathBuilder;
+#ifndef _WIN32
+        // Files are created relative to the (cached) descriptors of their parent directories.
+        DirectoryFdCache mDirectoryCache;
+#endif
         fs::path mFilePathOnDisk; // Full path to the file on disk
         bool mRetainDirectories;
 
         ProcessedItem mCurrentItem;
 
+        std::vector< ExtractedDirectory > mExtractedDirectories;
+
+#ifdef _WIN32
         CMyComPtr< CFileOutStream > mFileOutStream;
+#else
+        CMyComPtr< CFdOutStream > mFileOutStream;
+#endif
+
+        // Note: the queue must be declared before the stream, so that the stream is destroyed first.
+        std::unique_ptr< WriteBehindQueue > mWriteBehindQueue;
+        CMyComPtr< CWriteBehindOutStream > mWriteBehindStream;
+
+        auto flushWriteBehindStream() -> HRESULT;
 
         auto finishOperation( OperationResult operationResult ) -> HRESULT override;
 
@@ -53,8 +87,16 @@ class FileExtractCallback final : public ExtractCallback {
         auto getCurrentItemPath() const -> fs::path;
 
         auto getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT override;
+
+        auto openOutputFile( ISequentialOutStream** outStream ) -> HRESULT;
 };
 
+/**
+ * Restores the times and attributes of the given directories, starting from the innermost ones.
+ */
+void restore_directories_metadata( const SafeOutPathBuilder& outPathBuilder,
+                                   std::vector< ExtractedDirectory >& directories );
+
 }  // namespace bit7z
 
 #endif // FILEEXTRACTCALLBACK_HPP
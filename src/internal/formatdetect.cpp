@@ -208,281 +208,216 @@ auto find_format_by_extension( const tstring& extension ) -> const BitInFormat*
 }
 #endif
 
-/* NOTE 1: For signatures with less than 8 bytes (size of uint64_t), remaining bytes are set to 0
- * NOTE 2: Until v3, a std::unordered_map was used for mapping the signatures and the corresponding
- *         format. However, the switch case is faster and has less memory footprint. */
-auto find_format_by_signature( uint64_t signature ) noexcept -> const BitInFormat* {
-    constexpr auto kRarSignature = 0x526172211A070000ULL; // Rar! 0x1A 0x07 0x00
-    constexpr auto kRar5Signature = 0x526172211A070100ULL; // Rar! 0x1A 0x07 0x01 0x00
-    constexpr auto kSevenzipSignature = 0x377ABCAF271C0000ULL; // 7z 0xBC 0xAF 0x27 0x1C
-    constexpr auto kBzip2Signature = 0x425A680000000000ULL; // BZh
-    constexpr auto kGzipSignature = 0x1F8B080000000000ULL; // 0x1F 0x8B 0x08
-    constexpr auto kWimSignature = 0x4D5357494D000000ULL; // MSWIM 0x00 0x00 0x00
-    constexpr auto kXzSignature = 0xFD377A585A000000ULL; // 0xFD 7zXZ 0x00
-    constexpr auto kZipSignature = 0x504B000000000000ULL; // PK
-    constexpr auto kAvbSignature = 0x4156426600000000ULL; // AVBf 0x00 0x00 0x00
-    constexpr auto kApmSignature = 0x4552000000000000ULL; // ER
-    constexpr auto kArjSignature = 0x60EA000000000000ULL; // `EA
-    constexpr auto kCabSignature = 0x4D53434600000000ULL; // MSCF 0x00 0x00 0x00 0x00
-    constexpr auto kChmSignature = 0x4954534603000000ULL; // ITSF 0x03
-    constexpr auto kCompoundSignature = 0xD0CF11E0A1B11AE1ULL; // 0xD0 0xCF 0x11 0xE0 0xA1 0xB1 0x1A 0xE1
-    constexpr auto kCpioSignature1 = 0xC771000000000000ULL; // 0xC7 q
-    constexpr auto kCpioSignature2 = 0x71C7000000000000ULL; // q 0xC7
-    constexpr auto kCpioSignature3 = 0x3037303730000000ULL; // 07070
-    constexpr auto kDebSignature = 0x213C617263683E00ULL; // !<arch>0A
-    constexpr auto kElfSignature = 0x7F454C4600000000ULL; // 0x7F ELF
-    constexpr auto kPeSignature = 0x4D5A000000000000ULL; // MZ
-    constexpr auto kFlvSignature = 0x464C560100000000ULL; // FLV 0x01
-    constexpr auto kLpSignature = 0x67446C6134000000ULL;
-    constexpr auto kLvmSignature = 0x4C4142454C4F4E45;// LABELONE
-    constexpr auto kLzmaSignature = 0x5D00000000000000ULL; //
-    constexpr auto kLzma86Signature = 0x015D000000000000ULL; //
-    constexpr auto kMachoSignature1 = 0xCEFAEDFE00000000ULL; // 0xCE 0xFA 0xED 0xFE
-    constexpr auto kMachoSignature2 = 0xCFFAEDFE00000000ULL; // 0xCF 0xFA 0xED 0xFE
-    constexpr auto kMachoSignature3 = 0xFEEDFACE00000000ULL; // 0xFE 0xED 0xFA 0xCE
-    constexpr auto kMachoSignature4 = 0xFEEDFACF00000000ULL; // 0xFE 0xED 0xFA 0xCF
-    constexpr auto kMubSignature1 = 0xCAFEBABE00000000ULL; // 0xCA 0xFE 0xBA 0xBE 0x00 0x00 0x00
-    constexpr auto kMubSignature2 = 0xB9FAF10E00000000ULL; // 0xB9 0xFA 0xF1 0x0E
-    constexpr auto kMslzSignature = 0x535A444488F02733ULL; // SZDD 0x88 0xF0 '3
-    constexpr auto kPpmdSignature = 0x8FAFAC8400000000ULL; // 0x8F 0xAF 0xAC 0x84
-    constexpr auto kQcowSignature = 0x514649FB00000000ULL; // QFI 0xFB 0x00 0x00 0x00
-    constexpr auto kRpmSignature = 0xEDABEEDB00000000ULL; // 0xED 0xAB 0xEE 0xDB
-    constexpr auto kSparseSignature = 0x3AFF26ED00000000ULL; // 0x3A 0xFF 0x26 0xED
-    constexpr auto kSquashfsSignature1 = 0x7371736800000000ULL; // sqsh
-    constexpr auto kSquashfsSignature2 = 0x6873717300000000ULL; // hsqs
-    constexpr auto kSquashfsSignature3 = 0x7368737100000000ULL; // shsq
-    constexpr auto kSquashfsSignature4 = 0x7173687300000000ULL; // qshs
-    constexpr auto kSwfSignature = 0x4657530000000000ULL; // FWS
-    constexpr auto kSwfcSignature1 = 0x4357530000000000ULL; // CWS
-    constexpr auto kSwfcSignature2 = 0x5A57530000000000ULL; // ZWS
-    constexpr auto kTeSignature = 0x565A000000000000ULL; // VZ
-    constexpr auto kVmdkSignature = 0x4B444D0000000000ULL; // KDMV
-    constexpr auto kVdiSignature = 0x3C3C3C2000000000ULL; // Alternatively, 0x7F10DABE at offset 0x40
-    constexpr auto kVhdSignature = 0x636F6E6563746978ULL; // conectix
-    constexpr auto kVhdxSignature = 0x7668647866696C65;// vhdxfile
-    constexpr auto kXarSignature = 0x78617221001C0000ULL; // xar! 0x00 0x1C
-    constexpr auto kZSignature1 = 0x1F9D000000000000ULL; // 0x1F 0x9D
-    constexpr auto kZSignature2 = 0x1FA0000000000000ULL; // 0x1F 0xA0
-    constexpr auto kZstdSignature = 0x28B52FFD00000000ULL;
-
-    switch ( signature ) {
-        case kRarSignature:
-            return &BitFormat::Rar;
-        case kRar5Signature:
-            return &BitFormat::Rar5;
-        case kSevenzipSignature:
-            return &BitFormat::SevenZip;
-        case kBzip2Signature:
-            return &BitFormat::BZip2;
-        case kGzipSignature:
-            return &BitFormat::GZip;
-        case kWimSignature:
-            return &BitFormat::Wim;
-        case kXzSignature:
-            return &BitFormat::Xz;
-        case kZipSignature:
-            return &BitFormat::Zip;
-        case kAvbSignature:
-            return &BitFormat::AVB;
-        case kApmSignature:
-            return &BitFormat::APM;
-        case kArjSignature:
-            return &BitFormat::Arj;
-        case kCabSignature:
-            return &BitFormat::Cab;
-        case kChmSignature:
-            return &BitFormat::Chm;
-        case kCompoundSignature:
-            return &BitFormat::Compound;
-        case kCpioSignature1:
-        case kCpioSignature2:
-        case kCpioSignature3:
-            return &BitFormat::Cpio;
-        case kDebSignature:
-            return &BitFormat::Deb;
-            /* DMG signature detection is not this simple
-            case 0x7801730D62626000:
-                return &BitFormat::Dmg;
-            */
-        case kElfSignature:
-            return &BitFormat::Elf;
-        case kPeSignature:
-            return &BitFormat::Pe;
-        case kFlvSignature:
-            return &BitFormat::Flv;
-        case kLpSignature:
-            return &BitFormat::LP;
-        case kLvmSignature:
-            return &BitFormat::LVM;
-        case kLzmaSignature:
-            return &BitFormat::Lzma;
-        case kLzma86Signature:
-            return &BitFormat::Lzma86;
-        case kMachoSignature1:
-        case kMachoSignature2:
-        case kMachoSignature3:
-        case kMachoSignature4:
-            return &BitFormat::Macho;
-        case kMubSignature1:
-        case kMubSignature2:
-            return &BitFormat::Mub;
-        case kMslzSignature:
-            return &BitFormat::Mslz;
-        case kPpmdSignature:
-            return &BitFormat::Ppmd;
-        case kQcowSignature:
-            return &BitFormat::QCow;
-        case kRpmSignature:
-            return &BitFormat::Rpm;
-        case kSparseSignature:
-            return &BitFormat::Sparse;
-        case kSquashfsSignature1:
-        case kSquashfsSignature2:
-        case kSquashfsSignature3:
-        case kSquashfsSignature4:
-            return &BitFormat::SquashFS;
-        case kSwfSignature:
-            return &BitFormat::Swf;
-        case kSwfcSignature1:
-        case kSwfcSignature2:
-            return &BitFormat::Swfc;
-        case kTeSignature:
-            return &BitFormat::TE;
-        case kVmdkSignature: // K  D  M  V
-            return &BitFormat::VMDK;
-        case kVdiSignature: // Alternatively, 0x7F10DABE at offset 0x40
-            return &BitFormat::VDI;
-        case kVhdSignature: // c  o  n  e  c  t  i  x
-            return &BitFormat::Vhd;
-        case kVhdxSignature: // v  h  d  x  f  i  l  e
-            return &BitFormat::Vhdx;
-        case kXarSignature: // x  a  r  !  00 1C
-            return &BitFormat::Xar;
-        case kZSignature1: // 1F 9D
-        case kZSignature2: // 1F A0
-            return &BitFormat::Z;
-        case kZstdSignature:
-            return &BitFormat::Zstd;
-        default:
-            return nullptr;
+/* NOTE: the signatures are stored as big-endian integers, i.e., the first byte of the signature is the most
+ *       significant byte of the integer, and the unused bytes (for signatures shorter than 8 bytes) are set to 0. */
+constexpr auto kMaxSignatureSize = 8U;
+constexpr auto kMinSignatureSize = 2U;
+constexpr auto kByteBits = 8U;
+
+/* Size (in bytes) of a signature at the beginning of the file, ignoring its trailing zero bytes
+ * (but considering at least the first two bytes, as the signature detection of previous versions of bit7z). */
+constexpr auto file_signature_size( uint64_t signature ) noexcept -> uint32_t {
+    uint32_t size = kMaxSignatureSize;
+    while ( size > kMinSignatureSize && ( ( signature >> ( ( kMaxSignatureSize - size ) * kByteBits ) ) & 0xFFU ) == 0 ) {
+        --size;
     }
+    return size;
 }
 
-struct OffsetSignature {
+constexpr auto signature_mask( uint32_t size ) noexcept -> uint64_t {
+    return size >= kMaxSignatureSize ? ~0ULL : ~( ~0ULL >> ( size * kByteBits ) );
+}
+
+struct Signature {
     uint64_t signature;
-    std::streamoff offset;
+    uint64_t mask;
+    uint32_t offset;
     uint32_t size;
-    const BitInFormat& format;
+    const BitInFormat* format;
+
+    constexpr Signature( uint64_t fileSignature, const BitInFormat& signatureFormat ) noexcept
+        : signature{ fileSignature },
+          mask{ signature_mask( file_signature_size( fileSignature ) ) },
+          offset{ 0 },
+          size{ file_signature_size( fileSignature ) },
+          format{ &signatureFormat } {}
+
+    constexpr Signature( uint64_t offsetSignature,
+                         uint32_t signatureOffset,
+                         uint32_t signatureSize,
+                         const BitInFormat& signatureFormat ) noexcept
+        : signature{ offsetSignature },
+          mask{ signature_mask( signatureSize ) },
+          offset{ signatureOffset },
+          size{ signatureSize },
+          format{ &signatureFormat } {}
 };
 
-#if defined(_WIN32)
-#define bswap64 _byteswap_uint64
-#elif defined(__GNUC__) || defined(__clang__)
-//Note: the versions of gcc and clang that can compile bit7z should also have this builtin, hence there is no need
-//      for checking the compiler version or using the _has_builtin macro.
-#ifndef bswap64
-#define bswap64 __builtin_bswap64
-#endif
-#else
-static inline uint64_t bswap64( uint64_t x ) {
-    return  ((x << 56) & 0xff00000000000000ULL) |
-            ((x << 40) & 0x00ff000000000000ULL) |
-            ((x << 24) & 0x0000ff0000000000ULL) |
-            ((x << 8)  & 0x000000ff00000000ULL) |
-            ((x >> 8)  & 0x00000000ff000000ULL) |
-            ((x >> 24) & 0x0000000000ff0000ULL) |
-            ((x >> 40) & 0x000000000000ff00ULL) |
-            ((x >> 56) & 0x00000000000000ffULL);
-}
-#endif
+// Signatures at the beginning of the file; if more than one signature matches, the longest one is used.
+constexpr Signature kFileSignatures[] = { // NOLINT(*-avoid-c-arrays)
+    { 0x526172211A070000ULL, BitFormat::Rar },      // Rar! 0x1A 0x07 0x00
+    { 0x526172211A070100ULL, BitFormat::Rar5 },     // Rar! 0x1A 0x07 0x01 0x00
+    { 0x377ABCAF271C0000ULL, BitFormat::SevenZip }, // 7z 0xBC 0xAF 0x27 0x1C
+    { 0x425A680000000000ULL, BitFormat::BZip2 },    // BZh
+    { 0x1F8B080000000000ULL, BitFormat::GZip },     // 0x1F 0x8B 0x08
+    { 0x4D5357494D000000ULL, BitFormat::Wim },      // MSWIM 0x00 0x00 0x00
+    { 0xFD377A585A000000ULL, BitFormat::Xz },       // 0xFD 7zXZ 0x00
+    { 0x504B000000000000ULL, BitFormat::Zip },      // PK
+    { 0x4156426600000000ULL, BitFormat::AVB },      // AVBf 0x00 0x00 0x00
+    { 0x4552000000000000ULL, BitFormat::APM },      // ER
+    { 0x60EA000000000000ULL, BitFormat::Arj },      // `EA
+    { 0x4D53434600000000ULL, BitFormat::Cab },      // MSCF 0x00 0x00 0x00 0x00
+    { 0x4954534603000000ULL, BitFormat::Chm },      // ITSF 0x03
+    { 0xD0CF11E0A1B11AE1ULL, BitFormat::Compound }, // 0xD0 0xCF 0x11 0xE0 0xA1 0xB1 0x1A 0xE1
+    { 0xC771000000000000ULL, BitFormat::Cpio },     // 0xC7 q
+    { 0x71C7000000000000ULL, BitFormat::Cpio },     // q 0xC7
+    { 0x3037303730000000ULL, BitFormat::Cpio },     // 07070
+    { 0x213C617263683E00ULL, BitFormat::Deb },      // !<arch>0A
+    /* DMG signature detection is not this simple
+    { 0x7801730D62626000ULL, BitFormat::Dmg }, */
+    { 0x7F454C4600000000ULL, BitFormat::Elf },      // 0x7F ELF
+    { 0x4D5A000000000000ULL, BitFormat::Pe },       // MZ
+    { 0x464C560100000000ULL, BitFormat::Flv },      // FLV 0x01
+    { 0x67446C6134000000ULL, BitFormat::LP },       // gDla4
+    { 0x4C4142454C4F4E45ULL, BitFormat::LVM },      // LABELONE
+    { 0x5D00000000000000ULL, BitFormat::Lzma },     // 0x5D 0x00
+    { 0x015D000000000000ULL, BitFormat::Lzma86 },   // 0x01 0x5D
+    { 0xCEFAEDFE00000000ULL, BitFormat::Macho },    // 0xCE 0xFA 0xED 0xFE
+    { 0xCFFAEDFE00000000ULL, BitFormat::Macho },    // 0xCF 0xFA 0xED 0xFE
+    { 0xFEEDFACE00000000ULL, BitFormat::Macho },    // 0xFE 0xED 0xFA 0xCE
+    { 0xFEEDFACF00000000ULL, BitFormat::Macho },    // 0xFE 0xED 0xFA 0xCF
+    { 0xCAFEBABE00000000ULL, BitFormat::Mub },      // 0xCA 0xFE 0xBA 0xBE 0x00 0x00 0x00
+    { 0xB9FAF10E00000000ULL, BitFormat::Mub },      // 0xB9 0xFA 0xF1 0x0E
+    { 0x535A444488F02733ULL, BitFormat::Mslz },     // SZDD 0x88 0xF0 '3
+    { 0x8FAFAC8400000000ULL, BitFormat::Ppmd },     // 0x8F 0xAF 0xAC 0x84
+    { 0x514649FB00000000ULL, BitFormat::QCow },     // QFI 0xFB 0x00 0x00 0x00
+    { 0xEDABEEDB00000000ULL, BitFormat::Rpm },      // 0xED 0xAB 0xEE 0xDB
+    { 0x3AFF26ED00000000ULL, BitFormat::Sparse },   // 0x3A 0xFF 0x26 0xED
+    { 0x7371736800000000ULL, BitFormat::SquashFS }, // sqsh
+    { 0x6873717300000000ULL, BitFormat::SquashFS }, // hsqs
+    { 0x7368737100000000ULL, BitFormat::SquashFS }, // shsq
+    { 0x7173687300000000ULL, BitFormat::SquashFS }, // qshs
+    { 0x4657530000000000ULL, BitFormat::Swf },      // FWS
+    { 0x4357530000000000ULL, BitFormat::Swfc },     // CWS
+    { 0x5A57530000000000ULL, BitFormat::Swfc },     // ZWS
+    { 0x565A000000000000ULL, BitFormat::TE },       // VZ
+    { 0x4B444D0000000000ULL, BitFormat::VMDK },     // KDM
+    { 0x3C3C3C2000000000ULL, BitFormat::VDI },      // <<< 0x20 (alternatively, 0x7F10DABE at offset 0x40)
+    { 0x636F6E6563746978ULL, BitFormat::Vhd },      // conectix
+    { 0x7668647866696C65ULL, BitFormat::Vhdx },     // vhdxfile
+    { 0x78617221001C0000ULL, BitFormat::Xar },      // xar! 0x00 0x1C
+    { 0x1F9D000000000000ULL, BitFormat::Z },        // 0x1F 0x9D
+    { 0x1FA0000000000000ULL, BitFormat::Z },        // 0x1F 0xA0
+    { 0x28B52FFD00000000ULL, BitFormat::Zstd }      // 0x28 0xB5 0x2F 0xFD
+};
 
-auto read_signature( IInStream* stream, uint32_t size ) noexcept -> uint64_t {
+// Signatures at a given offset of the file, checked in order.
+constexpr Signature kOffsetSignatures[] = { // NOLINT(*-avoid-c-arrays)
+    { 0x2D6C680000000000ULL, 0x02,  3, BitFormat::Lzh },    // -lh
+    { 0x4E54465320202020ULL, 0x03,  8, BitFormat::Ntfs },   // NTFS 0x20 0x20 0x20 0x20
+    { 0x4E756C6C736F6674ULL, 0x08,  8, BitFormat::Nsis },   // Nullsoft
+    { 0x436F6D7072657373ULL, 0x10,  8, BitFormat::CramFS }, // Compress
+    { 0x4E58534200000000ULL, 0x20,  4, BitFormat::APFS },   // NXSB
+    { 0x7F10DABE00000000ULL, 0x40,  4, BitFormat::VDI },    // 0x7F 0x10 0xDA 0xBE
+    { 0x7573746172000000ULL, 0x101, 5, BitFormat::Tar },    // ustar
+    /* Note: since GPT files contain also the FAT signature, we must check the GPT signature before the FAT one. */
+    { 0x4546492050415254ULL, 0x200, 8, BitFormat::GPT },    // EFI 0x20 PART
+    { 0x55AA000000000000ULL, 0x1FE, 2, BitFormat::Fat },    // U 0xAA
+    { 0x4244000000000000ULL, 0x400, 2, BitFormat::Hfs },    // BD
+    { 0x482B000400000000ULL, 0x400, 4, BitFormat::Hfs },    // H+ 0x00 0x04
+    { 0x4858000500000000ULL, 0x400, 4, BitFormat::Hfs },    // HX 0x00 0x05
+    { 0x53EF000000000000ULL, 0x438, 2, BitFormat::Ext }     // S 0xEF
+};
+
+// Reads the big-endian signature at the given offset of the data (missing bytes are considered to be 0).
+inline auto load_signature( const byte_t* data, std::size_t size, std::size_t offset ) noexcept -> uint64_t {
     uint64_t signature = 0;
-    stream->Read( &signature, size, nullptr );
-    return bswap64( signature );
+    for ( std::size_t index = 0; index < kMaxSignatureSize; ++index ) {
+        signature <<= kByteBits;
+        if ( offset + index < size ) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            signature |= static_cast< uint8_t >( data[ offset + index ] );
+        }
+    }
+    return signature;
 }
 
-// Note: the left shifting of the signature mask might overflow, but it is intentional, so we suppress the sanitizer.
-auto detect_format_from_signature( IInStream* stream ) -> const BitInFormat& {
-    constexpr auto kSignatureSize = 8U;
-    constexpr auto kBaseSignatureMask = 0xFFFFFFFFFFFFFFFFULL;
-    constexpr auto kByteShift = 8ULL;
-
-    uint64_t fileSignature = read_signature( stream, kSignatureSize );
-    uint64_t signatureMask = kBaseSignatureMask;
-    for ( auto i = 0U; i < kSignatureSize - 1; ++i ) {
-        const BitInFormat* format = find_format_by_signature( fileSignature );
-        if ( format != nullptr ) {
-            stream->Seek( 0, 0, nullptr );
-            return *format;
+inline auto matches( const Signature& signature, const byte_t* data, std::size_t size ) noexcept -> bool {
+    return ( load_signature( data, size, signature.offset ) & signature.mask ) == signature.signature;
+}
+
+auto find_format_by_signature( const byte_t* data, std::size_t size ) noexcept -> const BitInFormat* {
+    const BitInFormat* format = nullptr;
+    const uint64_t fileSignature = load_signature( data, size, 0 );
+    uint32_t matchedSize = 0;
+    for ( const auto& signature : kFileSignatures ) {
+        if ( signature.size > matchedSize && ( fileSignature & signature.mask ) == signature.signature ) {
+            format = signature.format;
+            matchedSize = signature.size;
         }
-        signatureMask <<= kByteShift;    // left shifting the mask of one byte, so that
-        fileSignature &= signatureMask;  // the least significant i bytes are masked (set to 0)
+    }
+    if ( format != nullptr ) {
+        return format;
     }
 
-    static const OffsetSignature commonSignaturesWithOffset[] = { // NOLINT(*-avoid-c-arrays)
-        { 0x2D6C680000000000, 0x02,  3, BitFormat::Lzh },    // -lh
-        { 0x4E54465320202020, 0x03,  8, BitFormat::Ntfs },   // NTFS 0x20 0x20 0x20 0x20
-        { 0x4E756C6C736F6674, 0x08,  8, BitFormat::Nsis },   // Nullsoft
-        { 0x436F6D7072657373, 0x10,  8, BitFormat::CramFS }, // Compress
-        { 0x4E58534200000000, 0x20,  4, BitFormat::APFS },   // NXSB
-        { 0x7F10DABE00000000, 0x40,  4, BitFormat::VDI },    // 0x7F 0x10 0xDA 0xBE
-        { 0x7573746172000000, 0x101, 5, BitFormat::Tar },    // ustar
-        /* Note: since GPT files contain also the FAT signature, we must check the GPT signature before the FAT one. */
-        { 0x4546492050415254, 0x200, 8, BitFormat::GPT },    // EFI 0x20 PART
-        { 0x55AA000000000000, 0x1FE, 2, BitFormat::Fat },    // U 0xAA
-        { 0x4244000000000000, 0x400, 2, BitFormat::Hfs },    // BD
-        { 0x482B000400000000, 0x400, 4, BitFormat::Hfs },    // H+ 0x00 0x04
-        { 0x4858000500000000, 0x400, 4, BitFormat::Hfs },   // HX 0x00 0x05
-        { 0x53EF000000000000, 0x438, 2, BitFormat::Ext }    // S 0xEF
-    };
-
-    for ( const auto& sig : commonSignaturesWithOffset ) {
-        stream->Seek( sig.offset, 0, nullptr );
-        fileSignature = read_signature( stream, sig.size );
-        if ( fileSignature == sig.signature ) {
-            stream->Seek( 0, 0, nullptr );
-            return sig.format;
+    for ( const auto& signature : kOffsetSignatures ) {
+        if ( matches( signature, data, size ) ) {
+            return signature.format;
         }
     }
 
     // Detecting ISO/UDF
-    constexpr auto kBeaSignature = 0x4245413031000000; // BEA01 (beginning of the extended descriptor section)
-    constexpr auto kIsoSignature = 0x4344303031000000; // CD001 (ISO format signature)
-    constexpr auto kIsoSignatureSize = 5ULL;
-    constexpr auto kIsoSignatureOffset = 0x8001;
+    constexpr auto kBeaSignature = 0x4245413031000000ULL; // BEA01 (beginning of the extended descriptor section)
+    constexpr auto kIsoSignature = 0x4344303031000000ULL; // CD001 (ISO format signature)
+    constexpr auto kIsoSignatureSize = 5U;
+    constexpr auto kIsoSignatureOffset = 0x8001U;
 
     // Checking for ISO signature
-    stream->Seek( kIsoSignatureOffset, 0, nullptr );
-    fileSignature = read_signature( stream, kIsoSignatureSize );
-
-    const bool isIso = fileSignature == kIsoSignature;
-    if ( isIso || fileSignature == kBeaSignature ) {
-        constexpr auto kMaxVolumeDescriptors = 16;
-        constexpr auto kIsoVolumeDescriptorSize = 0x800; //2048
+    const uint64_t isoSignature = load_signature( data, size, kIsoSignatureOffset ) & signature_mask( kIsoSignatureSize );
+    const bool isIso = isoSignature == kIsoSignature;
+    if ( isIso || isoSignature == kBeaSignature ) {
+        constexpr auto kMaxVolumeDescriptors = 16U;
+        constexpr auto kIsoVolumeDescriptorSize = 0x800U; //2048
 
-        constexpr auto kUdfSignature = 0x4E53523000000000; //NSR0
+        constexpr auto kUdfSignature = 0x4E53523000000000ULL; //NSR0
         constexpr auto kUdfSignatureSize = 4U;
 
-        for ( auto descriptorIndex = 1; descriptorIndex < kMaxVolumeDescriptors; ++descriptorIndex ) {
-            stream->Seek( kIsoSignatureOffset + descriptorIndex * kIsoVolumeDescriptorSize, 0, nullptr );
-            fileSignature = read_signature( stream, kUdfSignatureSize );
-
-            if ( fileSignature == kUdfSignature ) { // The file is ISO+UDF or just UDF
-                stream->Seek( 0, 0, nullptr );
-                return BitFormat::Udf;
+        for ( auto descriptorIndex = 1U; descriptorIndex < kMaxVolumeDescriptors; ++descriptorIndex ) {
+            const auto descriptorOffset = kIsoSignatureOffset + ( descriptorIndex * kIsoVolumeDescriptorSize );
+            const uint64_t udfSignature = load_signature( data, size, descriptorOffset );
+            if ( ( udfSignature & signature_mask( kUdfSignatureSize ) ) == kUdfSignature ) {
+                return &BitFormat::Udf; // The file is ISO+UDF or just UDF
             }
         }
 
         if ( isIso ) { // The file is pure ISO (no UDF).
-            stream->Seek( 0, 0, nullptr );
-            return BitFormat::Iso; //No UDF volume signature found, i.e. simple ISO!
+            return &BitFormat::Iso;
         }
     }
+    return nullptr;
+}
 
-    stream->Seek( 0, 0, nullptr );
-    throw BitException( "Failed to detect the format of the file",
-                        make_error_code( BitError::NoMatchingSignature ) );
+auto detect_format_from_signature( IInStream* stream ) -> const BitInFormat& {
+    // Reading the first bytes of the file all at once, and matching the signatures in memory.
+    buffer_t probe( kFormatProbeSize );
+    std::size_t probeSize = 0;
+    HRESULT result = stream->Seek( 0, STREAM_SEEK_SET, nullptr );
+    while ( result == S_OK && probeSize < probe.size() ) {
+        UInt32 readSize = 0;
+        result = stream->Read( &probe[ probeSize ], static_cast< UInt32 >( probe.size() - probeSize ), &readSize );
+        if ( readSize == 0 ) {
+            break;
+        }
+        probeSize += readSize;
+    }
+    stream->Seek( 0, STREAM_SEEK_SET, nullptr );
+
+    const BitInFormat* format = find_format_by_signature( probe.data(), probeSize );
+    if ( format == nullptr ) {
+        throw BitException( "Failed to detect the format of the file",
+                            make_error_code( BitError::NoMatchingSignature ) );
+    }
+    return *format;
 }
 
 #ifdef BIT7Z_DETECT_FROM_EXTENSION
@@ -14,8 +14,11 @@
 
 #ifdef BIT7Z_AUTO_FORMAT
 
+#include <cstddef>
+
 #include "bitformat.hpp"
 #include "bitfs.hpp"
+#include "bittypes.hpp"
 
 struct IInStream;
 
@@ -27,6 +30,16 @@ auto detect_format_from_extension( const fs::path& inFile ) -> const BitInFormat
 
 #endif
 
+/**
+ * @brief Matches the signatures of the supported formats against the given data (i.e., the first bytes of a file).
+ *
+ * @param data  the first bytes of the file (ideally, kFormatProbeSize bytes).
+ * @param size  the number of bytes pointed by data.
+ *
+ * @return the detected format, or nullptr if no signature matched.
+ */
+auto find_format_by_signature( const byte_t* data, std::size_t size ) noexcept -> const BitInFormat*;
+
 auto detect_format_from_signature( IInStream * stream ) -> const BitInFormat&;
 
 } // namespace bit7z
@@ -11,6 +11,8 @@
  */
 
 #include <algorithm> //for std::adjacent_find
+#include <array>
+#include <utility>
 
 #include "biterror.hpp"
 #include "bitexception.hpp"
@@ -217,6 +219,33 @@ auto fsutil::set_file_attributes(
 #endif
 }
 
+#ifndef _WIN32
+auto fsutil::set_file_attributes( int fileDescriptor, DWORD attributes ) noexcept -> bool {
+    struct stat fileStat{};
+    if ( ::fstat( fileDescriptor, &fileStat ) != 0 ) {
+        return false;
+    }
+
+    if ( ( attributes & FILE_ATTRIBUTE_UNIX_EXTENSION ) != 0 ) {
+        fileStat.st_mode = static_cast< mode_t >( attributes >> 16U );
+        if ( !S_ISREG( fileStat.st_mode ) ) {
+            return true;
+        }
+    } else if ( ( attributes & FILE_ATTRIBUTE_READONLY ) != 0 ) {
+        fileStat.st_mode &= static_cast< mode_t >( ~( S_IWUSR | S_IWGRP | S_IWOTH ) );
+    }
+
+    // Note: fchmod accepts only the permission bits, not the file type ones.
+    const auto filePermissions = static_cast< mode_t >( fileStat.st_mode & global_umask ) &
+                                 static_cast< mode_t >( fs::perms::mask );
+    return ::fchmod( fileDescriptor, filePermissions ) == 0;
+}
+
+auto fsutil::is_symlink_attributes( DWORD attributes ) noexcept -> bool {
+    return ( attributes & FILE_ATTRIBUTE_UNIX_EXTENSION ) != 0 && S_ISLNK( static_cast< mode_t >( attributes >> 16U ) );
+}
+#endif
+
 #ifdef _WIN32
 auto fsutil::set_file_time( const fs::path& filePath,
                             FILETIME creation,
@@ -232,7 +261,7 @@ auto fsutil::set_file_time( const fs::path& filePath,
                                   FILE_SHARE_READ,
                                   nullptr,
                                   OPEN_EXISTING,
-                                  0,
+                                  FILE_FLAG_BACKUP_SEMANTICS, // Needed for opening directories.
                                   nullptr );
     if ( hFile != INVALID_HANDLE_VALUE ) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
         res = ::SetFileTime( hFile, &creation, &access, &modified ) != FALSE;
@@ -251,6 +280,11 @@ auto fsutil::set_file_modified_time( const fs::path& filePath, FILETIME ftModifi
     fs::last_write_time( filePath, fileTime, error );
     return !error;
 }
+
+auto fsutil::set_file_modified_time( int fileDescriptor, FILETIME ftModified ) noexcept -> bool {
+    const std::array< timespec, 2 > fileTimes{ { { 0, UTIME_OMIT }, FILETIME_to_timespec( ftModified ) } };
+    return ::futimens( fileDescriptor, fileTimes.data() ) == 0;
+}
 #endif
 
 auto fsutil::get_file_attributes_ex( const fs::path& filePath,
@@ -324,6 +358,77 @@ auto fsutil::format_long_path( const fs::path& path ) -> fs::path {
 
 #endif
 
+/* Returns the volume number in the given extension (e.g., 12 for ".012"), or 0 if it is not a volume extension.
+ * Note: volume numbers are written using at least three digits, without additional leading zeros. */
+inline auto volume_number( const fs::path::string_type& extension ) noexcept -> std::size_t {
+    constexpr std::size_t kVolumeDigits = 3u;
+    constexpr std::size_t kMaxVolumeDigits = 9u;
+    const auto digits = extension.size() - 1;
+    if ( extension.size() <= kVolumeDigits || digits > kMaxVolumeDigits || extension.front() != '.' ) {
+        return 0;
+    }
+    if ( digits > kVolumeDigits && extension[ 1 ] == '0' ) {
+        return 0;
+    }
+    std::size_t number = 0;
+    for ( std::size_t index = 1; index < extension.size(); ++index ) {
+        const auto character = extension[ index ];
+        if ( character < '0' || character > '9' ) {
+            return 0;
+        }
+        number = ( number * 10 ) + static_cast< std::size_t >( character - '0' );
+    }
+    return number;
+}
+
+// Checks whether the given file names are the same, ignoring their case on Windows (as the filesystem does).
+inline auto same_file_name( const fs::path& first, const fs::path& second ) -> bool {
+#ifdef _WIN32
+    const auto& firstName = first.native();
+    const auto& secondName = second.native();
+    return firstName.size() == secondName.size() &&
+           std::equal( firstName.cbegin(), firstName.cend(), secondName.cbegin(),
+                       []( wchar_t firstChar, wchar_t secondChar ) noexcept -> bool {
+                           // Note: like in path_is_outside_base, CharUpperBuffW converts the case regardless of the locale.
+                           CharUpperBuffW( &firstChar, 1 );
+                           CharUpperBuffW( &secondChar, 1 );
+                           return firstChar == secondChar;
+                       } );
+#else
+    return first == second;
+#endif
+}
+
+auto fsutil::find_volumes( const fs::path& firstVolume ) -> std::vector< fs::path > {
+    const auto volumeName = firstVolume.stem();
+    const auto parentPath = firstVolume.parent_path();
+
+    std::vector< std::pair< std::size_t, fs::path > > foundVolumes;
+    std::error_code error;
+    fs::directory_iterator iterator{ parentPath.empty() ? fs::path{ "." } : parentPath, error };
+    for ( ; !error && iterator != fs::directory_iterator{}; iterator.increment( error ) ) {
+        const auto fileName = iterator->path().filename();
+        if ( !same_file_name( fileName.stem(), volumeName ) ) {
+            continue;
+        }
+        const auto number = volume_number( fileName.extension().native() );
+        if ( number > 0 ) {
+            foundVolumes.emplace_back( number, fileName );
+        }
+    }
+    std::sort( foundVolumes.begin(), foundVolumes.end() );
+
+    // Keeping only the volumes numbered consecutively from the first one.
+    std::vector< fs::path > volumes;
+    for ( const auto& volume : foundVolumes ) {
+        if ( volume.first != volumes.size() + 1 ) {
+            break;
+        }
+        volumes.push_back( parentPath / volume.second );
+    }
+    return volumes;
+}
+
 void fsutil::increase_opened_files_limit() {
 #if defined( _MSC_VER )
     // http://msdn.microsoft.com/en-us/library/6e3b887c.aspx
@@ -11,6 +11,7 @@
 #define FSUTIL_HPP
 
 #include <string>
+#include <vector>
 
 #include "bitdefines.hpp"
 #include "bittypes.hpp"
@@ -62,6 +63,8 @@ BIT7Z_NODISCARD auto get_file_attributes_ex( const fs::path& filePath,
 auto set_file_time( const fs::path& filePath, FILETIME creation, FILETIME access, FILETIME modified ) noexcept -> bool;
 #else
 auto set_file_modified_time( const fs::path& filePath, FILETIME ftModified ) noexcept -> bool;
+
+auto set_file_modified_time( int fileDescriptor, FILETIME ftModified ) noexcept -> bool;
 #endif
 
 auto set_file_attributes(
@@ -70,6 +73,18 @@ auto set_file_attributes(
     DWORD attributes
 ) noexcept -> bool;
 
+#ifndef _WIN32
+/**
+ * Sets the permissions of the open regular file with the given descriptor.
+ *
+ * @note Items having the attributes of a symbolic link are not affected,
+ * as they must be restored through their path (see SafeOutPathBuilder::restoreSymlink).
+ */
+auto set_file_attributes( int fileDescriptor, DWORD attributes ) noexcept -> bool;
+
+BIT7Z_NODISCARD auto is_symlink_attributes( DWORD attributes ) noexcept -> bool;
+#endif
+
 BIT7Z_NODISCARD auto in_archive_path( const fs::path& filePath,
                                       const fs::path& searchPath = fs::path{} ) -> fs::path;
 
@@ -86,6 +101,19 @@ BIT7Z_NODISCARD auto format_long_path( const fs::path& path ) -> fs::path;
 #   define FORMAT_LONG_PATH( path ) path
 #endif
 
+/**
+ * @brief Finds the volumes of the split archive whose first volume is at the given path (e.g., "archive.7z.001"),
+ * i.e., the files in the same directory having the same name, and the consecutive volume numbers as extension
+ * (e.g., "archive.7z.002", "archive.7z.003", ...).
+ *
+ * @note The directory is scanned only once, instead of checking the existence of each volume.
+ *
+ * @param firstVolume the path of the first volume of the split archive.
+ *
+ * @return the paths of the volumes, sorted by volume number (empty if the first volume does not exist).
+ */
+BIT7Z_NODISCARD auto find_volumes( const fs::path& firstVolume ) -> std::vector< fs::path >;
+
 /**
  * @brief When writing multi-volume archives, we keep all the volume streams open until we finished.
  * This is less than ideal, and there's a limit in the number of open file descriptors/handles.
@@ -43,6 +43,9 @@ const GUID IID_IStreamGetProps = {
 const GUID IID_IStreamGetProps2 = {
     0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00 }
 };
+const GUID IID_IStreamSetRestriction = {
+    0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x03, 0x00, 0x10, 0x00, 0x00 }
+};
 
 // ICoder.h
 const GUID IID_ICompressProgressInfo = {
@@ -76,6 +79,9 @@ const GUID IID_IArchiveOpenVolumeCallback = {
 const GUID IID_IArchiveOpenSetSubArchiveName = {
     0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x06, 0x00, 0x50, 0x00, 0x00 }
 };
+const GUID IID_IArchiveOpenSeq = {
+    0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x06, 0x00, 0x61, 0x00, 0x00 }
+};
 const GUID IID_IArchiveUpdateCallback = {
     0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x06, 0x00, 0x80, 0x00, 0x00 }
 };
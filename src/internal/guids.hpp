@@ -27,6 +27,7 @@ extern const GUID IID_IOutStream;
 extern const GUID IID_IStreamGetSize;
 extern const GUID IID_IStreamGetProps;
 extern const GUID IID_IStreamGetProps2;
+extern const GUID IID_IStreamSetRestriction;
 
 // ICoder.h
 extern const GUID IID_ICompressProgressInfo;
@@ -42,6 +43,7 @@ extern const GUID IID_IOutArchive;
 extern const GUID IID_IArchiveExtractCallback;
 extern const GUID IID_IArchiveOpenVolumeCallback;
 extern const GUID IID_IArchiveOpenSetSubArchiveName;
+extern const GUID IID_IArchiveOpenSeq;
 extern const GUID IID_IArchiveUpdateCallback;
 extern const GUID IID_IArchiveUpdateCallback2;
 }
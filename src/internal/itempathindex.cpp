@@ -0,0 +1,85 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/itempathindex.hpp"
+
+#include "internal/stringutil.hpp"
+
+#include <type_traits>
+
+namespace bit7z {
+
+constexpr uint32_t ItemPathIndex::kNotFound;
+
+constexpr auto kFnvOffsetBasis = 2166136261u;
+constexpr auto kFnvPrime = 16777619u;
+
+inline auto normalized_length( const tstring& itemPath ) noexcept -> std::size_t {
+    // Trailing path separators are ignored (e.g., "folder/" is the same as "folder").
+    auto length = itemPath.size();
+    while ( length > 1 && isPathSeparator( itemPath[ length - 1 ] ) ) {
+        --length;
+    }
+    return length;
+}
+
+inline auto normalized_char( tchar character ) noexcept -> tchar {
+    return isPathSeparator( character ) ? BIT7Z_STRING( '/' ) : character;
+}
+
+inline auto slots_count( uint32_t itemsCount ) noexcept -> std::size_t {
+    // Keeping the load factor below 0.5, so that the probe sequences stay short.
+    std::size_t count = 8;
+    while ( count < static_cast< std::size_t >( itemsCount ) * 2 ) {
+        count *= 2;
+    }
+    return count;
+}
+
+ItemPathIndex::ItemPathIndex( uint32_t itemsCount )
+    : mSlots( slots_count( itemsCount ), Slot{ 0, kNotFound } ),
+      mMask{ static_cast< uint32_t >( mSlots.size() - 1 ) } {}
+
+void ItemPathIndex::insert( const tstring& itemPath, uint32_t itemIndex ) {
+    const auto pathHash = hash( itemPath );
+    auto slot = pathHash & mMask;
+    while ( mSlots[ slot ].index != kNotFound ) {
+        slot = ( slot + 1 ) & mMask;
+    }
+    mSlots[ slot ] = Slot{ pathHash, itemIndex };
+}
+
+auto ItemPathIndex::equals( const tstring& firstPath, const tstring& secondPath ) noexcept -> bool {
+    const auto length = normalized_length( firstPath );
+    if ( length != normalized_length( secondPath ) ) {
+        return false;
+    }
+    for ( std::size_t i = 0; i < length; ++i ) {
+        if ( normalized_char( firstPath[ i ] ) != normalized_char( secondPath[ i ] ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto ItemPathIndex::hash( const tstring& itemPath ) noexcept -> uint32_t {
+    // FNV-1a hash of the normalized path.
+    uint32_t result = kFnvOffsetBasis;
+    const auto length = normalized_length( itemPath );
+    for ( std::size_t i = 0; i < length; ++i ) {
+        result ^= static_cast< std::make_unsigned< tchar >::type >( normalized_char( itemPath[ i ] ) );
+        result *= kFnvPrime;
+    }
+    return result;
+}
+
+} // namespace bit7z
@@ -0,0 +1,75 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ITEMPATHINDEX_HPP
+#define ITEMPATHINDEX_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * Open-addressing (linear probing) hash index from normalized item paths to item indices.
+ *
+ * Paths are not stored in the index: each slot keeps only the hash of the path and the index of the item,
+ * so a lookup must confirm each candidate via a predicate (see find).
+ */
+class ItemPathIndex final {
+    public:
+        static constexpr auto kNotFound = std::numeric_limits< uint32_t >::max();
+
+        explicit ItemPathIndex( uint32_t itemsCount );
+
+        /**
+         * Inserts the given item in the index; if more items have the same path,
+         * lookups will return the first inserted one.
+         */
+        void insert( const tstring& itemPath, uint32_t itemIndex );
+
+        /**
+         * @return the index of the first inserted item whose path matches the given one
+         *         and for which isSameItem returns true, or kNotFound.
+         */
+        template< typename Predicate >
+        BIT7Z_NODISCARD auto find( const tstring& itemPath, Predicate&& isSameItem ) const -> uint32_t {
+            const auto pathHash = hash( itemPath );
+            for ( auto slot = pathHash & mMask; mSlots[ slot ].index != kNotFound; slot = ( slot + 1 ) & mMask ) {
+                if ( mSlots[ slot ].hash == pathHash && isSameItem( mSlots[ slot ].index ) ) {
+                    return mSlots[ slot ].index;
+                }
+            }
+            return kNotFound;
+        }
+
+        /**
+         * @return whether the two paths are equal once normalized (i.e., ignoring trailing path separators,
+         *         and, on Windows, the kind of path separators used).
+         */
+        static auto equals( const tstring& firstPath, const tstring& secondPath ) noexcept -> bool;
+
+    private:
+        struct Slot {
+            uint32_t hash;
+            uint32_t index;
+        };
+
+        std::vector< Slot > mSlots;
+        uint32_t mMask;
+
+        static auto hash( const tstring& itemPath ) noexcept -> uint32_t;
+};
+
+}  // namespace bit7z
+
+#endif //ITEMPATHINDEX_HPP
@@ -0,0 +1,157 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/itempipe.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bit7z {
+
+ItemPipe::ItemPipe( std::size_t capacity )
+    : mBuffer( std::max< std::size_t >( capacity, 1 ) ),
+      mReadPosition{ 0 },
+      mStoredSize{ 0 },
+      mItemIndex{ 0 },
+      mItemRequested{ false },
+      mItemAnnounced{ false },
+      mItemStarted{ false },
+      mItemEnded{ false },
+      mDiscarding{ false },
+      mFinished{ false },
+      mClosed{ false } {}
+
+auto ItemPipe::beginItem( uint32_t index ) -> bool {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    mProducerCondition.wait( lock, [this]() { return mItemRequested || mClosed; } );
+    if ( mClosed ) {
+        return false;
+    }
+    mItemRequested = false;
+    mItemAnnounced = true;
+    mItemStarted = false;
+    mItemEnded = false;
+    mDiscarding = false;
+    mItemIndex = index;
+    mConsumerCondition.notify_all();
+
+    mProducerCondition.wait( lock, [this]() { return mItemStarted || mClosed; } );
+    return !mClosed;
+}
+
+auto ItemPipe::write( const byte_t* data, std::size_t size ) -> bool {
+    while ( size > 0 ) {
+        std::unique_lock< std::mutex > lock{ mMutex };
+        mProducerCondition.wait( lock, [this]() {
+            return mStoredSize < mBuffer.size() || mDiscarding || mClosed;
+        } );
+        if ( mClosed ) {
+            return false;
+        }
+        if ( mDiscarding ) { // The consumer skipped the rest of the item.
+            return true;
+        }
+
+        // Copying as much data as possible, in at most two chunks (the buffer is circular).
+        const auto capacity = mBuffer.size();
+        const auto writePosition = ( mReadPosition + mStoredSize ) % capacity;
+        const auto chunkSize = std::min( { size, capacity - mStoredSize, capacity - writePosition } );
+        std::memcpy( &mBuffer[ writePosition ], data, chunkSize );
+        mStoredSize += chunkSize;
+        data += chunkSize; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size -= chunkSize;
+        mConsumerCondition.notify_all();
+    }
+    return true;
+}
+
+void ItemPipe::endItem() {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mItemEnded = true;
+    mConsumerCondition.notify_all();
+}
+
+void ItemPipe::finish( std::exception_ptr error ) {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mFinished = true;
+    mError = std::move( error );
+    mConsumerCondition.notify_all();
+}
+
+auto ItemPipe::nextItem( uint32_t& index ) -> bool {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    if ( mItemAnnounced && !mItemEnded ) {
+        mDiscarding = true;
+    }
+    mItemAnnounced = false;
+    mReadPosition = 0;
+    mStoredSize = 0;
+    mItemRequested = true;
+    mProducerCondition.notify_all();
+
+    mConsumerCondition.wait( lock, [this]() { return mItemAnnounced || mFinished; } );
+    if ( mItemAnnounced ) {
+        index = mItemIndex;
+        return true;
+    }
+    rethrowError();
+    return false;
+}
+
+void ItemPipe::startItem() {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mItemStarted = true;
+    mProducerCondition.notify_all();
+}
+
+auto ItemPipe::read( byte_t* buffer, std::size_t size ) -> std::size_t {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    if ( !mItemAnnounced || size == 0 ) {
+        return 0;
+    }
+    mConsumerCondition.wait( lock, [this]() { return mStoredSize > 0 || mItemEnded || mFinished; } );
+    if ( mStoredSize == 0 ) {
+        if ( !mItemEnded ) { // The extraction finished (or failed) before the end of the item.
+            rethrowError();
+        }
+        return 0;
+    }
+
+    const auto capacity = mBuffer.size();
+    std::size_t readSize = 0;
+    while ( readSize < size && mStoredSize > 0 ) {
+        const auto chunkSize = std::min( { size - readSize, mStoredSize, capacity - mReadPosition } );
+        std::memcpy( buffer + readSize, &mBuffer[ mReadPosition ], chunkSize ); //-V2563
+        mReadPosition = ( mReadPosition + chunkSize ) % capacity;
+        mStoredSize -= chunkSize;
+        readSize += chunkSize;
+    }
+    mProducerCondition.notify_all();
+    return readSize;
+}
+
+void ItemPipe::close() noexcept {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mClosed = true;
+    mProducerCondition.notify_all();
+    mConsumerCondition.notify_all();
+}
+
+void ItemPipe::rethrowError() {
+    if ( mError ) {
+        auto error = mError;
+        mError = nullptr; // The error is reported only once.
+        std::rethrow_exception( error );
+    }
+}
+
+} // namespace bit7z
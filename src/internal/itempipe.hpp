@@ -0,0 +1,108 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ITEMPIPE_HPP
+#define ITEMPIPE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * A bounded ring buffer moving the content of the extracted items from a producer thread
+ * (running the extraction) to a consumer thread (reading the items one after the other).
+ *
+ * The producer is allowed to start writing an item only after the consumer requested it (nextItem),
+ * and accepted it (startItem): in between, the producer is parked, so the consumer can safely query
+ * the archive for the item's properties.
+ * When the buffer is full, the producer waits for the consumer to read some data (backpressure).
+ */
+class ItemPipe final {
+    public:
+        explicit ItemPipe( std::size_t capacity );
+
+        // Producer side
+
+        /**
+         * @brief Announces a new item, and waits until the consumer accepts it.
+         *
+         * @return false if the consumer closed the pipe.
+         */
+        auto beginItem( uint32_t index ) -> bool;
+
+        /**
+         * @brief Writes the given data of the current item, waiting whenever the buffer is full.
+         *
+         * @return false if the consumer closed the pipe.
+         */
+        auto write( const byte_t* data, std::size_t size ) -> bool;
+
+        void endItem();
+
+        void finish( std::exception_ptr error );
+
+        // Consumer side
+
+        /**
+         * @brief Discards the rest of the current item (if any), and waits for the next one.
+         *
+         * @return true if a new item was announced by the producer (and index was set),
+         *         false if the extraction has finished; if the extraction failed, its error is rethrown.
+         */
+        auto nextItem( uint32_t& index ) -> bool;
+
+        /**
+         * @brief Lets the producer start writing the item returned by the last call to nextItem.
+         */
+        void startItem();
+
+        /**
+         * @brief Reads at most size bytes of the current item, waiting until some data is available.
+         *
+         * @return the number of bytes read, or 0 if the current item has no more data.
+         */
+        auto read( byte_t* buffer, std::size_t size ) -> std::size_t;
+
+        /**
+         * @brief Stops the producer (its subsequent calls to beginItem and write will return false).
+         */
+        void close() noexcept;
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mProducerCondition;
+        std::condition_variable mConsumerCondition;
+
+        std::vector< byte_t > mBuffer;
+        std::size_t mReadPosition;
+        std::size_t mStoredSize;
+
+        uint32_t mItemIndex;
+        bool mItemRequested;
+        bool mItemAnnounced;
+        bool mItemStarted;
+        bool mItemEnded;
+        bool mDiscarding;
+        bool mFinished;
+        bool mClosed;
+        std::exception_ptr mError;
+
+        void rethrowError();
+};
+
+}  // namespace bit7z
+
+#endif //ITEMPIPE_HPP
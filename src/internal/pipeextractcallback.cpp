@@ -0,0 +1,56 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/pipeextractcallback.hpp"
+#include "internal/cpipeoutstream.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+PipeExtractCallback::PipeExtractCallback( const BitInputArchive& inputArchive, ItemPipe& pipe )
+    : ExtractCallback( inputArchive ),
+      mPipe( pipe ) {}
+
+void PipeExtractCallback::releaseStream() {
+    mPipeOutStream.Release();
+}
+
+auto PipeExtractCallback::finishOperation( OperationResult operationResult ) -> HRESULT {
+    // Note: if the item failed, the reader will get the extraction error, instead of the end of the item.
+    if ( mPipeOutStream != nullptr && operationResult == OperationResult::Success ) {
+        mPipe.endItem();
+    }
+    return ExtractCallback::finishOperation( operationResult );
+}
+
+auto PipeExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT {
+    if ( isItemFolder( index ) ) {
+        return S_OK;
+    }
+
+    // Waiting for the reader to move to this item.
+    if ( !mPipe.beginItem( index ) ) {
+        return E_ABORT;
+    }
+
+    if ( mHandler.fileCallback() ) {
+        const BitPropVariant itemPath = itemProperty( index, BitProperty::Path );
+        mHandler.fileCallback()( itemPath.isString() ? itemPath.getString() : kEmptyFileAlias );
+    }
+
+    auto outStreamLoc = bit7z::make_com< CPipeOutStream, ISequentialOutStream >( mPipe );
+    mPipeOutStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,71 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/sinkextractcallback.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+SinkExtractCallback::SinkExtractCallback( const BitInputArchive& inputArchive, const ItemSinkFactory& sinkFactory )
+    : ExtractCallback( inputArchive ),
+      mSinkFactory( sinkFactory ),
+      mStopRequested{ false } {}
+
+auto SinkExtractCallback::stopRequested() const noexcept -> bool {
+    return mStopRequested || ( mSinkOutStream != nullptr && mSinkOutStream->stopRequested() );
+}
+
+auto SinkExtractCallback::sinkException() const noexcept -> std::exception_ptr {
+    if ( mSinkException ) {
+        return mSinkException;
+    }
+    return mSinkOutStream != nullptr ? mSinkOutStream->sinkException() : nullptr;
+}
+
+void SinkExtractCallback::releaseStream() {
+    if ( mSinkOutStream != nullptr ) {
+        mStopRequested = mStopRequested || mSinkOutStream->stopRequested();
+        if ( !mSinkException ) {
+            mSinkException = mSinkOutStream->sinkException();
+        }
+    }
+    mSinkOutStream.Release();
+}
+
+auto SinkExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT {
+    if ( isItemFolder( index ) ) {
+        return S_OK;
+    }
+
+    if ( mHandler.fileCallback() ) {
+        const BitPropVariant itemPath = itemProperty( index, BitProperty::Path );
+        mHandler.fileCallback()( itemPath.isString() ? itemPath.getString() : kEmptyFileAlias );
+    }
+
+    ItemSink sink;
+    try {
+        sink = mSinkFactory( inputArchive().itemAt( index ) );
+    } catch ( ... ) {
+        mSinkException = std::current_exception();
+        return E_ABORT;
+    }
+    if ( !sink ) { // The user doesn't want the content of this item.
+        return S_OK;
+    }
+
+    auto outStreamLoc = bit7z::make_com< CSinkOutStream >( std::move( sink ) );
+    mSinkOutStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
+
+} // namespace bit7z
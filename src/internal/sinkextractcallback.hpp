@@ -0,0 +1,55 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SINKEXTRACTCALLBACK_HPP
+#define SINKEXTRACTCALLBACK_HPP
+
+#include "internal/csinkoutstream.hpp"
+#include "internal/extractcallback.hpp"
+
+namespace bit7z {
+
+class SinkExtractCallback final : public ExtractCallback {
+    public:
+        SinkExtractCallback( const BitInputArchive& inputArchive, const ItemSinkFactory& sinkFactory );
+
+        SinkExtractCallback( const SinkExtractCallback& ) = delete;
+
+        SinkExtractCallback( SinkExtractCallback&& ) = delete;
+
+        auto operator=( const SinkExtractCallback& ) -> SinkExtractCallback& = delete;
+
+        auto operator=( SinkExtractCallback&& ) -> SinkExtractCallback& = delete;
+
+        ~SinkExtractCallback() override = default;
+
+        /**
+         * @return true if a sink asked to stop the extraction.
+         */
+        BIT7Z_NODISCARD auto stopRequested() const noexcept -> bool;
+
+        /**
+         * @return the exception thrown by a sink (or by the sink factory), if any.
+         */
+        BIT7Z_NODISCARD auto sinkException() const noexcept -> std::exception_ptr;
+
+    private:
+        const ItemSinkFactory& mSinkFactory;
+        CMyComPtr< CSinkOutStream > mSinkOutStream;
+        bool mStopRequested;
+        std::exception_ptr mSinkException;
+
+        void releaseStream() override;
+
+        auto getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT override;
+};
+
+}  // namespace bit7z
+
+#endif // SINKEXTRACTCALLBACK_HPP
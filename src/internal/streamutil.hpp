@@ -33,6 +33,20 @@ inline auto to_seekdir( uint32_t seekOrigin, std::ios_base::seekdir& way ) -> HR
     return S_OK;
 }
 
+/**
+ * Checks whether the given stream supports seeking (e.g., it is not a pipe or a socket).
+ *
+ * @param stream    the stream to be checked.
+ * @param which     the position to be checked (i.e., std::ios_base::in for input, std::ios_base::out for output).
+ */
+inline auto is_seekable( const std::ios& stream, std::ios_base::openmode which ) -> bool {
+    if ( stream.fail() || stream.rdbuf() == nullptr ) {
+        return false;
+    }
+    // Note: like tellg() and tellp(), pubseekoff() fails (returning -1) if the stream buffer doesn't support seeking.
+    return stream.rdbuf()->pubseekoff( 0, std::ios_base::cur, which ) != std::streampos( -1 );
+}
+
 } // namespace bit7z
 
 #endif //STREAMUTIL_HPP
@@ -0,0 +1,125 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/writebehindqueue.hpp"
+
+#include "internal/util.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace bit7z {
+
+WriteBehindQueue::WriteBehindQueue( std::size_t buffersCount, std::size_t bufferSize )
+    : mBuffersCount{ std::max< std::size_t >( buffersCount, 1 ) },
+      mBufferSize{ std::max< std::size_t >( bufferSize, 1 ) },
+      mAllocatedBuffers{ 0 },
+      mWriting{ false },
+      mStopped{ false },
+      mResult{ S_OK },
+      mWriter{ [this]() { writeRequests(); } } {}
+
+WriteBehindQueue::~WriteBehindQueue() {
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        mStopped = true;
+        mWriterCondition.notify_all();
+    }
+    if ( mWriter.joinable() ) {
+        mWriter.join();
+    }
+}
+
+auto WriteBehindQueue::bufferSize() const noexcept -> std::size_t {
+    return mBufferSize;
+}
+
+auto WriteBehindQueue::acquireBuffer() -> buffer_t {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    mProducerCondition.wait( lock, [this]() {
+        return !mFreeBuffers.empty() || mAllocatedBuffers < mBuffersCount;
+    } );
+    if ( mFreeBuffers.empty() ) { // The pool can still grow: allocating a new buffer (outside the lock).
+        ++mAllocatedBuffers;
+        lock.unlock();
+        buffer_t buffer;
+        try {
+            buffer.reserve( mBufferSize );
+        } catch ( ... ) {
+            lock.lock();
+            --mAllocatedBuffers;
+            throw;
+        }
+        return buffer;
+    }
+    buffer_t buffer = std::move( mFreeBuffers.back() );
+    mFreeBuffers.pop_back();
+    return buffer;
+}
+
+void WriteBehindQueue::submit( ISequentialOutStream* stream, buffer_t&& buffer ) {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mRequests.push_back( WriteRequest{ stream, std::move( buffer ) } );
+    mWriterCondition.notify_all();
+}
+
+auto WriteBehindQueue::flush() -> HRESULT {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    mProducerCondition.wait( lock, [this]() { return mRequests.empty() && !mWriting; } );
+    const HRESULT result = mResult;
+    mResult = S_OK;
+    return result;
+}
+
+inline auto write_all( ISequentialOutStream* stream, const buffer_t& data ) noexcept -> HRESULT {
+    std::size_t position = 0;
+    while ( position < data.size() ) {
+        const auto size = clamp_cast< UInt32 >( data.size() - position );
+        UInt32 processedSize = 0;
+        RINOK( stream->Write( &data[ position ], size, &processedSize ) )
+        if ( processedSize == 0 ) {
+            return E_FAIL;
+        }
+        position += processedSize;
+    }
+    return S_OK;
+}
+
+void WriteBehindQueue::writeRequests() {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    while ( true ) {
+        mWriterCondition.wait( lock, [this]() { return !mRequests.empty() || mStopped; } );
+        if ( mRequests.empty() ) { // Stopped, and no more data to be written.
+            return;
+        }
+
+        WriteRequest request = std::move( mRequests.front() );
+        mRequests.pop_front();
+        mWriting = true;
+        // After a failed write, the data is discarded until the failure is reported by flush.
+        const bool skipWrite = mResult != S_OK;
+        lock.unlock();
+
+        const HRESULT result = skipWrite ? S_OK : write_all( request.stream, request.data );
+        request.data.clear();
+
+        lock.lock();
+        if ( mResult == S_OK ) {
+            mResult = result;
+        }
+        mFreeBuffers.push_back( std::move( request.data ) );
+        mWriting = false;
+        mProducerCondition.notify_all();
+    }
+}
+
+} // namespace bit7z
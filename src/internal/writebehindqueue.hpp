@@ -0,0 +1,105 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef WRITEBEHINDQUEUE_HPP
+#define WRITEBEHINDQUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * A bounded queue of data to be written to output streams by a dedicated I/O thread, in the order it was submitted.
+ *
+ * The data is passed through a fixed pool of buffers: when all of them are waiting to be written,
+ * the producer waits for the I/O thread to complete a write (backpressure).
+ */
+class WriteBehindQueue final {
+    public:
+        static constexpr auto kDefaultBuffersCount = static_cast< std::size_t >( 8 );
+
+        static constexpr auto kDefaultBufferSize = static_cast< std::size_t >( 1024 * 1024 );
+
+        explicit WriteBehindQueue( std::size_t buffersCount = kDefaultBuffersCount,
+                                   std::size_t bufferSize = kDefaultBufferSize );
+
+        WriteBehindQueue( const WriteBehindQueue& ) = delete;
+
+        WriteBehindQueue( WriteBehindQueue&& ) = delete;
+
+        auto operator=( const WriteBehindQueue& ) -> WriteBehindQueue& = delete;
+
+        auto operator=( WriteBehindQueue&& ) -> WriteBehindQueue& = delete;
+
+        /**
+         * @brief Writes the pending data, and stops the I/O thread.
+         */
+        ~WriteBehindQueue();
+
+        BIT7Z_NODISCARD auto bufferSize() const noexcept -> std::size_t;
+
+        /**
+         * @brief Takes an empty buffer from the pool, waiting until one is available.
+         */
+        auto acquireBuffer() -> buffer_t;
+
+        /**
+         * @brief Queues the data in the given buffer to be written to the given stream;
+         * the buffer is returned to the pool once written.
+         *
+         * @note The stream must be kept alive until the data is written (i.e., until the next call to flush).
+         */
+        void submit( ISequentialOutStream* stream, buffer_t&& buffer );
+
+        /**
+         * @brief Waits until all the submitted data is written.
+         *
+         * @return the result of the first write that failed since the last flush, or S_OK if all the writes succeeded.
+         */
+        auto flush() -> HRESULT;
+
+    private:
+        struct WriteRequest {
+            ISequentialOutStream* stream;
+            buffer_t data;
+        };
+
+        std::size_t mBuffersCount;
+        std::size_t mBufferSize;
+
+        std::mutex mMutex;
+        std::condition_variable mWriterCondition;
+        std::condition_variable mProducerCondition;
+
+        std::deque< WriteRequest > mRequests;
+        std::vector< buffer_t > mFreeBuffers;
+        std::size_t mAllocatedBuffers;
+        bool mWriting;
+        bool mStopped;
+        HRESULT mResult;
+
+        std::thread mWriter;
+
+        void writeRequests();
+};
+
+}  // namespace bit7z
+
+#endif //WRITEBEHINDQUEUE_HPP
@@ -12,7 +12,9 @@
 #include <catch2/catch.hpp>
 
 #include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
 #include <bit7z/bitexception.hpp>
+#include <bit7z/bitmemcompressor.hpp>
 
 #include "utils/shared_lib.hpp"
 
@@ -54,5 +56,36 @@ TEST_CASE( "Bit7zLibrary: Set 7-zip to use the large page mode", "[bit7zlibrary]
     REQUIRE_NOTHROW( lib.setLargePageMode() );
 }
 
+TEST_CASE( "Bit7zLibrary: Reusing the archive handlers", "[bit7zlibrary]" ) {
+    const auto libPath = sevenzip_lib_path();
+
+    Bit7zLibrary lib{ libPath };
+    REQUIRE( lib.handlerPoolSize() == 0 );
+
+    const auto poolSize = GENERATE( as< std::size_t >(), 0, 1, 4 );
+    DYNAMIC_SECTION( "Handler pool size: " << poolSize ) {
+        lib.setHandlerPoolSize( poolSize );
+        REQUIRE( lib.handlerPoolSize() == poolSize );
+
+        const buffer_t content = { 'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', '!' };
+        // Note: the compression level changes the properties of the reused output archive handlers.
+        const auto levels = { BitCompressionLevel::Ultra, BitCompressionLevel::None, BitCompressionLevel::Normal };
+        for ( const auto level : levels ) {
+            BitMemCompressor compressor{ lib, BitFormat::SevenZip };
+            compressor.setCompressionLevel( level );
+
+            buffer_t archive;
+            REQUIRE_NOTHROW( compressor.compressFile( content, archive, BIT7Z_STRING( "hello.txt" ) ) );
+
+            const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+            REQUIRE( reader.itemsCount() == 1 );
+
+            std::map< tstring, buffer_t > extracted;
+            REQUIRE_NOTHROW( reader.extractTo( extracted ) );
+            REQUIRE( extracted[ BIT7Z_STRING( "hello.txt" ) ] == content );
+        }
+    }
+}
+
 } // namespace test
 } // namespace bit7z
\ No newline at end of file
@@ -11,13 +11,20 @@
  */
 #include <catch2/catch.hpp>
 
+#include <bit7z/bitarchivereader.hpp>
 #include <bit7z/bitarchivewriter.hpp>
 #include <bit7z/bitfilecompressor.hpp>
 #include <bit7z/bitmemcompressor.hpp>
 #include <bit7z/bitstreamcompressor.hpp>
+#include <internal/fs.hpp>
 
 #include "utils/shared_lib.hpp"
 
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <vector>
+
 using namespace bit7z;
 using bit7z::Bit7zLibrary;
 using bit7z::BitArchiveWriter;
@@ -391,11 +398,26 @@ TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setUpdateMode(...) / update
     compressor.setUpdateMode( UpdateMode::Update );
     REQUIRE( compressor.updateMode() == UpdateMode::Update );
 
+    compressor.setUpdateMode( UpdateMode::Freshen );
+    REQUIRE( compressor.updateMode() == UpdateMode::Freshen );
+
     compressor.setUpdateMode( UpdateMode::None );
     REQUIRE( compressor.updateMode() == UpdateMode::None );
 
 }
 
+TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setFreshenChecksCrc(...) / freshenChecksCrc()",
+                         "[bitabstractarchivecreator]", CreatorTypes ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    TestType compressor( lib, BitFormat::SevenZip );
+    REQUIRE( !compressor.freshenChecksCrc() );
+    compressor.setFreshenChecksCrc( true );
+    REQUIRE( compressor.freshenChecksCrc() );
+    compressor.setFreshenChecksCrc( false );
+    REQUIRE( !compressor.freshenChecksCrc() );
+}
+
 TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setVolumeSize(...) / volumeSize()",
                          "[bitabstractarchivecreator]", CreatorTypes ) {
     const Bit7zLibrary lib{ test::sevenzip_lib_path() };
@@ -406,6 +428,56 @@ TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setVolumeSize(...) / volume
     REQUIRE( compressor.volumeSize() == 1024u );
 }
 
+TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setVolumeCallback(...) / volumeCallback()",
+                         "[bitabstractarchivecreator]", CreatorTypes ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    TestType compressor( lib, BitFormat::SevenZip );
+    REQUIRE( !compressor.volumeCallback() );
+
+    tstring completedVolume;
+    compressor.setVolumeCallback( [ &completedVolume ]( const tstring& volumePath ) {
+        completedVolume = volumePath;
+    } );
+    REQUIRE( compressor.volumeCallback() );
+    compressor.volumeCallback()( BIT7Z_STRING( "archive.7z.001" ) );
+    REQUIRE( completedVolume == BIT7Z_STRING( "archive.7z.001" ) );
+}
+
+TEST_CASE( "BitAbstractArchiveCreator: Exceptions thrown by the volume callback are rethrown",
+           "[bitabstractarchivecreator]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testDir = fs::temp_directory_path() / "bit7z_volume_callback";
+    std::error_code error;
+    fs::remove_all( testDir, error );
+    REQUIRE( fs::create_directory( testDir, error ) );
+
+    // A file that is stored in more than one volume.
+    const auto filePath = testDir / "file.bin";
+    {
+        std::ofstream output{ filePath.c_str(), std::ios::binary | std::ios::trunc };
+        for ( int index = 0; index < 16 * 1024; ++index ) {
+            output.put( static_cast< char >( ( index * 7919 ) % 251 ) );
+        }
+    }
+    const std::map< tstring, tstring > inPaths{ { to_tstring( filePath.native() ), BIT7Z_STRING( "file.bin" ) } };
+
+    // Note: not derived from std::exception, so that it cannot be confused with the exceptions thrown by bit7z.
+    struct VolumeCallbackError {};
+
+    BitFileCompressor compressor{ lib, BitFormat::SevenZip };
+    compressor.setCompressionLevel( BitCompressionLevel::None );
+    compressor.setVolumeSize( 1024u );
+    compressor.setVolumeCallback( []( const tstring& /*volumePath*/ ) {
+        throw VolumeCallbackError{};
+    } );
+    REQUIRE_THROWS_AS( compressor.compress( inPaths, to_tstring( ( testDir / "archive.7z" ).native() ) ),
+                       VolumeCallbackError );
+
+    fs::remove_all( testDir, error );
+}
+
 TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setWordSize(...) / wordSize()",
                          "[bitabstractarchivecreator]", CreatorTypes ) {
     const Bit7zLibrary lib{ test::sevenzip_lib_path() };
@@ -547,4 +619,103 @@ TEMPLATE_LIST_TEST_CASE( "BitAbstractArchiveCreator: setWordSize(...) / wordSize
         REQUIRE_NOTHROW( compressor.setWordSize( 0 ) );
         REQUIRE( compressor.wordSize() == 0 );
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "BitAbstractArchiveCreator: Freshening an archive recompresses only the changed files",
+           "[bitabstractarchivecreator]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testDir = fs::temp_directory_path() / "bit7z_freshen";
+    std::error_code error;
+    fs::remove_all( testDir, error );
+    REQUIRE( fs::create_directory( testDir, error ) );
+
+    const auto writeFile = []( const fs::path& filePath, const std::string& content ) {
+        std::ofstream output{ filePath.c_str(), std::ios::binary | std::ios::trunc };
+        output << content;
+    };
+    const auto unchangedFile = testDir / "unchanged.txt";
+    const auto changedFile = testDir / "changed.txt";
+    writeFile( unchangedFile, "This file is not changed" );
+    writeFile( changedFile, "Old content" );
+
+    const std::map< tstring, tstring > inPaths{
+        { to_tstring( unchangedFile.native() ), BIT7Z_STRING( "unchanged.txt" ) },
+        { to_tstring( changedFile.native() ), BIT7Z_STRING( "changed.txt" ) }
+    };
+    const auto archivePath = to_tstring( ( testDir / "archive.7z" ).native() );
+
+    BitFileCompressor compressor{ lib, BitFormat::SevenZip };
+    REQUIRE_NOTHROW( compressor.compress( inPaths, archivePath ) );
+
+    // A different size is enough to consider the file as changed, regardless of its last write time.
+    writeFile( changedFile, "New (and longer) content" );
+
+    std::vector< tstring > compressedFiles;
+    compressor.setUpdateMode( UpdateMode::Freshen );
+    compressor.setFileCallback( [ &compressedFiles ]( const tstring& filePath ) {
+        compressedFiles.push_back( filePath );
+    } );
+    REQUIRE_NOTHROW( compressor.compress( inPaths, archivePath ) );
+    REQUIRE( compressedFiles == std::vector< tstring >{ BIT7Z_STRING( "changed.txt" ) } );
+
+    const BitArchiveReader reader{ lib, archivePath, BitFormat::SevenZip };
+    std::map< tstring, buffer_t > extracted;
+    REQUIRE_NOTHROW( reader.extractTo( extracted ) );
+    REQUIRE( extracted.size() == 2 );
+    const std::string unchangedContent = "This file is not changed";
+    const std::string changedContent = "New (and longer) content";
+    REQUIRE( extracted[ BIT7Z_STRING( "unchanged.txt" ) ] ==
+             buffer_t( unchangedContent.cbegin(), unchangedContent.cend() ) );
+    REQUIRE( extracted[ BIT7Z_STRING( "changed.txt" ) ] ==
+             buffer_t( changedContent.cbegin(), changedContent.cend() ) );
+
+    fs::remove_all( testDir, error );
+}
+
+TEST_CASE( "BitAbstractArchiveCreator: Freshening an archive detects same-size changes made shortly after",
+           "[bitabstractarchivecreator]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testDir = fs::temp_directory_path() / "bit7z_freshen_time";
+    std::error_code error;
+    fs::remove_all( testDir, error );
+    REQUIRE( fs::create_directory( testDir, error ) );
+
+    const auto filePath = testDir / "file.txt";
+    {
+        std::ofstream output{ filePath.c_str(), std::ios::binary | std::ios::trunc };
+        output << "Old content";
+    }
+    const auto oldWriteTime = fs::last_write_time( filePath );
+
+    const std::map< tstring, tstring > inPaths{ { to_tstring( filePath.native() ), BIT7Z_STRING( "file.txt" ) } };
+    const auto archivePath = to_tstring( ( testDir / "archive.7z" ).native() );
+
+    BitFileCompressor compressor{ lib, BitFormat::SevenZip };
+    REQUIRE_NOTHROW( compressor.compress( inPaths, archivePath ) );
+
+    // Same size, and a last write time within the 2 seconds precision of DOS times:
+    // the 7z format stores precise times, so the file must be considered as changed.
+    {
+        std::ofstream output{ filePath.c_str(), std::ios::binary | std::ios::trunc };
+        output << "New content";
+    }
+    fs::last_write_time( filePath, oldWriteTime + std::chrono::seconds( 1 ) );
+
+    std::vector< tstring > compressedFiles;
+    compressor.setUpdateMode( UpdateMode::Freshen );
+    compressor.setFileCallback( [ &compressedFiles ]( const tstring& compressedPath ) {
+        compressedFiles.push_back( compressedPath );
+    } );
+    REQUIRE_NOTHROW( compressor.compress( inPaths, archivePath ) );
+    REQUIRE( compressedFiles == std::vector< tstring >{ BIT7Z_STRING( "file.txt" ) } );
+
+    const BitArchiveReader reader{ lib, archivePath, BitFormat::SevenZip };
+    std::map< tstring, buffer_t > extracted;
+    REQUIRE_NOTHROW( reader.extractTo( extracted ) );
+    const std::string newContent = "New content";
+    REQUIRE( extracted[ BIT7Z_STRING( "file.txt" ) ] == buffer_t( newContent.cbegin(), newContent.cend() ) );
+
+    fs::remove_all( testDir, error );
+}
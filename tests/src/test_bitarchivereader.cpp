@@ -16,11 +16,23 @@
 #include "utils/format.hpp"
 #include "utils/shared_lib.hpp"
 
+#include <bit7z/bitarchivecache.hpp>
 #include <bit7z/bitarchivereader.hpp>
+#include <bit7z/bitconcurrentarchivereader.hpp>
+#include <bit7z/biterror.hpp>
 #include <bit7z/bitexception.hpp>
 #include <bit7z/bitformat.hpp>
+#include <bit7z/bititemcache.hpp>
+#include <bit7z/bititemreader.hpp>
+#include <bit7z/bitmemoryarena.hpp>
 #include <internal/windows.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <streambuf>
+#include <thread>
+
 // Needed by MSVC for defining the S_XXXX macros.
 #ifndef _CRT_INTERNAL_NONSTDC_NAMES // NOLINT(*-reserved-identifier, *-dcl37-c)
 #define _CRT_INTERNAL_NONSTDC_NAMES 1
@@ -581,7 +593,675 @@ TEMPLATE_TEST_CASE( "BitArchiveReader: Checking consistency between items() and
             const auto& archivedItem = archiveItems[ iteratedItem.index() ];
             REQUIRE_ITEM_EQUAL( archivedItem, iteratedItem );
         }
+
+        // The items are read from a snapshot of the properties, while this archive queries them one by one.
+        const BitArchiveReader reference( lib, arcFileName.string< tchar >(), testArchive.format() );
+        for ( const auto& referenceItem : reference ) {
+            const auto& archivedItem = archiveItems[ referenceItem.index() ];
+            REQUIRE_ITEM_EQUAL( archivedItem, referenceItem );
+
+            const auto archivedProperties = archivedItem.itemProperties();
+            REQUIRE_FALSE( archivedProperties.empty() );
+            for ( const auto& property : archivedProperties ) {
+                REQUIRE( referenceItem.itemProperty( property.first ) == property.second );
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "BitArchiveReader: Checking consistency between items() and itemTable()",
+                    "[bitarchivereader]", tstring, buffer_t, stream_t ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "iso", BitFormat::Iso, 615351 },
+                                        MultipleItemsArchive{ "rar4.rar", BitFormat::Rar, 565329 },
+                                        MultipleItemsArchive{ "rar5.rar", BitFormat::Rar5, 565756 },
+                                        MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                        MultipleItemsArchive{ "wim", BitFormat::Wim, 615351 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+
+        TestType inputArchive{};
+        getInputArchive( arcFileName, inputArchive );
+        const BitArchiveReader info( lib, inputArchive, testArchive.format() );
+
+        const auto archiveItems = info.items();
+
+        const auto table = info.itemTable( { BitProperty::Path, BitProperty::IsDir,
+                                             BitProperty::Size, BitProperty::CRC, BitProperty::Path } );
+        REQUIRE( table->itemsCount() == info.itemsCount() );
+        REQUIRE( table->properties().size() == 4 );
+        REQUIRE( table->hasProperty( BitProperty::Path ) );
+        REQUIRE_FALSE( table->hasProperty( BitProperty::MTime ) );
+        REQUIRE_THROWS_AS( table->itemProperty( 0, BitProperty::MTime ), BitException );
+        REQUIRE_THROWS_AS( table->path( table->itemsCount() ), BitException );
+
+        for ( const auto& archivedItem : archiveItems ) {
+            const auto index = archivedItem.index();
+            REQUIRE( table->path( index ) == archivedItem.path() );
+            REQUIRE( table->isDir( index ) == archivedItem.isDir() );
+            REQUIRE( table->size( index ) == archivedItem.size() );
+            REQUIRE( table->crc( index ) == archivedItem.crc() );
+            REQUIRE( table->itemProperty( index, BitProperty::Path ) ==
+                     archivedItem.itemProperty( BitProperty::Path ) );
+            REQUIRE( info.isItemFolder( index ) == archivedItem.isDir() );
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "BitArchiveReader: Extracting a batch of items to buffers",
+                    "[bitarchivereader]", tstring, buffer_t, stream_t ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "rar5.rar", BitFormat::Rar5, 565756 },
+                                        MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+
+        TestType inputArchive{};
+        getInputArchive( arcFileName, inputArchive );
+        const BitArchiveReader info( lib, inputArchive, testArchive.format() );
+
+        const auto archiveItems = info.items();
+        std::vector< buffer_t > outBuffers( archiveItems.size() );
+        BitExtractionBatch batch;
+        for ( const auto& archivedItem : archiveItems ) {
+            if ( !archivedItem.isDir() ) {
+                batch.add( archivedItem.index(), outBuffers[ archivedItem.index() ] );
+            }
+        }
+        REQUIRE_NOTHROW( info.extractTo( batch ) );
+
+        for ( const auto& archivedItem : archiveItems ) {
+            if ( archivedItem.isDir() ) {
+                continue;
+            }
+            buffer_t expectedBuffer;
+            REQUIRE_NOTHROW( info.extractTo( expectedBuffer, archivedItem.index() ) );
+            REQUIRE( outBuffers[ archivedItem.index() ] == expectedBuffer );
+        }
+
+        SECTION( "Invalid requests are reported before extracting anything" ) {
+            buffer_t outBuffer;
+            BitExtractionBatch invalidBatch;
+            invalidBatch.add( info.itemsCount(), outBuffer );
+            REQUIRE_THROWS_AS( info.extractTo( invalidBatch ), BitException );
+
+            invalidBatch.clear();
+            REQUIRE( invalidBatch.empty() );
+            const auto firstFile = std::find_if( archiveItems.cbegin(), archiveItems.cend(),
+                                                 []( const BitArchiveItemInfo& item ) { return !item.isDir(); } );
+            REQUIRE( firstFile != archiveItems.cend() );
+            invalidBatch.add( firstFile->index(), outBuffer );
+            invalidBatch.add( firstFile->index(), outBuffer );
+            REQUIRE_THROWS_AS( info.extractTo( invalidBatch ), BitException );
+            REQUIRE( outBuffer.empty() );
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "BitArchiveReader: Extracting the items to sinks",
+                    "[bitarchivereader]", tstring, buffer_t, stream_t ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+
+        TestType inputArchive{};
+        getInputArchive( arcFileName, inputArchive );
+        const BitArchiveReader info( lib, inputArchive, testArchive.format() );
+
+        SECTION( "Extracting all the files" ) {
+            std::map< uint32_t, buffer_t > sinkContents;
+            REQUIRE_NOTHROW( info.extractTo( [ &sinkContents ]( const BitArchiveItem& item ) -> ItemSink {
+                auto& content = sinkContents[ item.index() ];
+                return [ &content ]( const byte_t* data, std::size_t size ) -> bool {
+                    content.insert( content.end(), data, data + size );
+                    return true;
+                };
+            } ) );
+
+            REQUIRE( sinkContents.size() == info.filesCount() );
+            for ( const auto& sinkContent : sinkContents ) {
+                buffer_t expectedBuffer;
+                REQUIRE_NOTHROW( info.extractTo( expectedBuffer, sinkContent.first ) );
+                REQUIRE( sinkContent.second == expectedBuffer );
+            }
+        }
+
+        SECTION( "Stopping the extraction from a sink" ) {
+            std::size_t sinksCount = 0;
+            REQUIRE_NOTHROW( info.extractTo( [ &sinksCount ]( const BitArchiveItem& ) -> ItemSink {
+                ++sinksCount;
+                return []( const byte_t*, std::size_t ) -> bool {
+                    return false;
+                };
+            } ) );
+            REQUIRE( sinksCount >= 1 );
+        }
+
+        SECTION( "Skipping all the items" ) {
+            REQUIRE_NOTHROW( info.extractTo( []( const BitArchiveItem& ) -> ItemSink {
+                return {};
+            } ) );
+        }
+
+        SECTION( "Extracting an invalid index" ) {
+            REQUIRE_THROWS_AS( info.extractTo( []( const BitArchiveItem& ) -> ItemSink {
+                return {};
+            }, { info.itemsCount() } ), BitException );
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "BitArchiveReader: Extracting the files to a memory arena",
+                    "[bitarchivereader]", tstring, buffer_t, stream_t ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+
+        TestType inputArchive{};
+        getInputArchive( arcFileName, inputArchive );
+        const BitArchiveReader info( lib, inputArchive, testArchive.format() );
+
+        std::map< tstring, buffer_t > expectedMap;
+        REQUIRE_NOTHROW( info.extractTo( expectedMap ) );
+
+        BitMemoryArena arena;
+        REQUIRE_NOTHROW( info.extractTo( arena ) );
+        REQUIRE( arena.size() == expectedMap.size() );
+
+        // The entries of the arena are sorted by path, like the keys of the map.
+        auto expectedIterator = expectedMap.cbegin();
+        for ( const auto& entry : arena.entries() ) {
+            REQUIRE( arena.path( entry ) == expectedIterator->first );
+            REQUIRE( entry.size == expectedIterator->second.size() );
+            REQUIRE( std::equal( arena.content( entry ), arena.content( entry ) + entry.size,
+                                 expectedIterator->second.cbegin() ) );
+            ++expectedIterator;
+        }
+
+        for ( const auto& expected : expectedMap ) {
+            const auto* entry = arena.find( expected.first );
+            REQUIRE( entry != nullptr );
+            REQUIRE( arena.path( *entry ) == expected.first );
+        }
+        REQUIRE_FALSE( arena.contains( BIT7Z_STRING( "non_existing_file.txt" ) ) );
+
+        // Extracting again to the same arena replaces its previous content.
+        REQUIRE_NOTHROW( info.extractTo( arena ) );
+        REQUIRE( arena.size() == expectedMap.size() );
+
+        arena.clear();
+        REQUIRE( arena.empty() );
+        REQUIRE( arena.find( expectedMap.cbegin()->first ) == nullptr );
+    }
+}
+
+TEMPLATE_TEST_CASE( "BitItemReader: Reading the content of the files in an archive",
+                    "[bitarchivereader][bititemreader]", tstring, buffer_t, stream_t ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+
+        TestType inputArchive{};
+        getInputArchive( arcFileName, inputArchive );
+        const BitArchiveReader info( lib, inputArchive, testArchive.format() );
+
+        std::map< uint32_t, buffer_t > readContents;
+        std::map< uint32_t, tstring > readPaths;
+        {
+            BitItemReader reader{ info, 1024 };
+            REQUIRE_THROWS_AS( reader.currentItem(), BitException );
+            while ( reader.nextItem() ) {
+                REQUIRE_FALSE( reader.currentItem().isDir() );
+                const std::istreambuf_iterator< char > begin{ &reader.streamBuffer() };
+                const std::istreambuf_iterator< char > end{};
+                buffer_t content;
+                std::transform( begin, end, std::back_inserter( content ), []( char value ) {
+                    return static_cast< byte_t >( value );
+                } );
+                REQUIRE( content.size() == reader.currentItem().size() );
+                readPaths[ reader.currentItem().index() ] = reader.currentItem().path();
+                readContents[ reader.currentItem().index() ] = std::move( content );
+            }
+        }
+
+        REQUIRE( readContents.size() == info.filesCount() );
+        for ( const auto& readContent : readContents ) {
+            buffer_t expectedBuffer;
+            REQUIRE_NOTHROW( info.extractTo( expectedBuffer, readContent.first ) );
+            REQUIRE( readContent.second == expectedBuffer );
+            REQUIRE( readPaths[ readContent.first ] == info.itemAt( readContent.first ).path() );
+        }
+
+        SECTION( "Stopping the reader before reading all the files" ) {
+            BitItemReader reader{ info, 16 };
+            REQUIRE( reader.nextItem() );
+            std::vector< byte_t > chunk( 8 );
+            REQUIRE( reader.read( chunk ) <= chunk.size() );
+        }
+    }
+}
+
+TEST_CASE( "BitArchiveCache: Reusing the opened archives", "[bitarchivereader][bitarchivecache]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const tstring arcFileName = BIT7Z_STRING( "multiple_items.7z" );
+    const BitArchiveReader expectedArchive{ lib, arcFileName, BitFormat::SevenZip };
+
+    BitArchiveCache cache{ lib, BitFormat::SevenZip };
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.maxArchives() == BitArchiveCache::kDefaultMaxArchives );
+    REQUIRE( cache.maxItems() == 0 );
+
+    {
+        const auto archive = cache.checkout( arcFileName );
+        REQUIRE( archive->itemsCount() == expectedArchive.itemsCount() );
+
+        buffer_t content;
+        REQUIRE_NOTHROW( archive->extractTo( content, 0 ) );
+        buffer_t expectedContent;
+        REQUIRE_NOTHROW( expectedArchive.extractTo( expectedContent, 0 ) );
+        REQUIRE( content == expectedContent );
+    }
+    REQUIRE( cache.size() == 1 );
+
+    auto statistics = cache.statistics();
+    REQUIRE( statistics.hits == 0 );
+    REQUIRE( statistics.misses == 1 );
+    REQUIRE( statistics.evictions == 0 );
+    REQUIRE( statistics.openTime.count() > 0 );
+
+    SECTION( "Checking out the archive again reuses the opened archive" ) {
+        {
+            const auto archive = cache.checkout( arcFileName );
+            REQUIRE( archive->itemsCount() == expectedArchive.itemsCount() );
+        }
+        REQUIRE( cache.size() == 1 );
+
+        statistics = cache.statistics();
+        REQUIRE( statistics.hits == 1 );
+        REQUIRE( statistics.misses == 1 );
+    }
+
+    SECTION( "Checking out an archive in use opens another instance" ) {
+        {
+            const auto archive = cache.checkout( arcFileName );
+            const auto otherArchive = cache.checkout( arcFileName );
+            REQUIRE( &( *archive ) != &( *otherArchive ) );
+            REQUIRE( otherArchive->itemsCount() == expectedArchive.itemsCount() );
+        }
+        REQUIRE( cache.size() == 2 );
+
+        statistics = cache.statistics();
+        REQUIRE( statistics.hits == 1 );
+        REQUIRE( statistics.misses == 2 );
+
+        cache.setMaxArchives( 1 );
+        REQUIRE( cache.size() == 1 );
+        REQUIRE( cache.statistics().evictions == 1 );
+    }
+
+    SECTION( "Limiting the total number of items in the cache" ) {
+        cache.setMaxItems( expectedArchive.itemsCount() - 1 );
+        REQUIRE( cache.size() == 0 );
+        REQUIRE( cache.statistics().evictions == 1 );
+
+        // Checked out archives are never evicted.
+        const auto archive = cache.checkout( arcFileName );
+        REQUIRE( cache.size() == 1 );
+    }
+
+    SECTION( "Clearing the cache" ) {
+        cache.clear();
+        REQUIRE( cache.size() == 0 );
+    }
+
+    SECTION( "Checking out a non-existing archive" ) {
+        REQUIRE_THROWS_AS( cache.checkout( BIT7Z_STRING( "non_existing.7z" ) ), BitException );
+        REQUIRE( cache.size() == 1 );
+    }
+}
+
+TEST_CASE( "BitConcurrentArchiveReader: Extracting the files from multiple threads",
+           "[bitarchivereader][bitconcurrentarchivereader]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+    const auto maxShards = GENERATE( as< std::size_t >(), 1, 2, 4 );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() << ", max shards: " << maxShards ) {
+        tstring arcFileName;
+        getInputArchive( "multiple_items." + testArchive.extension(), arcFileName );
+        const BitArchiveReader expectedArchive{ lib, arcFileName, testArchive.format() };
+
+        const BitConcurrentArchiveReader reader{ lib, arcFileName, maxShards, testArchive.format() };
+        REQUIRE( reader.maxShards() == maxShards );
+        REQUIRE( reader.shardsCount() == 1 );
+        REQUIRE( reader.itemsCount() == expectedArchive.itemsCount() );
+
+        // The threads must not access expectedArchive, as its underlying archive object is not thread-safe.
+        std::vector< uint32_t > filesIndices;
+        for ( const auto& item : expectedArchive ) {
+            if ( !item.isDir() ) {
+                filesIndices.push_back( item.index() );
+            }
+        }
+
+        constexpr auto kThreadsCount = 4;
+        std::vector< std::map< uint32_t, buffer_t > > threadsContents( kThreadsCount );
+        std::vector< std::thread > threads;
+        for ( std::size_t thread = 0; thread < kThreadsCount; ++thread ) {
+            threads.emplace_back( [ &reader, &filesIndices, &threadsContents, thread ]() {
+                for ( const auto index : filesIndices ) {
+                    reader.extractTo( threadsContents[ thread ][ index ], index );
+                }
+            } );
+        }
+        for ( auto& thread : threads ) {
+            thread.join();
+        }
+
+        for ( const auto& threadContents : threadsContents ) {
+            REQUIRE( threadContents.size() == expectedArchive.filesCount() );
+            for ( const auto& content : threadContents ) {
+                buffer_t expectedContent;
+                REQUIRE_NOTHROW( expectedArchive.extractTo( expectedContent, content.first ) );
+                REQUIRE( content.second == expectedContent );
+            }
+        }
+
+        REQUIRE( reader.shardsCount() <= maxShards );
+        const auto statistics = reader.statistics();
+        REQUIRE( statistics.shards.size() == reader.shardsCount() );
+        uint64_t requests = 0;
+        for ( const auto& shard : statistics.shards ) {
+            REQUIRE_FALSE( shard.busy );
+            requests += shard.requests;
+        }
+        // The extractions of all the threads, plus the call to itemsCount().
+        REQUIRE( requests == ( kThreadsCount * expectedArchive.filesCount() ) + 1 );
+    }
+}
+
+TEMPLATE_TEST_CASE( "BitItemCache: Caching the decoded content of the files in an archive",
+                    "[bitarchivereader][bititemcache]", tstring, buffer_t, stream_t ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                        MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                        MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                        MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+
+        TestType inputArchive{};
+        getInputArchive( arcFileName, inputArchive );
+        const BitArchiveReader info( lib, inputArchive, testArchive.format() );
+
+        std::vector< uint32_t > filesIndices;
+        for ( const auto& item : info ) {
+            if ( !item.isDir() ) {
+                filesIndices.push_back( item.index() );
+            }
+        }
+        // Requesting the last files first, so that the files preceding them in solid blocks are decoded too.
+        std::reverse( filesIndices.begin(), filesIndices.end() );
+
+        BitItemCache cache{ info };
+        REQUIRE( cache.size() == 0 );
+        REQUIRE( cache.cachedBytes() == 0 );
+
+        for ( const auto index : filesIndices ) {
+            buffer_t expectedContent;
+            REQUIRE_NOTHROW( info.extractTo( expectedContent, index ) );
+            REQUIRE( *cache.content( index ) == expectedContent );
+            REQUIRE( cache.contains( index ) );
+        }
+        REQUIRE( cache.size() == filesIndices.size() );
+
+        auto statistics = cache.statistics();
+        REQUIRE( statistics.hits + statistics.misses == filesIndices.size() );
+        REQUIRE( statistics.hits == statistics.speculative );
+        REQUIRE( statistics.evictions == 0 );
+
+        SECTION( "Reading the cached files again" ) {
+            for ( const auto index : filesIndices ) {
+                buffer_t content;
+                REQUIRE_NOTHROW( cache.extractTo( content, index ) );
+                REQUIRE( content.size() == info.itemAt( index ).size() );
+            }
+            REQUIRE( cache.statistics().hits == statistics.hits + filesIndices.size() );
+            REQUIRE( cache.statistics().misses == statistics.misses );
+        }
+
+        SECTION( "Reducing the memory budget of the cache" ) {
+            const auto lastUsed = filesIndices.back();
+            const auto lastUsedSize = cache.content( lastUsed )->size();
+            cache.setMaxBytes( lastUsedSize );
+            REQUIRE( cache.cachedBytes() <= lastUsedSize );
+            REQUIRE( cache.contains( lastUsed ) );
+
+            cache.setMaxBytes( 0 );
+            REQUIRE( cache.cachedBytes() == 0 );
+            REQUIRE( cache.content( lastUsed )->size() == lastUsedSize );
+            REQUIRE( cache.cachedBytes() == 0 );
+        }
+
+        SECTION( "Clearing the cache" ) {
+            cache.clear();
+            REQUIRE( cache.size() == 0 );
+            REQUIRE( cache.cachedBytes() == 0 );
+        }
+
+        SECTION( "Requesting a file with an invalid index" ) {
+            REQUIRE_THROWS_AS( cache.content( info.itemsCount() ), BitException );
+        }
+
+        SECTION( "Requesting a folder" ) {
+            uint32_t folderIndex = info.itemsCount();
+            for ( const auto& item : info ) {
+                if ( item.isDir() ) {
+                    folderIndex = item.index();
+                    break;
+                }
+            }
+            REQUIRE( folderIndex < info.itemsCount() );
+            REQUIRE_THROWS_MATCHES(
+                cache.content( folderIndex ),
+                BitException,
+                Catch::Matchers::Predicate< BitException >(
+                    []( const BitException& exception ) -> bool {
+                        return exception.code() == BitError::ItemIsAFolder;
+                    },
+                    "Error code should be BitError::ItemIsAFolder"
+                )
+            );
+            REQUIRE_FALSE( cache.contains( folderIndex ) );
+        }
+    }
+}
+
+TEST_CASE( "BitItemCache: Caching the files of a solid block with a small memory budget",
+           "[bitarchivereader][bititemcache]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "solid" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const BitArchiveReader info( lib, BIT7Z_STRING( "solid.7z" ), BitFormat::SevenZip );
+    REQUIRE( info.isSolid() );
+
+    // The last file of the archive, and the non-empty files preceding it in its solid block.
+    uint32_t requestedIndex = 0;
+    for ( const auto& item : info ) {
+        if ( !item.isDir() ) {
+            requestedIndex = item.index();
+        }
+    }
+    const auto requestedBlock = info.itemProperty( requestedIndex, BitProperty::Block );
+    REQUIRE( requestedBlock.isUInt64() );
+    std::vector< uint32_t > precedingIndices;
+    for ( uint32_t index = 0; index < requestedIndex; ++index ) {
+        const auto block = info.itemProperty( index, BitProperty::Block );
+        if ( block.isUInt64() && block.getUInt64() == requestedBlock.getUInt64() && info.itemAt( index ).size() > 0 ) {
+            precedingIndices.push_back( index );
+        }
     }
+    REQUIRE( precedingIndices.size() > 1 );
+
+    const auto requestedSize = static_cast< std::size_t >( info.itemAt( requestedIndex ).size() );
+    const auto firstSize = static_cast< std::size_t >( info.itemAt( precedingIndices.front() ).size() );
+
+    SECTION( "Only the requested file fits in the memory budget" ) {
+        BitItemCache cache{ info, requestedSize };
+        REQUIRE( cache.content( requestedIndex )->size() == requestedSize );
+        REQUIRE( cache.cachedBytes() == requestedSize );
+        REQUIRE( cache.statistics().speculative == 0 );
+        for ( const auto index : precedingIndices ) {
+            REQUIRE_FALSE( cache.contains( index ) );
+        }
+    }
+
+    SECTION( "Only the first preceding file fits in the memory budget" ) {
+        BitItemCache cache{ info, requestedSize + firstSize };
+        REQUIRE( cache.content( requestedIndex )->size() == requestedSize );
+        REQUIRE( cache.cachedBytes() == requestedSize + firstSize );
+        REQUIRE( cache.contains( precedingIndices.front() ) );
+        for ( auto index = std::next( precedingIndices.cbegin() ); index != precedingIndices.cend(); ++index ) {
+            REQUIRE_FALSE( cache.contains( *index ) );
+        }
+
+        buffer_t expectedContent;
+        REQUIRE_NOTHROW( info.extractTo( expectedContent, precedingIndices.front() ) );
+        REQUIRE( *cache.content( precedingIndices.front() ) == expectedContent );
+        REQUIRE( cache.statistics().hits == 1 );
+    }
+}
+
+// A stream buffer that doesn't support seeking, like the ones of pipes and sockets.
+class NonSeekableBuffer final : public std::streambuf {
+    public:
+        explicit NonSeekableBuffer( buffer_t& content ) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto* begin = reinterpret_cast< char* >( content.data() );
+            setg( begin, begin, begin + content.size() ); // NOLINT(*-pro-bounds-pointer-arithmetic)
+        }
+};
+
+TEST_CASE( "BitArchiveReader: Reading an archive from a non-seekable stream", "[bitarchivereader]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    buffer_t archiveContent;
+    getInputArchive( "multiple_items.tar", archiveContent );
+    NonSeekableBuffer archiveBuffer{ archiveContent };
+    std::istream archiveStream{ &archiveBuffer };
+    REQUIRE( archiveStream.tellg() == std::istream::pos_type( -1 ) );
+
+    SECTION( "Extracting the archive" ) {
+        const BitArchiveReader info( lib, archiveStream, BitFormat::Tar );
+
+        std::map< tstring, buffer_t > extracted;
+        REQUIRE_NOTHROW( info.extractTo( extracted ) );
+
+        const BitArchiveReader expectedArchive( lib, archiveContent, BitFormat::Tar );
+        std::map< tstring, buffer_t > expected;
+        REQUIRE_NOTHROW( expectedArchive.extractTo( expected ) );
+        REQUIRE( extracted == expected );
+
+        // The stream was consumed by the first extraction.
+        REQUIRE_THROWS_MATCHES(
+            info.extractTo( extracted ),
+            BitException,
+            Catch::Matchers::Predicate< BitException >(
+                []( const BitException& exception ) -> bool {
+                    return exception.code() == BitError::FormatFeatureNotSupported;
+                },
+                "Error code should be BitError::FormatFeatureNotSupported"
+            )
+        );
+    }
+
+    SECTION( "Formats not supporting sequential reading" ) {
+        REQUIRE_THROWS_AS( BitArchiveReader( lib, archiveStream, BitFormat::Zip ), BitException );
+    }
+
+#ifdef BIT7Z_AUTO_FORMAT
+    SECTION( "Automatic format detection is not supported" ) {
+        REQUIRE_THROWS_AS( BitArchiveReader( lib, archiveStream ), BitException );
+    }
+#endif
+}
+
+TEST_CASE( "BitArchiveReader: Reading a GZip archive from a non-seekable stream", "[bitarchivereader]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "single_file" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    buffer_t archiveContent;
+    getInputArchive( "clouds.jpg.gz", archiveContent );
+    NonSeekableBuffer archiveBuffer{ archiveContent };
+    std::istream archiveStream{ &archiveBuffer };
+    REQUIRE( archiveStream.tellg() == std::istream::pos_type( -1 ) );
+
+    const BitArchiveReader info( lib, archiveStream, BitFormat::GZip );
+
+    std::map< tstring, buffer_t > extracted;
+    REQUIRE_NOTHROW( info.extractTo( extracted ) );
+    REQUIRE( extracted.size() == 1 );
+
+    const BitArchiveReader expectedArchive( lib, archiveContent, BitFormat::GZip );
+    std::map< tstring, buffer_t > expected;
+    REQUIRE_NOTHROW( expectedArchive.extractTo( expected ) );
+    REQUIRE( extracted == expected );
+
+    REQUIRE_THROWS_AS( info.test(), BitException );
 }
 
 TEMPLATE_TEST_CASE( "BitArchiveReader: Reading invalid archives",
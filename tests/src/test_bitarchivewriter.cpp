@@ -14,7 +14,13 @@
 
 #include "utils/shared_lib.hpp"
 
+#include <bit7z/bitarchivereader.hpp>
 #include <bit7z/bitarchivewriter.hpp>
+#include <bit7z/bitexception.hpp>
+
+#include <map>
+#include <ostream>
+#include <streambuf>
 
 using namespace bit7z;
 
@@ -23,4 +29,59 @@ TEST_CASE( "BitArchiveWriter: TODO", "[bitarchivewriter]" ) {
 
     const BitArchiveWriter writer{lib, BitFormat::SevenZip};
     REQUIRE( writer.compressionFormat() == BitFormat::SevenZip ); // Just a placeholder test.
-}
\ No newline at end of file
+}
+
+// A stream buffer appending the written data to a buffer, without supporting seeking (like a pipe).
+class NonSeekableOutBuffer final : public std::streambuf {
+    public:
+        explicit NonSeekableOutBuffer( buffer_t& content ) : mContent{ content } {}
+
+    protected:
+        auto overflow( int_type character ) -> int_type override {
+            if ( !traits_type::eq_int_type( character, traits_type::eof() ) ) {
+                mContent.push_back( static_cast< byte_t >( character ) );
+            }
+            return traits_type::not_eof( character );
+        }
+
+        auto xsputn( const char_type* data, std::streamsize size ) -> std::streamsize override {
+            mContent.insert( mContent.end(), data, data + size ); // NOLINT(*-pro-bounds-pointer-arithmetic)
+            return size;
+        }
+
+    private:
+        buffer_t& mContent;
+};
+
+TEST_CASE( "BitArchiveWriter: Writing an archive to a non-seekable stream", "[bitarchivewriter]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const buffer_t firstFile( 4096, static_cast< byte_t >( 'a' ) );
+    const buffer_t secondFile{ static_cast< byte_t >( 'b' ), static_cast< byte_t >( 'c' ) };
+
+    buffer_t archiveContent;
+    NonSeekableOutBuffer archiveBuffer{ archiveContent };
+    std::ostream archiveStream{ &archiveBuffer };
+    REQUIRE( archiveStream.tellp() == std::ostream::pos_type( -1 ) );
+
+    SECTION( "Formats supporting sequential writing" ) {
+        BitArchiveWriter writer{ lib, BitFormat::Tar };
+        writer.addFile( firstFile, BIT7Z_STRING( "first.txt" ) );
+        writer.addFile( secondFile, BIT7Z_STRING( "second.txt" ) );
+        REQUIRE_NOTHROW( writer.compressTo( archiveStream ) );
+        REQUIRE_FALSE( archiveContent.empty() );
+
+        const BitArchiveReader reader{ lib, archiveContent, BitFormat::Tar };
+        std::map< tstring, buffer_t > extracted;
+        REQUIRE_NOTHROW( reader.extractTo( extracted ) );
+        REQUIRE( extracted.size() == 2 );
+        REQUIRE( extracted[ BIT7Z_STRING( "first.txt" ) ] == firstFile );
+        REQUIRE( extracted[ BIT7Z_STRING( "second.txt" ) ] == secondFile );
+    }
+
+    SECTION( "Formats not supporting sequential writing" ) {
+        BitArchiveWriter writer{ lib, BitFormat::SevenZip };
+        writer.addFile( firstFile, BIT7Z_STRING( "first.txt" ) );
+        REQUIRE_THROWS_AS( writer.compressTo( archiveStream ), BitException );
+    }
+}
@@ -12,10 +12,22 @@
 
 #include <catch2/catch.hpp>
 
+#include "utils/filesystem.hpp"
 #include "utils/shared_lib.hpp"
 
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bitfilecompressor.hpp>
 #include <bit7z/bitfileextractor.hpp>
 
+#include <chrono>
+#include <map>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
 using namespace bit7z;
 
 TEST_CASE( "BitFileExtractor: TODO", "[bitfileextractor]" ) {
@@ -23,4 +35,256 @@ TEST_CASE( "BitFileExtractor: TODO", "[bitfileextractor]" ) {
 
     const BitFileExtractor extractor{lib, BitFormat::SevenZip};
     REQUIRE( extractor.extractionFormat() == BitFormat::SevenZip ); // Just a placeholder test.
-}
\ No newline at end of file
+}
+
+TEST_CASE( "BitFileExtractor: setExtractionThreads(...) / extractionThreads()", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    REQUIRE( extractor.extractionThreads() == 1 );
+
+    extractor.setExtractionThreads( 4 );
+    REQUIRE( extractor.extractionThreads() == 4 );
+
+    extractor.setExtractionThreads( 0 );
+    REQUIRE( extractor.extractionThreads() == 0 );
+}
+
+TEST_CASE( "BitFileExtractor: setPreallocateFiles(...) / setSparseFiles(...)", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    REQUIRE_FALSE( extractor.preallocateFiles() );
+    REQUIRE_FALSE( extractor.sparseFiles() );
+
+    extractor.setPreallocateFiles( true );
+    REQUIRE( extractor.preallocateFiles() );
+    REQUIRE_FALSE( extractor.sparseFiles() );
+
+    extractor.setSparseFiles( true );
+    REQUIRE( extractor.preallocateFiles() );
+    REQUIRE( extractor.sparseFiles() );
+}
+
+TEST_CASE( "BitFileExtractor: setWriteBehind(...) / writeBehind()", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    REQUIRE_FALSE( extractor.writeBehind() );
+
+    extractor.setWriteBehind( true );
+    REQUIRE( extractor.writeBehind() );
+
+    extractor.setWriteBehind( false );
+    REQUIRE_FALSE( extractor.writeBehind() );
+}
+
+TEST_CASE( "BitFileExtractor: setReadAhead(...) / readAheadBlockSize() / readAheadBlocks()", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    REQUIRE( extractor.readAheadBlockSize() == 0 );
+    REQUIRE( extractor.readAheadBlocks() == BitFileExtractor::kDefaultReadAheadBlocks );
+
+    extractor.setReadAhead( 1024 * 1024 );
+    REQUIRE( extractor.readAheadBlockSize() == 1024 * 1024 );
+    REQUIRE( extractor.readAheadBlocks() == BitFileExtractor::kDefaultReadAheadBlocks );
+
+    extractor.setReadAhead( 4096, 4 );
+    REQUIRE( extractor.readAheadBlockSize() == 4096 );
+    REQUIRE( extractor.readAheadBlocks() == 4 );
+
+    // At least one block is always read ahead.
+    extractor.setReadAhead( 4096, 0 );
+    REQUIRE( extractor.readAheadBlocks() == 1 );
+
+    extractor.setReadAhead( 0 );
+    REQUIRE( extractor.readAheadBlockSize() == 0 );
+}
+
+TEST_CASE( "BitFileExtractor: setMaxOpenVolumes(...) / maxOpenVolumes()", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    REQUIRE( extractor.maxOpenVolumes() == BitFileExtractor::kDefaultMaxOpenVolumes );
+
+    extractor.setMaxOpenVolumes( 8 );
+    REQUIRE( extractor.maxOpenVolumes() == 8 );
+
+    // At least one volume is always kept open.
+    extractor.setMaxOpenVolumes( 0 );
+    REQUIRE( extractor.maxOpenVolumes() == 1 );
+}
+
+#ifdef BIT7Z_TESTS_FILESYSTEM
+
+using namespace bit7z::test::filesystem;
+
+namespace {
+auto directory_content( const fs::path& directory ) -> std::map< fs::path, buffer_t > {
+    std::map< fs::path, buffer_t > result;
+    for ( const auto& entry : fs::recursive_directory_iterator( directory ) ) {
+        const auto relativePath = fs::relative( entry.path(), directory );
+        result[ relativePath ] = fs::is_directory( entry.path() ) ? buffer_t{} : load_file( entry.path() );
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE( "BitFileExtractor: Extracting an archive using multiple threads", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    // Note: only non-solid archives are extracted using multiple threads.
+    const fs::path archivePath = fs::path{ test_archives_dir } / "extraction" / "multiple_items" / "multiple_items.zip";
+    const auto outDir = fs::temp_directory_path() / "bit7z_extraction_threads";
+    const auto expectedDir = outDir / "expected";
+    const auto extractedDir = outDir / "extracted";
+    std::error_code error;
+    fs::remove_all( outDir, error );
+
+    BitFileExtractor extractor{ lib, BitFormat::Zip };
+    REQUIRE_NOTHROW( extractor.extract( to_tstring( archivePath.native() ), to_tstring( expectedDir.native() ) ) );
+    const auto expectedContent = directory_content( expectedDir );
+    REQUIRE( expectedContent.size() > 1 );
+
+    const uint32_t threadsCount = GENERATE( 2u, 4u, 64u );
+    DYNAMIC_SECTION( "Threads: " << threadsCount ) {
+        SECTION( "Using BitFileExtractor" ) {
+            extractor.setExtractionThreads( threadsCount );
+            REQUIRE_NOTHROW( extractor.extract( to_tstring( archivePath.native() ),
+                                                to_tstring( extractedDir.native() ) ) );
+        }
+
+        SECTION( "Using BitArchiveReader (reopening the archive with the same settings)" ) {
+            BitArchiveReader reader{ lib, to_tstring( archivePath.native() ), ArchiveStartOffset::FileStart,
+                                     BitFormat::Zip };
+            reader.setExtractionThreads( threadsCount );
+            REQUIRE_NOTHROW( reader.extractTo( to_tstring( extractedDir.native() ) ) );
+        }
+
+        REQUIRE( directory_content( extractedDir ) == expectedContent );
+    }
+
+    fs::remove_all( outDir, error );
+}
+
+TEST_CASE( "BitFileExtractor: Extracting an archive over existing files", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const fs::path archivePath = fs::path{ test_archives_dir } / "extraction" / "multiple_items" / "multiple_items.zip";
+    const auto outDir = fs::temp_directory_path() / "bit7z_extraction_overwrite";
+    const auto expectedDir = outDir / "expected";
+    const auto extractedDir = outDir / "extracted";
+    std::error_code error;
+    fs::remove_all( outDir, error );
+
+    BitFileExtractor extractor{ lib, BitFormat::Zip };
+    REQUIRE_NOTHROW( extractor.extract( to_tstring( archivePath.native() ), to_tstring( expectedDir.native() ) ) );
+    REQUIRE_NOTHROW( extractor.extract( to_tstring( archivePath.native() ), to_tstring( extractedDir.native() ) ) );
+    const auto expectedContent = directory_content( expectedDir );
+
+    // Changing the content of the first two files, and replacing the second one with an empty directory.
+    std::vector< fs::path > changedFiles;
+    for ( const auto& entry : fs::recursive_directory_iterator( extractedDir ) ) {
+        if ( fs::is_regular_file( entry.path() ) && changedFiles.size() < 2 ) {
+            changedFiles.push_back( entry.path() );
+        }
+    }
+    REQUIRE( changedFiles.size() == 2 );
+    {
+        fs::ofstream changedFile{ changedFiles[ 0 ], std::ios::binary | std::ios::trunc };
+        changedFile << "changed content";
+    }
+    REQUIRE( fs::remove( changedFiles[ 1 ] ) );
+    REQUIRE( fs::create_directory( changedFiles[ 1 ] ) );
+    const auto changedContent = directory_content( extractedDir );
+    REQUIRE( changedContent != expectedContent );
+
+    SECTION( "OverwriteMode::Overwrite" ) {
+        extractor.setOverwriteMode( OverwriteMode::Overwrite );
+        REQUIRE_NOTHROW( extractor.extract( to_tstring( archivePath.native() ),
+                                            to_tstring( extractedDir.native() ) ) );
+        REQUIRE( directory_content( extractedDir ) == expectedContent );
+    }
+
+    SECTION( "OverwriteMode::Skip" ) {
+        extractor.setOverwriteMode( OverwriteMode::Skip );
+        REQUIRE_NOTHROW( extractor.extract( to_tstring( archivePath.native() ),
+                                            to_tstring( extractedDir.native() ) ) );
+        REQUIRE( directory_content( extractedDir ) == changedContent );
+    }
+
+    SECTION( "OverwriteMode::None" ) {
+        extractor.setOverwriteMode( OverwriteMode::None );
+        REQUIRE_THROWS_AS( extractor.extract( to_tstring( archivePath.native() ),
+                                              to_tstring( extractedDir.native() ) ), BitException );
+        REQUIRE( directory_content( extractedDir ) == changedContent );
+    }
+
+    fs::remove_all( outDir, error );
+}
+
+#ifndef _WIN32
+TEST_CASE( "BitFileExtractor: Restoring the metadata of the extracted items", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testDir = fs::temp_directory_path() / "bit7z_extraction_metadata";
+    const auto inputDir = testDir / "input";
+    const auto outDir = testDir / "output";
+    std::error_code error;
+    fs::remove_all( testDir, error );
+
+    // A file inside a nested directory, so that the file is extracted after its parent directories.
+    const auto nestedDir = inputDir / "folder" / "subfolder";
+    REQUIRE( fs::create_directories( nestedDir, error ) );
+    const auto filePath = nestedDir / "file.txt";
+    {
+        fs::ofstream file{ filePath, std::ios::binary };
+        file << "Lorem ipsum dolor sit amet";
+    }
+
+    const auto filePermissions = fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read;
+    const auto directoryPermissions = fs::perms::owner_all | fs::perms::group_read | fs::perms::group_exec;
+    const auto fileTime = fs::last_write_time( filePath ) - std::chrono::hours( 24 * 365 );
+    const auto directoryTime = fileTime - std::chrono::hours( 24 );
+    fs::permissions( filePath, filePermissions );
+    fs::permissions( nestedDir, directoryPermissions );
+    fs::last_write_time( filePath, fileTime );
+    fs::last_write_time( nestedDir, directoryTime );
+    fs::last_write_time( nestedDir.parent_path(), directoryTime );
+
+    const auto archivePath = to_tstring( ( testDir / "archive.7z" ).native() );
+    const BitFileCompressor compressor{ lib, BitFormat::SevenZip };
+    REQUIRE_NOTHROW( compressor.compress( std::vector< tstring >{ to_tstring( ( inputDir / "folder" ).native() ) },
+                                          archivePath ) );
+
+    const BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    REQUIRE_NOTHROW( extractor.extract( archivePath, to_tstring( outDir.native() ) ) );
+
+    // Note: the extracted items are created using the current umask.
+    const auto currentUmask = ::umask( 0 );
+    ::umask( currentUmask );
+    const auto umaskPerms = static_cast< fs::perms >( currentUmask );
+
+    const auto toSeconds = []( fs::file_time_type time ) -> std::chrono::seconds::rep {
+        return std::chrono::duration_cast< std::chrono::seconds >( time.time_since_epoch() ).count();
+    };
+
+    const auto extractedFile = outDir / "folder" / "subfolder" / "file.txt";
+    REQUIRE( fs::is_regular_file( extractedFile ) );
+    REQUIRE( ( fs::status( extractedFile ).permissions() & fs::perms::mask ) == ( filePermissions & ~umaskPerms ) );
+    REQUIRE( toSeconds( fs::last_write_time( extractedFile ) ) == toSeconds( fileTime ) );
+
+    // The times of the directories are restored after their content is extracted.
+    const auto extractedDir = outDir / "folder" / "subfolder";
+    REQUIRE( fs::is_directory( extractedDir ) );
+    REQUIRE( ( fs::status( extractedDir ).permissions() & fs::perms::mask ) ==
+             ( directoryPermissions & ~umaskPerms ) );
+    REQUIRE( toSeconds( fs::last_write_time( extractedDir ) ) == toSeconds( directoryTime ) );
+    REQUIRE( toSeconds( fs::last_write_time( extractedDir.parent_path() ) ) == toSeconds( directoryTime ) );
+
+    fs::remove_all( testDir, error );
+}
+#endif
+
+#endif
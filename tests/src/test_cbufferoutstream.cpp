@@ -0,0 +1,79 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferoutstream.hpp>
+
+using bit7z::byte_t;
+using bit7z::buffer_t;
+using bit7z::CBufferOutStream;
+
+TEST_CASE( "CBufferOutStream: Writing to a buffer stream", "[cbufferoutstream][writing]" ) {
+    const buffer_t data = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+
+    buffer_t buffer;
+    CBufferOutStream outStream{ buffer };
+    UInt32 processedSize{ 0 };
+
+    SECTION( "Appending the data to an empty buffer" ) {
+        REQUIRE( outStream.Write( data.data(), 3, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 3 );
+        REQUIRE( outStream.Write( &data[ 3 ], 2, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 2 );
+        REQUIRE( buffer == data );
+    }
+
+    SECTION( "Overwriting the whole content of the buffer" ) {
+        REQUIRE( outStream.Write( data.data(), 5, &processedSize ) == S_OK );
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_SET, nullptr ) == S_OK );
+
+        const buffer_t newData = { 0x0A, 0x0B };
+        REQUIRE( outStream.Write( newData.data(), 2, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 2 );
+        REQUIRE( buffer == buffer_t{ 0x0A, 0x0B, 0x03, 0x04, 0x05 } );
+    }
+
+    SECTION( "Overwriting the end of the buffer and appending the remaining data" ) {
+        REQUIRE( outStream.Write( data.data(), 5, &processedSize ) == S_OK );
+        REQUIRE( outStream.Seek( -2, STREAM_SEEK_END, nullptr ) == S_OK );
+
+        const buffer_t newData = { 0x0A, 0x0B, 0x0C };
+        REQUIRE( outStream.Write( newData.data(), 3, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 3 );
+        REQUIRE( buffer == buffer_t{ 0x01, 0x02, 0x03, 0x0A, 0x0B, 0x0C } );
+
+        // The stream position must be right after the written data.
+        UInt64 newPosition{ 0 };
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 6 );
+    }
+
+    SECTION( "Writing after shrinking the buffer" ) {
+        REQUIRE( outStream.Write( data.data(), 5, &processedSize ) == S_OK );
+        REQUIRE( outStream.SetSize( 2 ) == S_OK );
+        REQUIRE( outStream.Write( &data[ 4 ], 1, &processedSize ) == S_OK );
+        REQUIRE( buffer == buffer_t{ 0x01, 0x02, 0x05 } );
+    }
+
+    SECTION( "Writing into a buffer with reserved memory" ) {
+        buffer_t reservedBuffer;
+        reservedBuffer.reserve( 1024 );
+        CBufferOutStream reservedStream{ reservedBuffer };
+        REQUIRE( reservedStream.Write( data.data(), 5, &processedSize ) == S_OK );
+        REQUIRE( reservedBuffer == data );
+        REQUIRE( reservedBuffer.capacity() == 1024 );
+    }
+}
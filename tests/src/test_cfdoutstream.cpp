@@ -0,0 +1,177 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _WIN32
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bittypes.hpp>
+#include <internal/cfdoutstream.hpp>
+#include <internal/fs.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace bit7z;
+
+namespace {
+auto read_file( const fs::path& filePath ) -> buffer_t {
+    std::ifstream input{ filePath.c_str(), std::ios::binary };
+    return buffer_t{ std::istreambuf_iterator< char >{ input }, std::istreambuf_iterator< char >{} };
+}
+
+// Checks whether the filesystem of the given directory supports sparse files (i.e., files with holes).
+auto supports_sparse_files( const fs::path& directory ) -> bool {
+    const auto probePath = directory / "bit7z_sparse_probe.bin";
+    // NOLINTNEXTLINE(*-vararg)
+    const int fileDescriptor = ::open( probePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if ( fileDescriptor < 0 ) {
+        return false;
+    }
+    struct stat fileStat{};
+    const bool result = ::ftruncate( fileDescriptor, 1024 * 1024 ) == 0 &&
+                        ::fstat( fileDescriptor, &fileStat ) == 0 &&
+                        fileStat.st_blocks == 0;
+    ::close( fileDescriptor );
+    std::error_code error;
+    fs::remove( probePath, error );
+    return result;
+}
+} // namespace
+
+TEST_CASE( "CFdOutStream: Writing a file", "[cfdoutstream]" ) {
+    const auto filePath = fs::temp_directory_path() / "bit7z_cfdoutstream.bin";
+    std::error_code error;
+    fs::remove( filePath, error );
+
+    // Data blocks interleaved with (aligned and unaligned) runs of zeros, ending with zeros.
+    buffer_t content( 5 * 4096 + 100, 0 );
+    std::fill_n( content.begin() + 10, 20, static_cast< byte_t >( 0xAB ) );
+    std::fill_n( content.begin() + ( 3 * 4096 ), 4096, static_cast< byte_t >( 0xCD ) );
+
+    const bool sparse = GENERATE( false, true );
+    const bool preallocate = GENERATE( false, true );
+    const UInt32 chunkSize = GENERATE( 1000u, 4096u, 1024u * 1024u );
+
+    DYNAMIC_SECTION( "Sparse: " << sparse << ", preallocated: " << preallocate << ", chunk size: " << chunkSize ) {
+        {
+            // NOLINTNEXTLINE(*-vararg)
+            const int fileDescriptor = ::open( filePath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644 );
+            REQUIRE( fileDescriptor >= 0 );
+
+            CFdOutStream outStream{ fileDescriptor, filePath };
+            if ( preallocate ) {
+                static_cast< void >( outStream.preallocate( content.size() ) );
+            }
+            outStream.setSparse( sparse );
+
+            std::size_t position = 0;
+            while ( position < content.size() ) {
+                const auto remaining = content.size() - position;
+                const auto size = static_cast< UInt32 >( std::min< std::size_t >( chunkSize, remaining ) );
+                UInt32 processedSize = 0;
+                REQUIRE( outStream.Write( &content[ position ], size, &processedSize ) == S_OK );
+                REQUIRE( processedSize == size );
+                position += size;
+            }
+            REQUIRE_FALSE( outStream.fail() );
+        }
+
+        REQUIRE( fs::file_size( filePath ) == content.size() );
+        REQUIRE( read_file( filePath ) == content );
+    }
+
+    fs::remove( filePath, error );
+}
+
+TEST_CASE( "CFdOutStream: Writing a sparse file ending with zero blocks", "[cfdoutstream]" ) {
+    const auto filePath = fs::temp_directory_path() / "bit7z_cfdoutstream_sparse.bin";
+    std::error_code error;
+    fs::remove( filePath, error );
+
+    // Two data blocks, followed by six blocks of zeros (i.e., the file is extended only by ftruncate).
+    constexpr std::size_t kBlockSize = 4096;
+    buffer_t content( 8 * kBlockSize, 0 );
+    std::fill_n( content.begin(), kBlockSize, static_cast< byte_t >( 0xAB ) );
+    std::fill_n( content.begin() + kBlockSize, kBlockSize, static_cast< byte_t >( 0xCD ) );
+
+    const bool preallocate = GENERATE( false, true );
+    DYNAMIC_SECTION( "Preallocated: " << preallocate ) {
+        struct stat fileStat{};
+        {
+            // NOLINTNEXTLINE(*-vararg)
+            const int fileDescriptor = ::open( filePath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644 );
+            REQUIRE( fileDescriptor >= 0 );
+
+            CFdOutStream outStream{ fileDescriptor, filePath };
+            if ( preallocate ) {
+                static_cast< void >( outStream.preallocate( content.size() ) );
+            }
+            outStream.setSparse( true );
+
+            UInt32 processedSize = 0;
+            const auto size = static_cast< UInt32 >( content.size() );
+            REQUIRE( outStream.Write( content.data(), size, &processedSize ) == S_OK );
+            REQUIRE( processedSize == content.size() );
+            REQUIRE_FALSE( outStream.fail() );
+            REQUIRE( ::fstat( fileDescriptor, &fileStat ) == 0 );
+        }
+
+        REQUIRE( static_cast< std::size_t >( fileStat.st_size ) == content.size() );
+        REQUIRE( fs::file_size( filePath ) == content.size() );
+        REQUIRE( read_file( filePath ) == content );
+
+        // The zero blocks are holes in the file, so only the data blocks are allocated (st_blocks is in 512B units).
+        if ( supports_sparse_files( filePath.parent_path() ) ) {
+            REQUIRE( static_cast< std::size_t >( fileStat.st_blocks ) * 512 < content.size() );
+        }
+    }
+
+    fs::remove( filePath, error );
+}
+
+TEST_CASE( "CFdOutStream: A failed write is not reset by the following ones", "[cfdoutstream]" ) {
+    const auto filePath = fs::temp_directory_path() / "bit7z_cfdoutstream_failure.bin";
+    std::error_code error;
+    fs::remove( filePath, error );
+
+    {
+        // NOLINTNEXTLINE(*-vararg)
+        const int fileDescriptor = ::open( filePath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644 );
+        REQUIRE( fileDescriptor >= 0 );
+
+        CFdOutStream outStream{ fileDescriptor, filePath };
+        const buffer_t content( 16, static_cast< byte_t >( 0xAB ) );
+        const auto contentSize = static_cast< UInt32 >( content.size() );
+
+        // Writing beyond the maximum file size supported by the filesystem.
+        REQUIRE( outStream.Seek( std::numeric_limits< Int64 >::max() - 1, STREAM_SEEK_SET, nullptr ) == S_OK );
+        UInt32 processedSize = 0;
+        REQUIRE( outStream.Write( content.data(), contentSize, &processedSize ) != S_OK );
+        REQUIRE( processedSize == 0 );
+        REQUIRE( outStream.fail() );
+
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_SET, nullptr ) == S_OK );
+        REQUIRE( outStream.Write( content.data(), contentSize, &processedSize ) != S_OK );
+        REQUIRE( outStream.fail() );
+    }
+
+    fs::remove( filePath, error );
+}
+
+#endif
@@ -0,0 +1,73 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bittypes.hpp>
+#include <internal/cfileinstream.hpp>
+#include <internal/fs.hpp>
+
+#include <fstream>
+
+using namespace bit7z;
+
+TEST_CASE( "CFileInStream: Opening a non-existing file", "[cfileinstream]" ) {
+    REQUIRE_THROWS_AS( CFileInStream( "non_existing_file.txt" ), BitException );
+}
+
+TEST_CASE( "CFileInStream: Reading a file", "[cfileinstream][reading]" ) {
+    const auto filePath = fs::temp_directory_path() / "bit7z_cfileinstream.bin";
+    const buffer_t content = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+    {
+        fs::ofstream output{ filePath, std::ios::binary | std::ios::trunc };
+        output.write( reinterpret_cast< const char* >( content.data() ), // NOLINT(*-reinterpret-cast)
+                      static_cast< std::streamsize >( content.size() ) );
+    }
+
+    {
+        CFileInStream inStream{ filePath };
+        buffer_t buffer( 16, 0 );
+        UInt32 processedSize{ 0 };
+        UInt64 newPosition{ 0 };
+
+        REQUIRE( inStream.Read( buffer.data(), 3, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 3 );
+        REQUIRE( buffer_t( buffer.begin(), buffer.begin() + 3 ) == buffer_t{ 0x01, 0x02, 0x03 } );
+
+        REQUIRE( inStream.Seek( 2, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 5 );
+        REQUIRE( inStream.Read( buffer.data(), 16, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 3 );
+        REQUIRE( buffer_t( buffer.begin(), buffer.begin() + 3 ) == buffer_t{ 0x06, 0x07, 0x08 } );
+
+        // Reading at the end of the file.
+        REQUIRE( inStream.Read( buffer.data(), 16, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 0 );
+
+        REQUIRE( inStream.Seek( -2, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 6 );
+        REQUIRE( inStream.Read( buffer.data(), 1, &processedSize ) == S_OK );
+        REQUIRE( buffer[ 0 ] == 0x07 );
+
+        REQUIRE( inStream.Seek( 0, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 0 );
+        REQUIRE( inStream.Seek( -1, STREAM_SEEK_SET, &newPosition ) != S_OK );
+        REQUIRE( inStream.Seek( 0, STREAM_SEEK_END + 1, &newPosition ) == STG_E_INVALIDFUNCTION );
+    }
+
+    std::error_code error;
+    fs::remove( filePath, error );
+}
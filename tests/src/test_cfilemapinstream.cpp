@@ -0,0 +1,77 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include "utils/filesystem.hpp"
+
+#include <bit7z/bitexception.hpp>
+#include <internal/cfilemapinstream.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using bit7z::BitException;
+using bit7z::byte_t;
+using bit7z::CFileMapInStream;
+
+TEST_CASE( "CFileMapInStream: Mapping a non-existing file", "[cfilemapinstream]" ) {
+    REQUIRE_THROWS_AS( CFileMapInStream( "non_existing_file.txt", false ), BitException );
+}
+
+#ifdef BIT7Z_TESTS_FILESYSTEM
+
+using namespace bit7z::test::filesystem;
+
+TEST_CASE( "CFileMapInStream: Reading the content of a mapped file", "[cfilemapinstream][reading]" ) {
+    const auto testFile = GENERATE( as< const FilesystemItemInfo* >(), &italy, &lorem_ipsum, &clouds, &noext );
+    const fs::path filePath = fs::path{ test_filesystem_dir } / testFile->name;
+    const bool sequentialAccess = GENERATE( true, false );
+
+    DYNAMIC_SECTION( "Mapping file " << filePath.filename().string() ) {
+        REQUIRE_LOAD_FILE( expectedContent, filePath );
+
+        CFileMapInStream inStream{ filePath, sequentialAccess };
+        REQUIRE( inStream.size() == testFile->size );
+
+        SECTION( "Reading the whole file" ) {
+            std::vector< byte_t > content( expectedContent.size() );
+            UInt32 processedSize = 0;
+            REQUIRE( inStream.Read( content.data(), static_cast< UInt32 >( content.size() ), &processedSize ) == S_OK );
+            REQUIRE( processedSize == content.size() );
+            REQUIRE( content == expectedContent );
+
+            // We reached the end of the file, so no more data can be read.
+            REQUIRE( inStream.Read( content.data(), 1, &processedSize ) == S_OK );
+            REQUIRE( processedSize == 0 );
+        }
+
+        SECTION( "Reading the file after seeking to its middle" ) {
+            const auto midOffset = static_cast< Int64 >( expectedContent.size() / 2 );
+            UInt64 newPosition = 0;
+            REQUIRE( inStream.Seek( midOffset, STREAM_SEEK_SET, &newPosition ) == S_OK );
+            REQUIRE( newPosition == static_cast< UInt64 >( midOffset ) );
+
+            // Trying to read more than the remaining data.
+            std::vector< byte_t > content( expectedContent.size() );
+            UInt32 processedSize = 0;
+            REQUIRE( inStream.Read( content.data(), static_cast< UInt32 >( content.size() ), &processedSize ) == S_OK );
+            REQUIRE( processedSize == expectedContent.size() - midOffset );
+            REQUIRE( std::equal( expectedContent.cbegin() + midOffset, expectedContent.cend(), content.cbegin() ) );
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bittypes.hpp>
+#include <internal/cfileoutstream.hpp>
+#include <internal/fs.hpp>
+
+#include <fstream>
+#include <iterator>
+
+using namespace bit7z;
+
+namespace {
+auto read_file( const fs::path& filePath ) -> buffer_t {
+    fs::ifstream input{ filePath, std::ios::binary };
+    return buffer_t{ std::istreambuf_iterator< char >{ input }, std::istreambuf_iterator< char >{} };
+}
+} // namespace
+
+TEST_CASE( "CFileOutStream: Writing a file", "[cfileoutstream][writing]" ) {
+    const auto filePath = fs::temp_directory_path() / "bit7z_cfileoutstream.bin";
+    std::error_code error;
+    fs::remove( filePath, error );
+
+    const buffer_t data = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+    UInt32 processedSize{ 0 };
+    UInt64 newPosition{ 0 };
+
+    SECTION( "Writing, seeking, and resizing the file" ) {
+        {
+            CFileOutStream outStream{ filePath };
+            REQUIRE( outStream.Write( data.data(), 5, &processedSize ) == S_OK );
+            REQUIRE( processedSize == 5 );
+
+            REQUIRE( outStream.Seek( 1, STREAM_SEEK_SET, &newPosition ) == S_OK );
+            REQUIRE( newPosition == 1 );
+            const buffer_t newData = { 0x0A, 0x0B };
+            REQUIRE( outStream.Write( newData.data(), 2, &processedSize ) == S_OK );
+            REQUIRE( outStream.Seek( 0, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+            REQUIRE( newPosition == 3 );
+
+            REQUIRE( outStream.Seek( -1, STREAM_SEEK_END, &newPosition ) == S_OK );
+            REQUIRE( newPosition == 4 );
+            REQUIRE( outStream.Seek( -5, STREAM_SEEK_CUR, &newPosition ) != S_OK );
+
+            REQUIRE( outStream.SetSize( 8 ) == S_OK );
+            REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+            REQUIRE( newPosition == 8 );
+            REQUIRE_FALSE( outStream.fail() );
+        }
+        REQUIRE( read_file( filePath ) == buffer_t{ 0x01, 0x0A, 0x0B, 0x04, 0x05, 0x00, 0x00, 0x00 } );
+    }
+
+    SECTION( "Creating a file that already exists" ) {
+        {
+            CFileOutStream outStream{ filePath };
+            REQUIRE( outStream.Write( data.data(), 5, &processedSize ) == S_OK );
+        }
+        REQUIRE_THROWS_AS( CFileOutStream( filePath ), BitException );
+        REQUIRE( read_file( filePath ) == data );
+
+        // Overwriting the existing file.
+        {
+            CFileOutStream outStream{ filePath, true };
+            REQUIRE( outStream.Write( data.data(), 2, &processedSize ) == S_OK );
+        }
+        REQUIRE( read_file( filePath ) == buffer_t{ 0x01, 0x02 } );
+    }
+
+    fs::remove( filePath, error );
+}
@@ -0,0 +1,88 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitabstractarchivehandler.hpp>
+#include <bit7z/bittypes.hpp>
+#include <internal/cmultivolumeinstream.hpp>
+#include <internal/fs.hpp>
+#include <internal/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+using namespace bit7z;
+
+TEST_CASE( "CMultiVolumeInStream: Reading a split archive", "[cmultivolumeinstream][reading]" ) {
+    const auto volumesDir = fs::temp_directory_path() / "bit7z_cmultivolumeinstream";
+    std::error_code error;
+    fs::remove_all( volumesDir, error );
+    REQUIRE( fs::create_directories( volumesDir ) );
+
+    // Five volumes of 7 bytes each, except for the last one.
+    constexpr std::size_t kVolumeSize = 7;
+    constexpr std::size_t kVolumesCount = 5;
+    buffer_t content;
+    for ( std::size_t index = 0; index < ( kVolumeSize * ( kVolumesCount - 1 ) ) + 3; ++index ) {
+        content.push_back( static_cast< byte_t >( index ) );
+    }
+    for ( std::size_t volume = 0; volume < kVolumesCount; ++volume ) {
+        fs::ofstream output{ volumesDir / ( "archive.bin.00" + std::to_string( volume + 1 ) ), std::ios::binary };
+        const auto volumeStart = volume * kVolumeSize;
+        const auto volumeEnd = std::min( volumeStart + kVolumeSize, content.size() );
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        output.write( reinterpret_cast< const char* >( &content[ volumeStart ] ),
+                      static_cast< std::streamsize >( volumeEnd - volumeStart ) );
+    }
+
+    const std::size_t maxOpenVolumes = GENERATE( 1, 2, 64 );
+    DYNAMIC_SECTION( "Keeping at most " << maxOpenVolumes << " volumes open" ) {
+        auto inStream = bit7z::make_com< CMultiVolumeInStream, IInStream >( volumesDir / "archive.bin.001",
+                                                                              FileAccessMode::Stream,
+                                                                              maxOpenVolumes );
+
+        UInt64 newPosition{ 0 };
+        REQUIRE( inStream->Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == content.size() );
+
+        SECTION( "Reading the whole content sequentially" ) {
+            REQUIRE( inStream->Seek( 0, STREAM_SEEK_SET, &newPosition ) == S_OK );
+
+            buffer_t result;
+            buffer_t chunk( 4 );
+            UInt32 processedSize{ 0 };
+            do {
+                REQUIRE( inStream->Read( chunk.data(), static_cast< UInt32 >( chunk.size() ), &processedSize ) == S_OK );
+                result.insert( result.end(), chunk.begin(), chunk.begin() + processedSize );
+            } while ( processedSize > 0 );
+            REQUIRE( result == content );
+        }
+
+        SECTION( "Reading back and forth between the volumes" ) {
+            for ( const std::size_t offset : { 30, 2, 15, 29, 0, 22, 9, 28 } ) {
+                REQUIRE( inStream->Seek( static_cast< Int64 >( offset ), STREAM_SEEK_SET, &newPosition ) == S_OK );
+                byte_t value{ 0 };
+                UInt32 processedSize{ 0 };
+                REQUIRE( inStream->Read( &value, 1, &processedSize ) == S_OK );
+                REQUIRE( processedSize == 1 );
+                REQUIRE( value == content[ offset ] );
+            }
+        }
+    }
+
+    fs::remove_all( volumesDir, error );
+}
@@ -0,0 +1,124 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bittypes.hpp>
+#include <internal/cmultivolumeoutstream.hpp>
+#include <internal/fs.hpp>
+#include <internal/stringutil.hpp>
+#include <internal/util.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace bit7z;
+
+namespace {
+auto read_file( const fs::path& filePath ) -> buffer_t {
+    fs::ifstream input{ filePath, std::ios::binary };
+    return buffer_t{ std::istreambuf_iterator< char >{ input }, std::istreambuf_iterator< char >{} };
+}
+
+// Note: each write to a multi-volume stream writes at most up to the end of the current volume.
+auto write_all( IOutStream* outStream, const buffer_t& data ) -> HRESULT {
+    UInt32 writtenSize = 0;
+    while ( writtenSize < data.size() ) {
+        UInt32 processedSize{ 0 };
+        const auto size = static_cast< UInt32 >( data.size() ) - writtenSize;
+        const HRESULT result = outStream->Write( &data[ writtenSize ], size, &processedSize );
+        if ( result != S_OK ) {
+            return result;
+        }
+        writtenSize += processedSize;
+    }
+    return S_OK;
+}
+} // namespace
+
+TEST_CASE( "CMultiVolumeOutStream: Completing the volumes of the archive", "[cmultivolumeoutstream][writing]" ) {
+    const auto volumesDir = fs::temp_directory_path() / "bit7z_cmultivolumeoutstream";
+    std::error_code error;
+    fs::remove_all( volumesDir, error );
+    REQUIRE( fs::create_directories( volumesDir ) );
+
+    const auto archivePath = volumesDir / "archive.bin";
+    const auto volumePath = [ &archivePath ]( const char* extension ) -> tstring {
+        auto result = archivePath;
+        result += extension;
+        return path_to_tstring( result );
+    };
+
+    std::vector< tstring > completedVolumes;
+    auto outStream = bit7z::make_com< CMultiVolumeOutStream >( 4, archivePath, [ &completedVolumes ]( tstring path ) {
+        completedVolumes.push_back( std::move( path ) );
+    } );
+
+    const buffer_t data = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A };
+    UInt32 processedSize{ 0 };
+
+    SECTION( "Without restrictions from the archive format, the volumes are completed at the end" ) {
+        REQUIRE( write_all( outStream, data ) == S_OK );
+        REQUIRE( completedVolumes.empty() );
+
+        REQUIRE( outStream->finish() == S_OK );
+        REQUIRE( completedVolumes == std::vector< tstring >{ volumePath( ".001" ),
+                                                             volumePath( ".002" ),
+                                                             volumePath( ".003" ) } );
+    }
+
+    SECTION( "Without any restricted region, the volumes are completed as soon as they are written" ) {
+        REQUIRE( outStream->SetRestriction( 0, 0 ) == S_OK );
+        for ( const auto byte : data ) {
+            REQUIRE( outStream->Write( &byte, 1, &processedSize ) == S_OK );
+            REQUIRE( completedVolumes.size() == static_cast< std::size_t >( byte / 4 ) );
+        }
+        REQUIRE( read_file( volumePath( ".001" ) ) == buffer_t{ 0x01, 0x02, 0x03, 0x04 } );
+        REQUIRE( read_file( volumePath( ".002" ) ) == buffer_t{ 0x05, 0x06, 0x07, 0x08 } );
+
+        REQUIRE( outStream->finish() == S_OK );
+        REQUIRE( completedVolumes.size() == 3 );
+        REQUIRE( read_file( volumePath( ".003" ) ) == buffer_t{ 0x09, 0x0A } );
+    }
+
+    SECTION( "Volumes in the restricted region are completed when the restriction is removed" ) {
+        // Like, e.g., the start header of 7z archives, which is rewritten at the end of the compression.
+        REQUIRE( outStream->SetRestriction( 0, 2 ) == S_OK );
+        REQUIRE( write_all( outStream, data ) == S_OK );
+        REQUIRE( completedVolumes == std::vector< tstring >{ volumePath( ".002" ) } );
+
+        // Completed volumes cannot be modified anymore.
+        REQUIRE( outStream->Seek( 5, STREAM_SEEK_SET, nullptr ) == S_OK );
+        REQUIRE( outStream->Write( data.data(), 1, &processedSize ) != S_OK );
+        REQUIRE( outStream->SetSize( 6 ) != S_OK );
+
+        REQUIRE( outStream->Seek( 0, STREAM_SEEK_SET, nullptr ) == S_OK );
+        REQUIRE( write_all( outStream, { 0x0B, 0x0C } ) == S_OK );
+        REQUIRE( outStream->SetRestriction( 0, 0 ) == S_OK );
+        REQUIRE( completedVolumes == std::vector< tstring >{ volumePath( ".002" ), volumePath( ".001" ) } );
+        REQUIRE( read_file( volumePath( ".001" ) ) == buffer_t{ 0x0B, 0x0C, 0x03, 0x04 } );
+
+        REQUIRE( outStream->finish() == S_OK );
+        REQUIRE( completedVolumes.size() == 3 );
+    }
+
+    SECTION( "Invalid restricted regions are rejected" ) {
+        REQUIRE( outStream->SetRestriction( 2, 1 ) == E_FAIL );
+    }
+
+    outStream.Release();
+    fs::remove_all( volumesDir, error );
+}
@@ -0,0 +1,92 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferinstream.hpp>
+#include <internal/creadaheadinstream.hpp>
+#include <internal/util.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+
+using bit7z::buffer_t;
+using bit7z::byte_t;
+using bit7z::CBufferInStream;
+using bit7z::CReadAheadInStream;
+
+namespace {
+auto read_all( IInStream* stream, std::size_t chunkSize ) -> buffer_t {
+    buffer_t result;
+    buffer_t chunk( chunkSize );
+    while ( true ) {
+        UInt32 processedSize = 0;
+        REQUIRE( stream->Read( chunk.data(), static_cast< UInt32 >( chunk.size() ), &processedSize ) == S_OK );
+        if ( processedSize == 0 ) {
+            break;
+        }
+        result.insert( result.end(), chunk.begin(), chunk.begin() + processedSize );
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE( "CReadAheadInStream: Reading a stream sequentially", "[creadaheadinstream][reading]" ) {
+    buffer_t content( 100000 );
+    std::iota( content.begin(), content.end(), static_cast< byte_t >( 0 ) );
+
+    const std::size_t blockSize = GENERATE( 1u, 1000u, 4096u, 1024u * 1024u );
+    const std::size_t blocksCount = GENERATE( 1u, 2u, 4u );
+    const std::size_t chunkSize = GENERATE( 1u, 333u, 8192u );
+
+    DYNAMIC_SECTION( "Block size: " << blockSize << ", blocks: " << blocksCount << ", chunk size: " << chunkSize ) {
+        auto inStream = bit7z::make_com< CBufferInStream, IInStream >( content );
+        auto readAheadStream = bit7z::make_com< CReadAheadInStream, IInStream >( inStream, blockSize, blocksCount );
+        REQUIRE( read_all( readAheadStream, chunkSize ) == content );
+    }
+}
+
+TEST_CASE( "CReadAheadInStream: Seeking while reading ahead", "[creadaheadinstream][reading]" ) {
+    buffer_t content( 50000 );
+    std::iota( content.begin(), content.end(), static_cast< byte_t >( 0 ) );
+
+    auto inStream = bit7z::make_com< CBufferInStream, IInStream >( content );
+    auto readAheadStream = bit7z::make_com< CReadAheadInStream, IInStream >( inStream, 1024, 3 );
+
+    UInt64 newPosition = 0;
+    REQUIRE( readAheadStream->Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+    REQUIRE( newPosition == content.size() );
+
+    // Alternating sequential reads (which start the read-ahead) with jumps backward and forward.
+    const std::array< uint64_t, 6 > positions = { 0, 10000, 2000, 2500, 49990, 1 };
+    for ( const auto position : positions ) {
+        REQUIRE( readAheadStream->Seek( static_cast< Int64 >( position ), STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == position );
+
+        for ( int i = 0; i < 5; ++i ) {
+            buffer_t chunk( 700 );
+            UInt32 processedSize = 0;
+            REQUIRE( readAheadStream->Read( chunk.data(), 700, &processedSize ) == S_OK );
+
+            const auto expectedSize = std::min< uint64_t >( 700, content.size() - newPosition );
+            REQUIRE( processedSize == expectedSize );
+            REQUIRE( std::equal( chunk.begin(), chunk.begin() + processedSize, content.begin() + newPosition ) );
+
+            REQUIRE( readAheadStream->Seek( 0, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+        }
+    }
+}
@@ -0,0 +1,88 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferoutstream.hpp>
+#include <internal/cfixedbufferoutstream.hpp>
+#include <internal/cwritebehindoutstream.hpp>
+#include <internal/util.hpp>
+#include <internal/writebehindqueue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+
+using bit7z::buffer_t;
+using bit7z::byte_t;
+using bit7z::CBufferOutStream;
+using bit7z::CFixedBufferOutStream;
+using bit7z::CWriteBehindOutStream;
+using bit7z::WriteBehindQueue;
+
+TEST_CASE( "CWriteBehindOutStream: Writing through the write-behind queue", "[cwritebehindoutstream][writing]" ) {
+    // Using small buffers, so that the data is split among many buffers, and the pool is exhausted.
+    const std::size_t bufferSize = GENERATE( 1u, 7u, 64u, 4096u );
+    WriteBehindQueue queue{ 2, bufferSize };
+
+    buffer_t content( 10000 );
+    std::iota( content.begin(), content.end(), static_cast< byte_t >( 0 ) );
+
+    std::array< buffer_t, 3 > outputs{};
+    DYNAMIC_SECTION( "Buffer size: " << bufferSize ) {
+        // Interleaving the writes of more streams (i.e., files) using the same queue.
+        for ( auto& output : outputs ) {
+            auto outStream = bit7z::make_com< CBufferOutStream, ISequentialOutStream >( output );
+            auto writeBehindStream = bit7z::make_com< CWriteBehindOutStream >( queue, outStream );
+
+            std::size_t position = 0;
+            const std::size_t chunkSize = 333;
+            while ( position < content.size() ) {
+                const auto size = static_cast< UInt32 >( std::min( chunkSize, content.size() - position ) );
+                UInt32 processedSize = 0;
+                REQUIRE( writeBehindStream->Write( &content[ position ], size, &processedSize ) == S_OK );
+                REQUIRE( processedSize == size );
+                position += size;
+            }
+            REQUIRE( writeBehindStream->close() == S_OK );
+            REQUIRE( output == content );
+
+            // The stream cannot be written after being closed.
+            REQUIRE( writeBehindStream->Write( content.data(), 1, nullptr ) == E_FAIL );
+        }
+    }
+}
+
+TEST_CASE( "CWriteBehindOutStream: Reporting a failed write", "[cwritebehindoutstream][writing]" ) {
+    WriteBehindQueue queue{ 2, 16 };
+
+    std::array< byte_t, 20 > output{};
+    const buffer_t content( 100, static_cast< byte_t >( 0xAB ) );
+    {
+        auto outStream = bit7z::make_com< CFixedBufferOutStream, ISequentialOutStream >( output.data(), output.size() );
+        auto writeBehindStream = bit7z::make_com< CWriteBehindOutStream >( queue, outStream );
+        REQUIRE( writeBehindStream->Write( content.data(), 100, nullptr ) == S_OK );
+        REQUIRE( writeBehindStream->close() != S_OK );
+    }
+
+    // The failure is reported only once, so the queue can be used for writing other streams.
+    buffer_t newOutput;
+    auto outStream = bit7z::make_com< CBufferOutStream, ISequentialOutStream >( newOutput );
+    auto writeBehindStream = bit7z::make_com< CWriteBehindOutStream >( queue, outStream );
+    REQUIRE( writeBehindStream->Write( content.data(), 50, nullptr ) == S_OK );
+    REQUIRE( writeBehindStream->close() == S_OK );
+    REQUIRE( newOutput == buffer_t( 50, static_cast< byte_t >( 0xAB ) ) );
+}
@@ -0,0 +1,110 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _WIN32
+
+#include <catch2/catch.hpp>
+
+#include <internal/directoryfdcache.hpp>
+#include <internal/fs.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+using namespace bit7z;
+
+TEST_CASE( "DirectoryFdCache: Creating and opening the output directories", "[directoryfdcache]" ) {
+    const auto basePath = ( fs::temp_directory_path() / "bit7z_directoryfdcache" ).lexically_normal();
+    std::error_code error;
+    fs::remove_all( basePath, error );
+
+    {
+        DirectoryFdCache cache{ basePath };
+
+        SECTION( "Opening the base directory" ) {
+            REQUIRE( cache.directoryFd( basePath ) >= 0 );
+            REQUIRE( fs::is_directory( basePath ) );
+        }
+
+        SECTION( "Creating nested directories" ) {
+            const auto nestedPath = basePath / "a" / "b" / "c";
+            const int directoryFd = cache.directoryFd( nestedPath );
+            REQUIRE( directoryFd >= 0 );
+            REQUIRE( fs::is_directory( nestedPath ) );
+
+            // The descriptor refers to the requested directory.
+            struct stat directoryStat{};
+            struct stat expectedStat{};
+            REQUIRE( ::fstat( directoryFd, &directoryStat ) == 0 );
+            REQUIRE( ::stat( nestedPath.c_str(), &expectedStat ) == 0 );
+            REQUIRE( directoryStat.st_ino == expectedStat.st_ino );
+
+            // Cached directories are not opened again.
+            REQUIRE( cache.directoryFd( nestedPath ) == directoryFd );
+            REQUIRE( cache.directoryFd( basePath / "a" / "d" ) >= 0 );
+            REQUIRE( fs::is_directory( basePath / "a" / "d" ) );
+        }
+
+        SECTION( "Opening a path outside the base directory" ) {
+            REQUIRE( cache.directoryFd( fs::temp_directory_path() ) == -1 );
+
+            // A sibling directory whose name starts with the name of the base directory.
+            const auto siblingPath = basePath.parent_path() / ( basePath.filename().string() + "_outside" );
+            REQUIRE( cache.directoryFd( siblingPath / "dir" ) == -1 );
+            REQUIRE_FALSE( fs::exists( siblingPath ) );
+        }
+
+        SECTION( "Opening a directory through a symbolic link" ) {
+            REQUIRE( cache.directoryFd( basePath ) >= 0 );
+            fs::create_directory_symlink( fs::temp_directory_path(), basePath / "link", error );
+            REQUIRE( !error );
+            REQUIRE( cache.directoryFd( basePath / "link" / "dir" ) == -1 );
+        }
+    }
+
+    fs::remove_all( basePath, error );
+}
+
+TEST_CASE( "DirectoryFdCache: Closing the least recently used directories", "[directoryfdcache]" ) {
+    const auto basePath = ( fs::temp_directory_path() / "bit7z_directoryfdcache" ).lexically_normal();
+    std::error_code error;
+    fs::remove_all( basePath, error );
+
+    {
+        DirectoryFdCache cache{ basePath, 2 };
+        const int firstFd = cache.directoryFd( basePath / "first" );
+        const int secondFd = cache.directoryFd( basePath / "second" );
+        REQUIRE( firstFd >= 0 );
+        REQUIRE( secondFd >= 0 );
+        REQUIRE( cache.size() == 2 );
+
+        // Using the first directory again, so that the second one becomes the least recently used.
+        REQUIRE( cache.directoryFd( basePath / "first" ) == firstFd );
+
+        // Only the second directory is closed.
+        REQUIRE( cache.directoryFd( basePath / "third" ) >= 0 );
+        REQUIRE( cache.size() == 2 );
+        REQUIRE( ::fcntl( secondFd, F_GETFD ) == -1 ); // NOLINT(*-vararg)
+        REQUIRE( ::fcntl( firstFd, F_GETFD ) != -1 ); // NOLINT(*-vararg)
+        REQUIRE( cache.directoryFd( basePath / "first" ) == firstFd );
+
+        // Nested directories are created even if their parents don't fit in the cache.
+        const auto nestedPath = basePath / "a" / "b" / "c" / "d";
+        REQUIRE( cache.directoryFd( nestedPath ) >= 0 );
+        REQUIRE( fs::is_directory( nestedPath ) );
+        REQUIRE( cache.size() == 2 );
+    }
+
+    fs::remove_all( basePath, error );
+}
+
+#endif
@@ -225,9 +225,51 @@ TEST_CASE( "formatdetect: Format detection by signature", "[formatdetect]" ) {
         REQUIRE_LOAD_FILE( fileBuffer, "valid." + test.extension );
         const BitArchiveReader reader{ lib, fileBuffer };
         REQUIRE( reader.detectedFormat() == test.format );
+
+        // Detecting the format without opening the archive.
+        REQUIRE( detectFormat( fileBuffer ) == test.format );
     }
 }
 
+TEST_CASE( "formatdetect: Format detection of in-memory signatures", "[formatdetect]" ) {
+    REQUIRE( detectFormat( nullptr, 0 ) == BitFormat::Auto );
+    REQUIRE( detectFormat( buffer_t{} ) == BitFormat::Auto );
+
+    const auto make_buffer = []( std::size_t size, std::size_t offset, std::initializer_list< unsigned char > bytes ) {
+        buffer_t buffer( size );
+        for ( const auto byte : bytes ) {
+            buffer[ offset++ ] = static_cast< byte_t >( byte );
+        }
+        return buffer;
+    };
+
+    // Signatures at the beginning of the file (the longest matching signature wins).
+    REQUIRE( detectFormat( make_buffer( 8, 0, { 0x37, 0x7A, 0xBC, 0xAF, 0x27, 0x1C } ) ) == BitFormat::SevenZip );
+    REQUIRE( detectFormat( make_buffer( 8, 0, { 'R', 'a', 'r', '!', 0x1A, 0x07, 0x00, 0xCF } ) ) == BitFormat::Rar );
+    REQUIRE( detectFormat( make_buffer( 8, 0, { 'R', 'a', 'r', '!', 0x1A, 0x07, 0x01, 0x00 } ) ) == BitFormat::Rar5 );
+    REQUIRE( detectFormat( make_buffer( 2, 0, { 'P', 'K' } ) ) == BitFormat::Zip );
+
+    // Signatures at an offset from the beginning of the file.
+    REQUIRE( detectFormat( make_buffer( 0x200, 0x101, { 'u', 's', 't', 'a', 'r' } ) ) == BitFormat::Tar );
+    auto gptBuffer = make_buffer( 0x400, 0x200, { 'E', 'F', 'I', ' ', 'P', 'A', 'R', 'T' } );
+    gptBuffer[ 0x1FE ] = static_cast< byte_t >( 0x55 );
+    gptBuffer[ 0x1FF ] = static_cast< byte_t >( 0xAA );
+    REQUIRE( detectFormat( gptBuffer ) == BitFormat::GPT );
+
+    // ISO and UDF signatures are detected only if the data contains them.
+    auto isoBuffer = make_buffer( kFormatProbeSize, 0x8001, { 'C', 'D', '0', '0', '1' } );
+    REQUIRE( detectFormat( isoBuffer ) == BitFormat::Iso );
+    REQUIRE( detectFormat( isoBuffer.data(), 0x8000 ) == BitFormat::Auto );
+    isoBuffer[ 0x8001 + ( 2 * 0x800 ) ] = static_cast< byte_t >( 'N' );
+    isoBuffer[ 0x8002 + ( 2 * 0x800 ) ] = static_cast< byte_t >( 'S' );
+    isoBuffer[ 0x8003 + ( 2 * 0x800 ) ] = static_cast< byte_t >( 'R' );
+    isoBuffer[ 0x8004 + ( 2 * 0x800 ) ] = static_cast< byte_t >( '0' );
+    REQUIRE( detectFormat( isoBuffer ) == BitFormat::Udf );
+
+    REQUIRE( detectFormat( make_buffer( 16, 0, { 'n', 'o', 't', ' ', 'a', 'n', ' ', 'a', 'r', 'c', 'h', 'i', 'v', 'e' } ) )
+             == BitFormat::Auto );
+}
+
 #ifdef _WIN32
 
 // For some reason, 7-zip fails to open UDF files on Linux, so we test them only on Windows.
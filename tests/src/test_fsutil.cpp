@@ -1424,4 +1424,51 @@ TEST_CASE( "fsutil: Check if extracted path is outside base path", "[fsutil][Saf
         REQUIRE_THROWS( SafeOutPathBuilder{ BIT7Z_STRING( "out/dir/turkish/IŞIK" ) }.buildPath( L"../ışık" ) );
     }
 #endif
-}
\ No newline at end of file
+}
+
+TEST_CASE( "fsutil: Finding the volumes of a split archive", "[fsutil][find_volumes]" ) {
+    const auto volumesDir = fs::temp_directory_path() / "bit7z_find_volumes";
+    std::error_code error;
+    fs::remove_all( volumesDir, error );
+    REQUIRE( fs::create_directories( volumesDir ) );
+
+    const auto createFile = [ &volumesDir ]( const char* fileName ) {
+        fs::ofstream{ volumesDir / fileName };
+    };
+    for ( const auto* fileName : { "archive.7z.001", "archive.7z.002", "archive.7z.003", "archive.7z.004",
+                                   "archive.7z.005", "archive.7z.007", "archive.7z.0003", "archive.7z.abc",
+                                   "other.7z.002", "archive.zip.002" } ) {
+        createFile( fileName );
+    }
+
+    SECTION( "Only the consecutive volumes of the archive are found, sorted by volume number" ) {
+        const auto volumes = find_volumes( volumesDir / "archive.7z.001" );
+        REQUIRE( volumes == vector< fs::path >{ volumesDir / "archive.7z.001",
+                                                volumesDir / "archive.7z.002",
+                                                volumesDir / "archive.7z.003",
+                                                volumesDir / "archive.7z.004",
+                                                volumesDir / "archive.7z.005" } );
+    }
+
+    SECTION( "No volumes are found if the first volume does not exist" ) {
+        REQUIRE( find_volumes( volumesDir / "other.7z.001" ).empty() );
+        REQUIRE( find_volumes( volumesDir / "missing.7z.001" ).empty() );
+    }
+
+    SECTION( "No volumes are found if the directory does not exist" ) {
+        REQUIRE( find_volumes( volumesDir / "missing" / "archive.7z.001" ).empty() );
+    }
+
+    SECTION( "The names of the volumes are compared like the filesystem does" ) {
+        createFile( "mixed.7z.001" );
+        createFile( "MIXED.7Z.002" );
+        const auto volumes = find_volumes( volumesDir / "mixed.7z.001" );
+#ifdef _WIN32
+        REQUIRE( volumes == vector< fs::path >{ volumesDir / "mixed.7z.001", volumesDir / "MIXED.7Z.002" } );
+#else
+        REQUIRE( volumes == vector< fs::path >{ volumesDir / "mixed.7z.001" } );
+#endif
+    }
+
+    fs::remove_all( volumesDir, error );
+}
@@ -0,0 +1,72 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/itempathindex.hpp>
+
+#include <vector>
+
+using bit7z::ItemPathIndex;
+using bit7z::tstring;
+
+TEST_CASE( "ItemPathIndex: Finding items by path", "[itempathindex]" ) {
+    const std::vector< tstring > paths = {
+        BIT7Z_STRING( "folder" ),
+        BIT7Z_STRING( "folder/clouds.jpg" ),
+        BIT7Z_STRING( "folder/subfolder/Lorem Ipsum.pdf" ),
+        BIT7Z_STRING( "italy.svg" ),
+        BIT7Z_STRING( "folder/clouds.jpg" ) // duplicate path
+    };
+
+    ItemPathIndex pathIndex{ static_cast< uint32_t >( paths.size() ) };
+    for ( uint32_t index = 0; index < paths.size(); ++index ) {
+        pathIndex.insert( paths[ index ], index );
+    }
+
+    const auto findPath = [ &pathIndex, &paths ]( const tstring& path ) -> uint32_t {
+        return pathIndex.find( path, [ &paths, &path ]( uint32_t candidate ) {
+            return ItemPathIndex::equals( paths[ candidate ], path );
+        } );
+    };
+
+    REQUIRE( findPath( BIT7Z_STRING( "folder" ) ) == 0 );
+    REQUIRE( findPath( BIT7Z_STRING( "folder/" ) ) == 0 );
+    REQUIRE( findPath( BIT7Z_STRING( "folder/subfolder/Lorem Ipsum.pdf" ) ) == 2 );
+    REQUIRE( findPath( BIT7Z_STRING( "italy.svg" ) ) == 3 );
+
+    // The first inserted item is returned.
+    REQUIRE( findPath( BIT7Z_STRING( "folder/clouds.jpg" ) ) == 1 );
+
+    REQUIRE( findPath( BIT7Z_STRING( "" ) ) == ItemPathIndex::kNotFound );
+    REQUIRE( findPath( BIT7Z_STRING( "clouds.jpg" ) ) == ItemPathIndex::kNotFound );
+    REQUIRE( findPath( BIT7Z_STRING( "folder/subfolder" ) ) == ItemPathIndex::kNotFound );
+    REQUIRE( findPath( BIT7Z_STRING( "Italy.svg" ) ) == ItemPathIndex::kNotFound );
+}
+
+TEST_CASE( "ItemPathIndex: Finding items in an empty index", "[itempathindex]" ) {
+    const ItemPathIndex pathIndex{ 0 };
+    REQUIRE( pathIndex.find( BIT7Z_STRING( "italy.svg" ), []( uint32_t ) { return true; } ) ==
+             ItemPathIndex::kNotFound );
+}
+
+TEST_CASE( "ItemPathIndex: Comparing normalized paths", "[itempathindex]" ) {
+    REQUIRE( ItemPathIndex::equals( BIT7Z_STRING( "folder" ), BIT7Z_STRING( "folder" ) ) );
+    REQUIRE( ItemPathIndex::equals( BIT7Z_STRING( "folder" ), BIT7Z_STRING( "folder/" ) ) );
+    REQUIRE( ItemPathIndex::equals( BIT7Z_STRING( "folder//" ), BIT7Z_STRING( "folder/" ) ) );
+    REQUIRE( ItemPathIndex::equals( BIT7Z_STRING( "/" ), BIT7Z_STRING( "/" ) ) );
+    REQUIRE_FALSE( ItemPathIndex::equals( BIT7Z_STRING( "folder" ), BIT7Z_STRING( "Folder" ) ) );
+    REQUIRE_FALSE( ItemPathIndex::equals( BIT7Z_STRING( "folder" ), BIT7Z_STRING( "folder/a" ) ) );
+#ifdef _WIN32
+    REQUIRE( ItemPathIndex::equals( BIT7Z_STRING( "folder\\clouds.jpg" ), BIT7Z_STRING( "folder/clouds.jpg" ) ) );
+#endif
+}
@@ -0,0 +1,142 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/itempipe.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using bit7z::byte_t;
+using bit7z::ItemPipe;
+
+namespace {
+auto make_item_data( uint32_t index, std::size_t size ) -> std::vector< byte_t > {
+    std::vector< byte_t > data( size );
+    for ( std::size_t i = 0; i < size; ++i ) {
+        data[ i ] = static_cast< byte_t >( ( i * 31 ) + index );
+    }
+    return data;
+}
+
+void produce_items( ItemPipe& pipe, const std::vector< std::size_t >& itemSizes, std::size_t chunkSize ) {
+    for ( uint32_t index = 0; index < itemSizes.size(); ++index ) {
+        if ( !pipe.beginItem( index ) ) {
+            return;
+        }
+        const auto data = make_item_data( index, itemSizes[ index ] );
+        for ( std::size_t offset = 0; offset < data.size(); offset += chunkSize ) {
+            if ( !pipe.write( data.data() + offset, std::min( chunkSize, data.size() - offset ) ) ) {
+                return;
+            }
+        }
+        pipe.endItem();
+    }
+    pipe.finish( nullptr );
+}
+
+auto read_item( ItemPipe& pipe, std::size_t readSize ) -> std::vector< byte_t > {
+    std::vector< byte_t > result;
+    std::vector< byte_t > chunk( readSize );
+    std::size_t chunkRead = 0;
+    while ( ( chunkRead = pipe.read( chunk.data(), chunk.size() ) ) > 0 ) {
+        result.insert( result.end(), chunk.cbegin(), chunk.cbegin() + static_cast< std::ptrdiff_t >( chunkRead ) );
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE( "ItemPipe: Reading all the items", "[itempipe]" ) {
+    const std::vector< std::size_t > itemSizes{ 0, 1, 10, 4096, 100000 };
+    const std::size_t capacity = GENERATE( 1, 7, 1024 );
+    const std::size_t chunkSize = GENERATE( 3, 5000 );
+
+    DYNAMIC_SECTION( "Pipe capacity: " << capacity << ", write chunk size: " << chunkSize ) {
+        ItemPipe pipe{ capacity };
+        std::thread producer{ produce_items, std::ref( pipe ), std::cref( itemSizes ), chunkSize };
+
+        uint32_t index = 0;
+        for ( uint32_t expectedIndex = 0; expectedIndex < itemSizes.size(); ++expectedIndex ) {
+            REQUIRE( pipe.nextItem( index ) );
+            REQUIRE( index == expectedIndex );
+            pipe.startItem();
+            REQUIRE( read_item( pipe, 333 ) == make_item_data( index, itemSizes[ index ] ) );
+        }
+        REQUIRE_FALSE( pipe.nextItem( index ) );
+        producer.join();
+    }
+}
+
+TEST_CASE( "ItemPipe: Skipping the content of items", "[itempipe]" ) {
+    const std::vector< std::size_t > itemSizes{ 100000, 50, 100000, 20 };
+
+    ItemPipe pipe{ 64 };
+    std::thread producer{ produce_items, std::ref( pipe ), std::cref( itemSizes ), 1000 };
+
+    uint32_t index = 0;
+    REQUIRE( pipe.nextItem( index ) );
+    pipe.startItem();
+    std::vector< byte_t > chunk( 10 );
+    REQUIRE( pipe.read( chunk.data(), chunk.size() ) > 0 ); // Reading only part of the item.
+
+    REQUIRE( pipe.nextItem( index ) );
+    REQUIRE( index == 1 );
+    pipe.startItem();
+    REQUIRE( read_item( pipe, 7 ) == make_item_data( 1, itemSizes[ 1 ] ) );
+
+    REQUIRE( pipe.nextItem( index ) ); // Not reading the item at all.
+    pipe.startItem();
+
+    REQUIRE( pipe.nextItem( index ) );
+    REQUIRE( index == 3 );
+    pipe.startItem();
+    REQUIRE( read_item( pipe, 1024 ) == make_item_data( 3, itemSizes[ 3 ] ) );
+
+    REQUIRE_FALSE( pipe.nextItem( index ) );
+    producer.join();
+}
+
+TEST_CASE( "ItemPipe: Closing the pipe stops the producer", "[itempipe]" ) {
+    const std::vector< std::size_t > itemSizes{ 100000, 100000 };
+
+    ItemPipe pipe{ 16 };
+    std::thread producer{ produce_items, std::ref( pipe ), std::cref( itemSizes ), 1000 };
+
+    uint32_t index = 0;
+    REQUIRE( pipe.nextItem( index ) );
+    pipe.startItem();
+    pipe.close();
+    producer.join(); // The producer must not be blocked on the full buffer.
+}
+
+TEST_CASE( "ItemPipe: The producer error is reported to the reader", "[itempipe]" ) {
+    ItemPipe pipe{ 16 };
+    std::thread producer{ [&pipe]() {
+        if ( pipe.beginItem( 0 ) ) {
+            const byte_t data[] = { 1, 2, 3 }; // NOLINT(*-avoid-c-arrays)
+            pipe.write( data, sizeof( data ) );
+        }
+        pipe.finish( std::make_exception_ptr( std::runtime_error( "failure" ) ) );
+    } };
+
+    uint32_t index = 0;
+    REQUIRE( pipe.nextItem( index ) );
+    pipe.startItem();
+    std::vector< byte_t > chunk( 3 );
+    REQUIRE( pipe.read( chunk.data(), chunk.size() ) == 3 );
+    REQUIRE_THROWS_AS( pipe.read( chunk.data(), chunk.size() ), std::runtime_error );
+    producer.join();
+    REQUIRE_FALSE( pipe.nextItem( index ) );
+}